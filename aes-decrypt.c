@@ -36,8 +36,10 @@
 #endif
 
 #include <assert.h>
+#include <string.h>
 
 #include "aes-internal.h"
+#include "memxor.h"
 
 static const struct aes_table
 _aes_decrypt_table =
@@ -383,3 +385,40 @@ aes256_decrypt(const struct aes256_ctx *ctx,
   _aes_decrypt(_AES256_ROUNDS, ctx->keys, &_aes_decrypt_table,
 	       length, dst, src);
 }
+
+#if HAVE_NATIVE_aes_cbc_decrypt
+#define CBC_BUFFER_BLOCKS 32
+
+/* For fat builds, used when only the plain _aes_decrypt is
+   available. Like cbc_decrypt, this depends on memxor3 working from
+   the end of the area when dst == src. */
+void
+_nettle_aes_cbc_decrypt_c(unsigned rounds, const uint32_t *keys,
+			  uint8_t *iv, size_t length,
+			  uint8_t *dst, const uint8_t *src)
+{
+  uint8_t buffer[CBC_BUFFER_BLOCKS * AES_BLOCK_SIZE];
+  uint8_t next_iv[AES_BLOCK_SIZE];
+
+  assert(!(length % AES_BLOCK_SIZE) );
+
+  while (length > 0)
+    {
+      size_t chunk = length;
+      if (chunk > sizeof(buffer))
+	chunk = sizeof(buffer);
+
+      _aes_decrypt(rounds, keys, &_aes_decrypt_table,
+		   chunk, buffer, src);
+      memcpy(next_iv, src + chunk - AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+      memxor3(dst + AES_BLOCK_SIZE, buffer + AES_BLOCK_SIZE, src,
+	      chunk - AES_BLOCK_SIZE);
+      memxor3(dst, buffer, iv, AES_BLOCK_SIZE);
+      memcpy(iv, next_iv, AES_BLOCK_SIZE);
+
+      length -= chunk;
+      dst += chunk;
+      src += chunk;
+    }
+}
+#endif
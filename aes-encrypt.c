@@ -36,8 +36,11 @@
 #endif
 
 #include <assert.h>
+#include <string.h>
 
 #include "aes-internal.h"
+#include "ctr-internal.h"
+#include "memxor.h"
 
 /* The main point on this function is to help the assembler
    implementations of _nettle_aes_encrypt to get the table pointer.
@@ -81,3 +84,70 @@ aes256_encrypt(const struct aes256_ctx *ctx,
   _aes_encrypt(_AES256_ROUNDS, ctx->keys, &_aes_encrypt_table,
 	       length, dst, src);
 }
+
+#if HAVE_NATIVE_aes_ctr_crypt
+#define CTR_BUFFER_BLOCKS 32
+
+/* For fat builds, used when only the plain _aes_encrypt is
+   available. */
+void
+_nettle_aes_ctr_crypt_c(unsigned rounds, const uint32_t *keys,
+			uint8_t *ctr, size_t length,
+			uint8_t *dst, const uint8_t *src)
+{
+  uint8_t buffer[CTR_BUFFER_BLOCKS * AES_BLOCK_SIZE];
+
+  assert(!(length % AES_BLOCK_SIZE) );
+
+  while (length > 0)
+    {
+      size_t chunk = length;
+      if (chunk > sizeof(buffer))
+	chunk = sizeof(buffer);
+
+      _ctr_fill16(ctr, chunk / AES_BLOCK_SIZE, buffer);
+      _aes_encrypt(rounds, keys, &_aes_encrypt_table,
+		   chunk, buffer, buffer);
+      memxor3(dst, src, buffer, chunk);
+
+      length -= chunk;
+      dst += chunk;
+      src += chunk;
+    }
+}
+#endif
+
+#if HAVE_NATIVE_aes_cbc_encrypt_4
+/* For fat builds. The input of all streams is read before any output
+   is written, and the chaining values are kept in a local copy, so
+   that duplicated lanes give the same result as the native code. */
+void
+_nettle_aes_cbc_encrypt_4_c(unsigned rounds, const uint32_t **keys,
+			    uint8_t **iv, size_t length,
+			    uint8_t **dst, const uint8_t **src)
+{
+  uint8_t state[4][AES_BLOCK_SIZE];
+  size_t pos;
+  unsigned i;
+
+  assert(!(length % AES_BLOCK_SIZE) );
+
+  for (i = 0; i < 4; i++)
+    memcpy (state[i], iv[i], AES_BLOCK_SIZE);
+
+  for (pos = 0; pos < length; pos += AES_BLOCK_SIZE)
+    {
+      for (i = 0; i < 4; i++)
+	memxor (state[i], src[i] + pos, AES_BLOCK_SIZE);
+      for (i = 0; i < 4; i++)
+	{
+	  _aes_encrypt(rounds, keys[i], &_aes_encrypt_table,
+		       AES_BLOCK_SIZE, state[i], state[i]);
+	  memcpy (dst[i] + pos, state[i], AES_BLOCK_SIZE);
+	}
+    }
+
+  for (i = 0; i < 4; i++)
+    memcpy (iv[i], state[i], AES_BLOCK_SIZE);
+}
+#endif
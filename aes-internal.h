@@ -42,6 +42,9 @@
 #define _aes_encrypt _nettle_aes_encrypt
 #define _aes_decrypt _nettle_aes_decrypt
 #define _aes_encrypt_table _nettle_aes_encrypt_table
+#define _aes_ctr_crypt _nettle_aes_ctr_crypt
+#define _aes_cbc_decrypt _nettle_aes_cbc_decrypt
+#define _aes_cbc_encrypt_4 _nettle_aes_cbc_encrypt_4
 
 /* Define to use only small tables. */
 #ifndef AES_SMALL
@@ -79,6 +82,52 @@ _aes_decrypt(unsigned rounds, const uint32_t *keys,
 	     size_t length, uint8_t *dst,
 	     const uint8_t *src);
 
+/* Counter mode, with a 128-bit big-endian counter, available only
+   in some configurations. The length must be a multiple of the block
+   size. */
+#if HAVE_NATIVE_aes_ctr_crypt
+void
+_aes_ctr_crypt(unsigned rounds, const uint32_t *keys,
+	       uint8_t *ctr, size_t length,
+	       uint8_t *dst, const uint8_t *src);
+/* For fat builds */
+void
+_nettle_aes_ctr_crypt_c(unsigned rounds, const uint32_t *keys,
+			uint8_t *ctr, size_t length,
+			uint8_t *dst, const uint8_t *src);
+#endif
+
+/* CBC decryption, updating the iv. The length must be a multiple of
+   the block size, and dst == src is allowed. Available only in some
+   configurations. */
+#if HAVE_NATIVE_aes_cbc_decrypt
+void
+_aes_cbc_decrypt(unsigned rounds, const uint32_t *keys,
+		 uint8_t *iv, size_t length,
+		 uint8_t *dst, const uint8_t *src);
+/* For fat builds */
+void
+_nettle_aes_cbc_decrypt_c(unsigned rounds, const uint32_t *keys,
+			  uint8_t *iv, size_t length,
+			  uint8_t *dst, const uint8_t *src);
+#endif
+
+/* CBC encryption of four independent streams of the same length,
+   each with its own subkeys and iv. All ivs are updated, also for
+   lanes which duplicate another stream. Available only in some
+   configurations. */
+#if HAVE_NATIVE_aes_cbc_encrypt_4
+void
+_aes_cbc_encrypt_4(unsigned rounds, const uint32_t **keys,
+		   uint8_t **iv, size_t length,
+		   uint8_t **dst, const uint8_t **src);
+/* For fat builds */
+void
+_nettle_aes_cbc_encrypt_4_c(unsigned rounds, const uint32_t **keys,
+			    uint8_t **iv, size_t length,
+			    uint8_t **dst, const uint8_t **src);
+#endif
+
 /* Macros */
 /* Get the byte with index 0, 1, 2 and 3 */
 #define B0(x) ((x) & 0xff)
@@ -93,5 +93,18 @@ STRUCTURE(P1305)
   STRUCT(H2, 4)
   STRUCT(H0, 8)
   STRUCT(H1, 8)
+  STRUCT(POWERS, 144)
+  STRUCT(HAVE_POWERS, 4)
+
+dnl Offsets in GCM_CTX(type), e.g., struct gcm_aes128_ctx, for
+dnl GCM_TABLE_BITS = 8. The cipher context follows the struct gcm_ctx.
+STRUCTURE(GCM)
+  STRUCT(KEY, 4096)
+  STRUCT(IV, 16)
+  STRUCT(CTR, 16)
+  STRUCT(X, 16)
+  STRUCT(AUTH_SIZE, 8)
+  STRUCT(DATA_SIZE, 8)
+  STRUCT(CIPHER, 0)
 
 divert
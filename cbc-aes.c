@@ -0,0 +1,146 @@
+/* cbc-aes.c
+
+   Cipher block chaining mode, for several aes streams in parallel.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include "cbc.h"
+
+#include "aes-internal.h"
+
+#if HAVE_NATIVE_aes_cbc_encrypt_4
+# define CBC_AES_LANES 4
+# define CBC_AES_MIN_LANES 2
+
+/* Encrypts the first n <= CBC_AES_LANES streams. Unused lanes
+   duplicate the first stream. */
+static void
+cbc_aes_encrypt_lanes(unsigned n, unsigned rounds, const uint32_t **keys,
+		      uint8_t **iv, size_t length,
+		      uint8_t **dst, const uint8_t **src)
+{
+  const uint32_t *k[CBC_AES_LANES];
+  uint8_t *v[CBC_AES_LANES];
+  uint8_t *d[CBC_AES_LANES];
+  const uint8_t *s[CBC_AES_LANES];
+  unsigned i;
+
+  for (i = 0; i < CBC_AES_LANES; i++)
+    {
+      unsigned j = i < n ? i : 0;
+      k[i] = keys[j];
+      v[i] = iv[j];
+      d[i] = dst[j];
+      s[i] = src[j];
+    }
+  _aes_cbc_encrypt_4 (rounds, k, v, length, d, s);
+}
+#endif /* HAVE_NATIVE_aes_cbc_encrypt_4 */
+
+void
+cbc_aes128_encrypt_n(unsigned n, const struct aes128_ctx **ctx,
+		     uint8_t **iv, size_t length,
+		     uint8_t **dst, const uint8_t **src)
+{
+  assert(!(length % AES_BLOCK_SIZE));
+
+#if HAVE_NATIVE_aes_cbc_encrypt_4
+  while (n >= CBC_AES_MIN_LANES)
+    {
+      const uint32_t *keys[CBC_AES_LANES];
+      unsigned m = n < CBC_AES_LANES ? n : CBC_AES_LANES;
+      unsigned i;
+
+      for (i = 0; i < m; i++)
+	keys[i] = ctx[i]->keys;
+      cbc_aes_encrypt_lanes (m, _AES128_ROUNDS, keys, iv, length, dst, src);
+      n -= m; ctx += m; iv += m; dst += m; src += m;
+    }
+#endif
+  for (; n > 0; n--, ctx++, iv++, dst++, src++)
+    cbc_encrypt (*ctx, (nettle_cipher_func *) aes128_encrypt,
+		 AES_BLOCK_SIZE, *iv, length, *dst, *src);
+}
+
+void
+cbc_aes192_encrypt_n(unsigned n, const struct aes192_ctx **ctx,
+		     uint8_t **iv, size_t length,
+		     uint8_t **dst, const uint8_t **src)
+{
+  assert(!(length % AES_BLOCK_SIZE));
+
+#if HAVE_NATIVE_aes_cbc_encrypt_4
+  while (n >= CBC_AES_MIN_LANES)
+    {
+      const uint32_t *keys[CBC_AES_LANES];
+      unsigned m = n < CBC_AES_LANES ? n : CBC_AES_LANES;
+      unsigned i;
+
+      for (i = 0; i < m; i++)
+	keys[i] = ctx[i]->keys;
+      cbc_aes_encrypt_lanes (m, _AES192_ROUNDS, keys, iv, length, dst, src);
+      n -= m; ctx += m; iv += m; dst += m; src += m;
+    }
+#endif
+  for (; n > 0; n--, ctx++, iv++, dst++, src++)
+    cbc_encrypt (*ctx, (nettle_cipher_func *) aes192_encrypt,
+		 AES_BLOCK_SIZE, *iv, length, *dst, *src);
+}
+
+void
+cbc_aes256_encrypt_n(unsigned n, const struct aes256_ctx **ctx,
+		     uint8_t **iv, size_t length,
+		     uint8_t **dst, const uint8_t **src)
+{
+  assert(!(length % AES_BLOCK_SIZE));
+
+#if HAVE_NATIVE_aes_cbc_encrypt_4
+  while (n >= CBC_AES_MIN_LANES)
+    {
+      const uint32_t *keys[CBC_AES_LANES];
+      unsigned m = n < CBC_AES_LANES ? n : CBC_AES_LANES;
+      unsigned i;
+
+      for (i = 0; i < m; i++)
+	keys[i] = ctx[i]->keys;
+      cbc_aes_encrypt_lanes (m, _AES256_ROUNDS, keys, iv, length, dst, src);
+      n -= m; ctx += m; iv += m; dst += m; src += m;
+    }
+#endif
+  for (; n > 0; n--, ctx++, iv++, dst++, src++)
+    cbc_encrypt (*ctx, (nettle_cipher_func *) aes256_encrypt,
+		 AES_BLOCK_SIZE, *iv, length, *dst, *src);
+}
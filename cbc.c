@@ -41,6 +41,7 @@
 
 #include "cbc.h"
 
+#include "aes-internal.h"
 #include "memxor.h"
 #include "nettle-internal.h"
 
@@ -63,6 +64,63 @@ cbc_encrypt(const void *ctx, nettle_cipher_func *f,
 /* Don't allocate any more space than this on the stack */
 #define CBC_BUFFER_LIMIT 512
 
+typedef void
+cbc_decrypt16_func(const void *ctx, uint8_t *iv,
+		   size_t length, uint8_t *dst, const uint8_t *src);
+
+#if HAVE_NATIVE_aes_cbc_decrypt
+static void
+aes_cbc_decrypt16(const void *ctx, uint8_t *iv,
+		  size_t length, uint8_t *dst, const uint8_t *src)
+{
+  const struct aes_ctx *aes = (const struct aes_ctx *) ctx;
+  _aes_cbc_decrypt(aes->rounds, aes->keys, iv, length, dst, src);
+}
+
+static void
+aes128_cbc_decrypt16(const void *ctx, uint8_t *iv,
+		     size_t length, uint8_t *dst, const uint8_t *src)
+{
+  _aes_cbc_decrypt(_AES128_ROUNDS, ((const struct aes128_ctx *) ctx)->keys,
+		   iv, length, dst, src);
+}
+
+static void
+aes192_cbc_decrypt16(const void *ctx, uint8_t *iv,
+		     size_t length, uint8_t *dst, const uint8_t *src)
+{
+  _aes_cbc_decrypt(_AES192_ROUNDS, ((const struct aes192_ctx *) ctx)->keys,
+		   iv, length, dst, src);
+}
+
+static void
+aes256_cbc_decrypt16(const void *ctx, uint8_t *iv,
+		     size_t length, uint8_t *dst, const uint8_t *src)
+{
+  _aes_cbc_decrypt(_AES256_ROUNDS, ((const struct aes256_ctx *) ctx)->keys,
+		   iv, length, dst, src);
+}
+
+/* Looks up a combined cbc decryption function for the cipher, if
+   there is one. */
+static cbc_decrypt16_func *
+cbc_decrypt16_lookup (nettle_cipher_func *f)
+{
+  if (f == (nettle_cipher_func *) aes128_decrypt)
+    return aes128_cbc_decrypt16;
+  else if (f == (nettle_cipher_func *) aes256_decrypt)
+    return aes256_cbc_decrypt16;
+  else if (f == (nettle_cipher_func *) aes192_decrypt)
+    return aes192_cbc_decrypt16;
+  else if (f == (nettle_cipher_func *) aes_decrypt)
+    return aes_cbc_decrypt16;
+  else
+    return NULL;
+}
+#else /* !HAVE_NATIVE_aes_cbc_decrypt */
+#define cbc_decrypt16_lookup(f) ((cbc_decrypt16_func *) NULL)
+#endif /* !HAVE_NATIVE_aes_cbc_decrypt */
+
 void
 cbc_decrypt(const void *ctx, nettle_cipher_func *f,
 	    size_t block_size, uint8_t *iv,
@@ -74,6 +132,16 @@ cbc_decrypt(const void *ctx, nettle_cipher_func *f,
   if (!length)
     return;
 
+  if (block_size == 16)
+    {
+      cbc_decrypt16_func *decrypt = cbc_decrypt16_lookup (f);
+      if (decrypt)
+	{
+	  decrypt (ctx, iv, length, dst, src);
+	  return;
+	}
+    }
+
   if (src != dst)
     {
       /* Decrypt in ECB mode */
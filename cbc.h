@@ -35,6 +35,7 @@
 #define NETTLE_CBC_H_INCLUDED
 
 #include "nettle-types.h"
+#include "aes.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,6 +44,9 @@ extern "C" {
 /* Name mangling */
 #define cbc_encrypt nettle_cbc_encrypt
 #define cbc_decrypt nettle_cbc_decrypt
+#define cbc_aes128_encrypt_n nettle_cbc_aes128_encrypt_n
+#define cbc_aes192_encrypt_n nettle_cbc_aes192_encrypt_n
+#define cbc_aes256_encrypt_n nettle_cbc_aes256_encrypt_n
 
 void
 cbc_encrypt(const void *ctx, nettle_cipher_func *f,
@@ -56,6 +60,24 @@ cbc_decrypt(const void *ctx, nettle_cipher_func *f,
 	    size_t length, uint8_t *dst,
 	    const uint8_t *src);
 
+/* Encrypts n independent streams of the same length, each with its
+   own key and iv. Where supported, the streams are processed in
+   parallel. */
+void
+cbc_aes128_encrypt_n(unsigned n, const struct aes128_ctx **ctx,
+		     uint8_t **iv, size_t length,
+		     uint8_t **dst, const uint8_t **src);
+
+void
+cbc_aes192_encrypt_n(unsigned n, const struct aes192_ctx **ctx,
+		     uint8_t **iv, size_t length,
+		     uint8_t **dst, const uint8_t **src);
+
+void
+cbc_aes256_encrypt_n(unsigned n, const struct aes256_ctx **ctx,
+		     uint8_t **iv, size_t length,
+		     uint8_t **dst, const uint8_t **src);
+
 #define CBC_CTX(type, size) \
 { type ctx; uint8_t iv[size]; }
 
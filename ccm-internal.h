@@ -0,0 +1,77 @@
+/* ccm-internal.h
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_CCM_INTERNAL_H_INCLUDED
+#define NETTLE_CCM_INTERNAL_H_INCLUDED
+
+#include "ccm.h"
+
+/* Name mangling */
+#define _ccm_aes_encrypt _nettle_ccm_aes_encrypt
+#define _ccm_aes_decrypt _nettle_ccm_aes_decrypt
+
+/* Combined AES and CCM processing, available only in some
+   configurations. Updates both the CBC-MAC and the counter, and
+   requires that no partial block is pending in the CBC-MAC. Only a
+   prefix of the data may be processed, and the return value is the
+   number of bytes done, always a multiple of the block size. The
+   caller must process the rest of the data the usual way. */
+#if HAVE_NATIVE_ccm_aes_encrypt
+size_t
+_ccm_aes_encrypt (struct ccm_ctx *ctx, unsigned rounds,
+		  const uint32_t *keys, size_t length,
+		  uint8_t *dst, const uint8_t *src);
+/* For fat builds */
+size_t
+_nettle_ccm_aes_encrypt_c (struct ccm_ctx *ctx, unsigned rounds,
+			   const uint32_t *keys, size_t length,
+			   uint8_t *dst, const uint8_t *src);
+#else
+#undef _ccm_aes_encrypt
+#define _ccm_aes_encrypt(ctx, rounds, keys, length, dst, src) ((size_t) 0)
+#endif
+
+#if HAVE_NATIVE_ccm_aes_decrypt
+size_t
+_ccm_aes_decrypt (struct ccm_ctx *ctx, unsigned rounds,
+		  const uint32_t *keys, size_t length,
+		  uint8_t *dst, const uint8_t *src);
+/* For fat builds */
+size_t
+_nettle_ccm_aes_decrypt_c (struct ccm_ctx *ctx, unsigned rounds,
+			   const uint32_t *keys, size_t length,
+			   uint8_t *dst, const uint8_t *src);
+#else
+#undef _ccm_aes_decrypt
+#define _ccm_aes_decrypt(ctx, rounds, keys, length, dst, src) ((size_t) 0)
+#endif
+
+#endif /* NETTLE_CCM_INTERNAL_H_INCLUDED */
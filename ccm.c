@@ -44,6 +44,8 @@
 #include "ccm.h"
 #include "ctr.h"
 
+#include "aes-internal.h"
+#include "ccm-internal.h"
 #include "memops.h"
 #include "nettle-internal.h"
 #include "macros.h"
@@ -192,6 +194,37 @@ ccm_update(struct ccm_ctx *ctx, const void *cipher, nettle_cipher_func *f,
   if (ctx->blength) memxor(&ctx->tag.b, data, ctx->blength);
 }
 
+#if HAVE_NATIVE_ccm_aes_encrypt || HAVE_NATIVE_ccm_aes_decrypt
+/* Looks up the subkeys and round count, if the cipher is aes, which
+   can use the combined ccm functions. */
+static const uint32_t *
+ccm_aes_lookup (const void *cipher, nettle_cipher_func *f, unsigned *rounds)
+{
+  if (f == (nettle_cipher_func *) aes128_encrypt)
+    {
+      *rounds = _AES128_ROUNDS;
+      return ((const struct aes128_ctx *) cipher)->keys;
+    }
+  else if (f == (nettle_cipher_func *) aes256_encrypt)
+    {
+      *rounds = _AES256_ROUNDS;
+      return ((const struct aes256_ctx *) cipher)->keys;
+    }
+  else if (f == (nettle_cipher_func *) aes192_encrypt)
+    {
+      *rounds = _AES192_ROUNDS;
+      return ((const struct aes192_ctx *) cipher)->keys;
+    }
+  else if (f == (nettle_cipher_func *) aes_encrypt)
+    {
+      *rounds = ((const struct aes_ctx *) cipher)->rounds;
+      return ((const struct aes_ctx *) cipher)->keys;
+    }
+  else
+    return NULL;
+}
+#endif
+
 /*
  * Because of the underlying CTR mode encryption, when called multiple times
  * the data in intermediate calls must be provided in multiples of the block
@@ -202,6 +235,19 @@ ccm_encrypt(struct ccm_ctx *ctx, const void *cipher, nettle_cipher_func *f,
 	    size_t length, uint8_t *dst, const uint8_t *src)
 {
   ccm_pad(ctx, cipher, f);
+#if HAVE_NATIVE_ccm_aes_encrypt
+  {
+    unsigned rounds;
+    const uint32_t *keys = ccm_aes_lookup (cipher, f, &rounds);
+    if (keys)
+      {
+	size_t done = _ccm_aes_encrypt (ctx, rounds, keys, length, dst, src);
+	length -= done;
+	dst += done;
+	src += done;
+      }
+  }
+#endif
   ccm_update(ctx, cipher, f, length, src);
   ctr_crypt(cipher, f, CCM_BLOCK_SIZE, ctx->ctr.b, length, dst, src);
 }
@@ -215,11 +261,47 @@ void
 ccm_decrypt(struct ccm_ctx *ctx, const void *cipher, nettle_cipher_func *f,
 	    size_t length, uint8_t *dst, const uint8_t *src)
 {
+#if HAVE_NATIVE_ccm_aes_decrypt
+  {
+    unsigned rounds;
+    const uint32_t *keys = ccm_aes_lookup (cipher, f, &rounds);
+    if (keys)
+      {
+	size_t done;
+	ccm_pad(ctx, cipher, f);
+	done = _ccm_aes_decrypt (ctx, rounds, keys, length, dst, src);
+	length -= done;
+	dst += done;
+	src += done;
+      }
+  }
+#endif
   ctr_crypt(cipher, f, CCM_BLOCK_SIZE, ctx->ctr.b, length, dst, src);
   ccm_pad(ctx, cipher, f);
   ccm_update(ctx, cipher, f, length, dst);
 }
 
+#if HAVE_NATIVE_ccm_aes_encrypt
+/* For fat builds, when the native code can't be used. */
+size_t
+_nettle_ccm_aes_encrypt_c (struct ccm_ctx *ctx UNUSED, unsigned rounds UNUSED,
+			   const uint32_t *keys UNUSED, size_t length UNUSED,
+			   uint8_t *dst UNUSED, const uint8_t *src UNUSED)
+{
+  return 0;
+}
+#endif
+
+#if HAVE_NATIVE_ccm_aes_decrypt
+size_t
+_nettle_ccm_aes_decrypt_c (struct ccm_ctx *ctx UNUSED, unsigned rounds UNUSED,
+			   const uint32_t *keys UNUSED, size_t length UNUSED,
+			   uint8_t *dst UNUSED, const uint8_t *src UNUSED)
+{
+  return 0;
+}
+#endif
+
 void
 ccm_digest(struct ccm_ctx *ctx, const void *cipher, nettle_cipher_func *f,
 	   size_t length, uint8_t *digest)
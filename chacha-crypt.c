@@ -47,40 +47,91 @@
 #include <string.h>
 
 #include "chacha.h"
+#include "chacha-internal.h"
 
 #include "macros.h"
 #include "memxor.h"
 
 #define CHACHA_ROUNDS 20
 
+/* Largest number of blocks generated at a time. */
+#if HAVE_NATIVE_chacha_8core
+# define CHACHA_MAX_BLOCKS 8
+#elif HAVE_NATIVE_chacha_4core
+# define CHACHA_MAX_BLOCKS 4
+#else
+# define CHACHA_MAX_BLOCKS 1
+#endif
+
+#if HAVE_NATIVE_chacha_8core
+/* For fat builds. Only x86_64 has _chacha_8core, and there
+   _chacha_4core is always available. */
+void
+_nettle_chacha_8core_c(uint32_t *dst, const uint32_t *src, unsigned rounds)
+{
+  uint32_t s[_CHACHA_STATE_LENGTH];
+
+  _chacha_4core (dst, src, rounds);
+  memcpy (s, src, sizeof(s));
+  s[12] += 4;
+  s[13] += (s[12] < 4);
+  _chacha_4core (dst + 4*_CHACHA_STATE_LENGTH, s, rounds);
+}
+#endif
+
 void
 chacha_crypt(struct chacha_ctx *ctx,
 	      size_t length,
 	      uint8_t *c,
 	      const uint8_t *m)
 {
-  if (!length)
-    return;
-  
-  for (;;)
-    {
-      uint32_t x[_CHACHA_STATE_LENGTH];
+  uint32_t x[CHACHA_MAX_BLOCKS * _CHACHA_STATE_LENGTH];
 
-      _chacha_core (x, ctx->state, CHACHA_ROUNDS);
+  while (length > 0)
+    {
+      unsigned blocks;
 
-      ctx->state[13] += (++ctx->state[12] == 0);
+      /* Use the widest function for which at least half of the
+	 output is needed. */
+#if HAVE_NATIVE_chacha_8core
+      if (length > 4*CHACHA_BLOCK_SIZE)
+	{
+	  _chacha_8core (x, ctx->state, CHACHA_ROUNDS);
+	  blocks = 8;
+	}
+      else
+#endif
+#if HAVE_NATIVE_chacha_4core
+      if (length > 2*CHACHA_BLOCK_SIZE)
+	{
+	  _chacha_4core (x, ctx->state, CHACHA_ROUNDS);
+	  blocks = 4;
+	}
+      else
+#endif
+	{
+	  _chacha_core (x, ctx->state, CHACHA_ROUNDS);
+	  blocks = 1;
+	}
 
       /* stopping at 2^70 length per nonce is user's responsibility */
-      
-      if (length <= CHACHA_BLOCK_SIZE)
+
+      if (length <= blocks * CHACHA_BLOCK_SIZE)
 	{
+	  blocks = (length + CHACHA_BLOCK_SIZE - 1) / CHACHA_BLOCK_SIZE;
+	  ctx->state[12] += blocks;
+	  ctx->state[13] += (ctx->state[12] < blocks);
+
 	  memxor3 (c, m, x, length);
 	  return;
 	}
-      memxor3 (c, m, x, CHACHA_BLOCK_SIZE);
+      ctx->state[12] += blocks;
+      ctx->state[13] += (ctx->state[12] < blocks);
+
+      memxor3 (c, m, x, blocks * CHACHA_BLOCK_SIZE);
 
-      length -= CHACHA_BLOCK_SIZE;
-      c += CHACHA_BLOCK_SIZE;
-      m += CHACHA_BLOCK_SIZE;
-  }
+      length -= blocks * CHACHA_BLOCK_SIZE;
+      c += blocks * CHACHA_BLOCK_SIZE;
+      m += blocks * CHACHA_BLOCK_SIZE;
+    }
 }
@@ -0,0 +1,58 @@
+/* chacha-internal.h
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_CHACHA_INTERNAL_H_INCLUDED
+#define NETTLE_CHACHA_INTERNAL_H_INCLUDED
+
+#include "chacha.h"
+
+/* Name mangling */
+#define _chacha_4core _nettle_chacha_4core
+#define _chacha_8core _nettle_chacha_8core
+
+/* Functions generating several consecutive blocks in parallel,
+   available only in some configurations. The input state is not
+   modified. The block counter in words 12 and 13 is incremented for
+   each block, as a 64-bit number. */
+#if HAVE_NATIVE_chacha_4core
+void
+_chacha_4core(uint32_t *dst, const uint32_t *src, unsigned rounds);
+#endif
+
+#if HAVE_NATIVE_chacha_8core
+void
+_chacha_8core(uint32_t *dst, const uint32_t *src, unsigned rounds);
+/* For fat builds */
+void
+_nettle_chacha_8core_c(uint32_t *dst, const uint32_t *src, unsigned rounds);
+#endif
+
+#endif /* NETTLE_CHACHA_INTERNAL_H_INCLUDED */
@@ -55,9 +55,15 @@
 #include "chacha-poly1305.h"
 
 #include "macros.h"
+#include "memops.h"
 
 #define CHACHA_ROUNDS 20
 
+/* Encryption and decryption process the data in chunks of this size,
+   so that each chunk is still in the cache when it is read the second
+   time. Must be a multiple of the chacha block size. */
+#define CHUNK_SIZE 2048
+
 /* FIXME: Also set nonce to zero, and implement nonce
    auto-increment? */
 void
@@ -88,14 +94,12 @@ chacha_poly1305_set_nonce (struct chacha_poly1305_ctx *ctx,
   ctx->auth_size = ctx->data_size = ctx->index = 0;
 }
 
-/* FIXME: Duplicated in poly1305-aes128.c */
-#define COMPRESS(ctx, data) _poly1305_block(&(ctx)->poly1305, (data), 1)
-
 static void
 poly1305_update (struct chacha_poly1305_ctx *ctx,
 		 size_t length, const uint8_t *data)
 {
-  MD_UPDATE (ctx, length, data, COMPRESS, (void) 0);
+  ctx->index = _poly1305_update (&ctx->poly1305, ctx->block, ctx->index,
+				 length, data);
 }
 
 static void
@@ -128,10 +132,16 @@ chacha_poly1305_encrypt (struct chacha_poly1305_ctx *ctx,
 
   assert (ctx->data_size % CHACHA_POLY1305_BLOCK_SIZE == 0);
   poly1305_pad (ctx);
+  ctx->data_size += length;
 
+  for (; length > CHUNK_SIZE;
+       length -= CHUNK_SIZE, dst += CHUNK_SIZE, src += CHUNK_SIZE)
+    {
+      chacha_crypt (&ctx->chacha, CHUNK_SIZE, dst, src);
+      poly1305_update (ctx, CHUNK_SIZE, dst);
+    }
   chacha_crypt (&ctx->chacha, length, dst, src);
   poly1305_update (ctx, length, dst);
-  ctx->data_size += length;
 }
 			 
 void
@@ -143,10 +153,16 @@ chacha_poly1305_decrypt (struct chacha_poly1305_ctx *ctx,
 
   assert (ctx->data_size % CHACHA_POLY1305_BLOCK_SIZE == 0);
   poly1305_pad (ctx);
+  ctx->data_size += length;
 
+  for (; length > CHUNK_SIZE;
+       length -= CHUNK_SIZE, dst += CHUNK_SIZE, src += CHUNK_SIZE)
+    {
+      poly1305_update (ctx, CHUNK_SIZE, src);
+      chacha_crypt (&ctx->chacha, CHUNK_SIZE, dst, src);
+    }
   poly1305_update (ctx, length, src);
   chacha_crypt (&ctx->chacha, length, dst, src);
-  ctx->data_size += length;
 }
 			 
 void
@@ -164,3 +180,37 @@ chacha_poly1305_digest (struct chacha_poly1305_ctx *ctx,
   poly1305_digest (&ctx->poly1305, &ctx->s);
   memcpy (digest, &ctx->s.b, length);
 }
+
+void
+chacha_poly1305_seal (struct chacha_poly1305_ctx *ctx,
+		      const uint8_t *nonce,
+		      size_t alength, const uint8_t *adata,
+		      size_t clength, uint8_t *dst, const uint8_t *src)
+{
+  size_t mlength;
+
+  assert (clength >= CHACHA_POLY1305_DIGEST_SIZE);
+  mlength = clength - CHACHA_POLY1305_DIGEST_SIZE;
+
+  chacha_poly1305_set_nonce (ctx, nonce);
+  poly1305_update (ctx, alength, adata);
+  ctx->auth_size = alength;
+  chacha_poly1305_encrypt (ctx, mlength, dst, src);
+  chacha_poly1305_digest (ctx, CHACHA_POLY1305_DIGEST_SIZE, dst + mlength);
+}
+
+int
+chacha_poly1305_open (struct chacha_poly1305_ctx *ctx,
+		      const uint8_t *nonce,
+		      size_t alength, const uint8_t *adata,
+		      size_t mlength, uint8_t *dst, const uint8_t *src)
+{
+  uint8_t tag[CHACHA_POLY1305_DIGEST_SIZE];
+
+  chacha_poly1305_set_nonce (ctx, nonce);
+  poly1305_update (ctx, alength, adata);
+  ctx->auth_size = alength;
+  chacha_poly1305_decrypt (ctx, mlength, dst, src);
+  chacha_poly1305_digest (ctx, CHACHA_POLY1305_DIGEST_SIZE, tag);
+  return memeql_sec (tag, src + mlength, CHACHA_POLY1305_DIGEST_SIZE);
+}
@@ -49,6 +49,8 @@ extern "C" {
 #define chacha_poly1305_decrypt nettle_chacha_poly1305_decrypt
 #define chacha_poly1305_encrypt nettle_chacha_poly1305_encrypt
 #define chacha_poly1305_digest nettle_chacha_poly1305_digest
+#define chacha_poly1305_seal nettle_chacha_poly1305_seal
+#define chacha_poly1305_open nettle_chacha_poly1305_open
 
 #define CHACHA_POLY1305_BLOCK_SIZE 64
 /* FIXME: Any need for 128-bit variant? */
@@ -91,6 +93,23 @@ void
 chacha_poly1305_digest (struct chacha_poly1305_ctx *ctx,
 			size_t length, uint8_t *digest);
 
+/* Process a complete message, using the key set by
+   chacha_poly1305_set_key. The ciphertext is the encrypted message
+   followed by the digest, so clength = mlength +
+   CHACHA_POLY1305_DIGEST_SIZE. open returns 1 if the digest is
+   valid, and 0 otherwise. */
+void
+chacha_poly1305_seal (struct chacha_poly1305_ctx *ctx,
+		      const uint8_t *nonce,
+		      size_t alength, const uint8_t *adata,
+		      size_t clength, uint8_t *dst, const uint8_t *src);
+
+int
+chacha_poly1305_open (struct chacha_poly1305_ctx *ctx,
+		      const uint8_t *nonce,
+		      size_t alength, const uint8_t *adata,
+		      size_t mlength, uint8_t *dst, const uint8_t *src);
+
 #ifdef __cplusplus
 }
 #endif
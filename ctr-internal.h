@@ -0,0 +1,64 @@
+/* ctr-internal.h
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_CTR_INTERNAL_H_INCLUDED
+#define NETTLE_CTR_INTERNAL_H_INCLUDED
+
+#include "nettle-types.h"
+
+/* Name mangling */
+#define _ctr_fill16 _nettle_ctr_fill16
+#define _ctr_crypt16 _nettle_ctr_crypt16
+
+/* Fills the buffer with n consecutive 16-byte counter blocks, and
+   advances ctr by n. */
+typedef void
+nettle_fill16_func(uint8_t *ctr, size_t n, uint8_t *buffer);
+
+/* Counter mode encryption of a whole number of blocks, doing counter
+   generation, encryption and xor in a single pass. Advances ctr by
+   length / 16. */
+typedef void
+nettle_ctr_crypt16_func(const void *ctx, uint8_t *ctr,
+			size_t length, uint8_t *dst, const uint8_t *src);
+
+/* Increments the counter as a 128-bit big-endian number. */
+void
+_ctr_fill16(uint8_t *ctr, size_t n, uint8_t *buffer);
+
+/* Counter mode for ciphers with 16-byte blocks. */
+void
+_ctr_crypt16(const void *ctx, nettle_cipher_func *f,
+	     nettle_fill16_func *fill, uint8_t *ctr,
+	     size_t length, uint8_t *dst,
+	     const uint8_t *src);
+
+#endif /* NETTLE_CTR_INTERNAL_H_INCLUDED */
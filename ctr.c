@@ -41,19 +41,87 @@
 
 #include "ctr.h"
 
+#include "aes-internal.h"
+#include "ctr-internal.h"
 #include "macros.h"
 #include "memxor.h"
 #include "nettle-internal.h"
 
 #define NBLOCKS 4
 
+#if HAVE_NATIVE_aes_ctr_crypt
+static void
+aes_ctr_crypt16(const void *ctx, uint8_t *ctr,
+		size_t length, uint8_t *dst, const uint8_t *src)
+{
+  const struct aes_ctx *aes = (const struct aes_ctx *) ctx;
+  _aes_ctr_crypt(aes->rounds, aes->keys, ctr, length, dst, src);
+}
+
+static void
+aes128_ctr_crypt16(const void *ctx, uint8_t *ctr,
+		   size_t length, uint8_t *dst, const uint8_t *src)
+{
+  _aes_ctr_crypt(_AES128_ROUNDS, ((const struct aes128_ctx *) ctx)->keys,
+		 ctr, length, dst, src);
+}
+
+static void
+aes192_ctr_crypt16(const void *ctx, uint8_t *ctr,
+		   size_t length, uint8_t *dst, const uint8_t *src)
+{
+  _aes_ctr_crypt(_AES192_ROUNDS, ((const struct aes192_ctx *) ctx)->keys,
+		 ctr, length, dst, src);
+}
+
+static void
+aes256_ctr_crypt16(const void *ctx, uint8_t *ctr,
+		   size_t length, uint8_t *dst, const uint8_t *src)
+{
+  _aes_ctr_crypt(_AES256_ROUNDS, ((const struct aes256_ctx *) ctx)->keys,
+		 ctr, length, dst, src);
+}
+
+/* Looks up a combined counter mode function for the cipher, if there
+   is one. */
+static nettle_ctr_crypt16_func *
+ctr_crypt16_lookup (nettle_cipher_func *f)
+{
+  if (f == (nettle_cipher_func *) aes128_encrypt)
+    return aes128_ctr_crypt16;
+  else if (f == (nettle_cipher_func *) aes256_encrypt)
+    return aes256_ctr_crypt16;
+  else if (f == (nettle_cipher_func *) aes192_encrypt)
+    return aes192_ctr_crypt16;
+  else if (f == (nettle_cipher_func *) aes_encrypt)
+    return aes_ctr_crypt16;
+  else
+    return NULL;
+}
+#else /* !HAVE_NATIVE_aes_ctr_crypt */
+#define ctr_crypt16_lookup(f) ((nettle_ctr_crypt16_func *) NULL)
+#endif /* !HAVE_NATIVE_aes_ctr_crypt */
+
 void
 ctr_crypt(const void *ctx, nettle_cipher_func *f,
 	  size_t block_size, uint8_t *ctr,
 	  size_t length, uint8_t *dst,
 	  const uint8_t *src)
 {
-  if (src != dst)
+  if (block_size == 16)
+    {
+      nettle_ctr_crypt16_func *crypt = ctr_crypt16_lookup (f);
+      if (crypt)
+	{
+	  size_t done = length & -(size_t) 16;
+	  crypt (ctx, ctr, done, dst, src);
+	  length -= done;
+	  dst += done;
+	  src += done;
+	}
+      _ctr_crypt16(ctx, f, _ctr_fill16, ctr, length, dst, src);
+    }
+  else if (src != dst)
     {
       if (length == block_size)
 	{
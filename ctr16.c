@@ -0,0 +1,125 @@
+/* ctr16.c
+
+   Cipher counter mode, optimized for 16-byte blocks.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include "ctr.h"
+
+#include "ctr-internal.h"
+#include "macros.h"
+#include "memxor.h"
+#include "nettle-internal.h"
+
+/* Number of blocks generated and encrypted per call to the cipher
+   function, when we need a separate buffer. */
+#define CTR_BUFFER_BLOCKS 32
+
+void
+_ctr_fill16(uint8_t *ctr, size_t n, uint8_t *buffer)
+{
+  uint64_t hi, lo;
+  size_t i;
+
+  hi = READ_UINT64(ctr);
+  lo = READ_UINT64(ctr + 8);
+
+  for (i = 0; i < n; i++, buffer += 16)
+    {
+      WRITE_UINT64(buffer, hi);
+      WRITE_UINT64(buffer + 8, lo);
+      hi += !(++lo);
+    }
+
+  WRITE_UINT64(ctr, hi);
+  WRITE_UINT64(ctr + 8, lo);
+}
+
+void
+_ctr_crypt16(const void *ctx, nettle_cipher_func *f,
+	     nettle_fill16_func *fill, uint8_t *ctr,
+	     size_t length, uint8_t *dst,
+	     const uint8_t *src)
+{
+  if (dst != src)
+    {
+      /* Generate the keystream in place, in the destination area. */
+      size_t done = length & -(size_t) 16;
+      if (done > 0)
+	{
+	  fill(ctr, done / 16, dst);
+	  f(ctx, done, dst, dst);
+	  memxor(dst, src, done);
+
+	  length -= done;
+	  dst += done;
+	  src += done;
+	}
+    }
+  else
+    {
+      uint8_t buffer[CTR_BUFFER_BLOCKS * 16];
+
+      while (length >= 16)
+	{
+	  size_t blocks = length / 16;
+	  size_t chunk;
+
+	  if (blocks > CTR_BUFFER_BLOCKS)
+	    blocks = CTR_BUFFER_BLOCKS;
+
+	  chunk = blocks * 16;
+	  fill(ctr, blocks, buffer);
+	  f(ctx, chunk, buffer, buffer);
+	  memxor(dst, buffer, chunk);
+
+	  length -= chunk;
+	  dst += chunk;
+	  src += chunk;
+	}
+    }
+
+  if (length > 0)
+    {
+      /* Final, partial, block */
+      uint8_t buffer[16];
+      assert (length < 16);
+
+      fill(ctr, 1, buffer);
+      f(ctx, 16, buffer, buffer);
+      memxor3(dst, src, buffer, length);
+    }
+}
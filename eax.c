@@ -41,6 +41,7 @@
 #include "eax.h"
 
 #include "ctr.h"
+#include "macros.h"
 #include "memxor.h"
 
 static void
@@ -62,26 +63,51 @@ block16_xor (union nettle_block16 *dst, const union nettle_block16 *src)
 #endif
 }
 
+/* Encrypts the OMAC state. For the first block, the state is the
+   initial block, and its encryption is taken from the key. */
+static void
+omac_encrypt (union nettle_block16 *state, const struct eax_key *key,
+	      unsigned t, unsigned *pending,
+	      const void *cipher, nettle_cipher_func *f)
+{
+  if (*pending & (1U << t))
+    {
+      *state = key->omac_start[t];
+      *pending &= ~(1U << t);
+    }
+  else
+    f (cipher, EAX_BLOCK_SIZE, state->b, state->b);
+}
+
+/* Absorbs a final partial block, into an already encrypted state. */
+static void
+omac_partial (union nettle_block16 *state, const struct eax_key *key,
+	      size_t length, const uint8_t *data)
+{
+  memxor (state->b, data, length);
+  state->b[length] ^= 0x80;
+  /* XOR with (P ^ B), since the digest processing
+   * unconditionally XORs with B */
+  block16_xor (state, &key->pad_partial);
+}
+
 static void
 omac_update (union nettle_block16 *state, const struct eax_key *key,
+	     unsigned t, unsigned *pending,
 	     const void *cipher, nettle_cipher_func *f,
 	     size_t length, const uint8_t *data)
 {
   for (; length >= EAX_BLOCK_SIZE;
        length -= EAX_BLOCK_SIZE, data += EAX_BLOCK_SIZE)
     {
-      f (cipher, EAX_BLOCK_SIZE, state->b, state->b);
+      omac_encrypt (state, key, t, pending, cipher, f);
       memxor (state->b, data, EAX_BLOCK_SIZE);
     }
   if (length > 0)
     {
       /* Allowed only for the last call */
-      f (cipher, EAX_BLOCK_SIZE, state->b, state->b);
-      memxor (state->b, data, length);
-      state->b[length] ^= 0x80;
-      /* XOR with (P ^ B), since the digest processing
-       * unconditionally XORs with B */
-      block16_xor (state, &key->pad_partial);
+      omac_encrypt (state, key, t, pending, cipher, f);
+      omac_partial (state, key, length, data);
     }
 }
 
@@ -110,11 +136,21 @@ gf2_double (uint8_t *r, const uint8_t *a)
 void
 eax_set_key (struct eax_key *key, const void *cipher, nettle_cipher_func *f)
 {
-  static const union nettle_block16 zero_block;
-  f (cipher, EAX_BLOCK_SIZE, key->pad_block.b, zero_block.b);
-  gf2_double (key->pad_block.b, key->pad_block.b);
+  /* The zero block, followed by the initial OMAC blocks. */
+  union nettle_block16 block[4];
+  unsigned t;
+
+  memset (block[0].b, 0, EAX_BLOCK_SIZE);
+  for (t = 0; t < 3; t++)
+    omac_init (&block[t+1], t);
+
+  f (cipher, sizeof(block), block[0].b, block[0].b);
+
+  gf2_double (key->pad_block.b, block[0].b);
   gf2_double (key->pad_partial.b, key->pad_block.b);
   block16_xor (&key->pad_partial, &key->pad_block);
+  for (t = 0; t < 3; t++)
+    key->omac_start[t] = block[t+1];
 }
 
 void
@@ -122,8 +158,10 @@ eax_set_nonce (struct eax_ctx *eax, const struct eax_key *key,
 	       const void *cipher, nettle_cipher_func *f,
 	       size_t nonce_length, const uint8_t *nonce)
 {
+  eax->omac_pending = 7;
   omac_init (&eax->omac_nonce, 0);
-  omac_update (&eax->omac_nonce, key, cipher, f, nonce_length, nonce);
+  omac_update (&eax->omac_nonce, key, 0, &eax->omac_pending,
+	       cipher, f, nonce_length, nonce);
   omac_final (&eax->omac_nonce, key, cipher, f);
   memcpy (eax->ctr.b, eax->omac_nonce.b, EAX_BLOCK_SIZE);
 
@@ -136,7 +174,35 @@ eax_update (struct eax_ctx *eax, const struct eax_key *key,
 	    const void *cipher, nettle_cipher_func *f,
 	    size_t data_length, const uint8_t *data)
 {
-  omac_update (&eax->omac_data, key, cipher, f, data_length, data);
+  omac_update (&eax->omac_data, key, 1, &eax->omac_pending,
+	       cipher, f, data_length, data);
+}
+
+/* Encrypts the message OMAC state, and produces the next block of
+   key stream, with a single call to f. */
+static void
+eax_omac_ctr (struct eax_ctx *eax, const struct eax_key *key,
+	      const void *cipher, nettle_cipher_func *f,
+	      union nettle_block16 *stream)
+{
+  union nettle_block16 block[2];
+
+  block[0] = eax->omac_message;
+  block[1] = eax->ctr;
+  INCREMENT (EAX_BLOCK_SIZE, eax->ctr.b);
+
+  if (eax->omac_pending & 4)
+    {
+      eax->omac_message = key->omac_start[2];
+      eax->omac_pending &= ~4U;
+      f (cipher, EAX_BLOCK_SIZE, stream->b, block[1].b);
+    }
+  else
+    {
+      f (cipher, sizeof(block), block[0].b, block[0].b);
+      eax->omac_message = block[0];
+      *stream = block[1];
+    }
 }
 
 void
@@ -144,8 +210,25 @@ eax_encrypt (struct eax_ctx *eax, const struct eax_key *key,
 	     const void *cipher, nettle_cipher_func *f,
 	     size_t length, uint8_t *dst, const uint8_t *src)
 {
-  ctr_crypt (cipher, f, EAX_BLOCK_SIZE, eax->ctr.b, length, dst, src);
-  omac_update (&eax->omac_message, key, cipher, f, length, dst);
+  union nettle_block16 block;
+  union nettle_block16 stream;
+
+  for (; length >= EAX_BLOCK_SIZE;
+       length -= EAX_BLOCK_SIZE, dst += EAX_BLOCK_SIZE, src += EAX_BLOCK_SIZE)
+    {
+      eax_omac_ctr (eax, key, cipher, f, &stream);
+      memcpy (block.b, src, EAX_BLOCK_SIZE);
+      block16_xor (&block, &stream);
+      memcpy (dst, block.b, EAX_BLOCK_SIZE);
+      block16_xor (&eax->omac_message, &block);
+    }
+  if (length > 0)
+    {
+      /* Allowed only for the last call */
+      eax_omac_ctr (eax, key, cipher, f, &stream);
+      memxor3 (dst, src, stream.b, length);
+      omac_partial (&eax->omac_message, key, length, dst);
+    }
 }
 
 void
@@ -153,8 +236,25 @@ eax_decrypt (struct eax_ctx *eax, const struct eax_key *key,
 	     const void *cipher, nettle_cipher_func *f,
 	     size_t length, uint8_t *dst, const uint8_t *src)
 {
-  omac_update (&eax->omac_message, key, cipher, f, length, src);
-  ctr_crypt (cipher, f, EAX_BLOCK_SIZE, eax->ctr.b, length, dst, src);
+  union nettle_block16 block;
+  union nettle_block16 stream;
+
+  for (; length >= EAX_BLOCK_SIZE;
+       length -= EAX_BLOCK_SIZE, dst += EAX_BLOCK_SIZE, src += EAX_BLOCK_SIZE)
+    {
+      eax_omac_ctr (eax, key, cipher, f, &stream);
+      memcpy (block.b, src, EAX_BLOCK_SIZE);
+      block16_xor (&eax->omac_message, &block);
+      block16_xor (&block, &stream);
+      memcpy (dst, block.b, EAX_BLOCK_SIZE);
+    }
+  if (length > 0)
+    {
+      /* Allowed only for the last call */
+      eax_omac_ctr (eax, key, cipher, f, &stream);
+      omac_partial (&eax->omac_message, key, length, src);
+      memxor3 (dst, src, stream.b, length);
+    }
 }
 
 void
@@ -162,11 +262,18 @@ eax_digest (struct eax_ctx *eax, const struct eax_key *key,
 	    const void *cipher, nettle_cipher_func *f,
 	    size_t length, uint8_t *digest)
 {
+  /* Both final OMAC blocks, in a single call to f. */
+  union nettle_block16 block[2];
+
   assert (length > 0);
   assert (length <= EAX_BLOCK_SIZE);
-  omac_final (&eax->omac_data, key, cipher, f);
-  omac_final (&eax->omac_message, key, cipher, f);
 
-  block16_xor (&eax->omac_nonce, &eax->omac_data);
-  memxor3 (digest, eax->omac_nonce.b, eax->omac_message.b, length);
+  block[0] = eax->omac_data;
+  block[1] = eax->omac_message;
+  block16_xor (&block[0], &key->pad_block);
+  block16_xor (&block[1], &key->pad_block);
+  f (cipher, sizeof(block), block[0].b, block[0].b);
+
+  block16_xor (&block[0], &eax->omac_nonce);
+  memxor3 (digest, block[0].b, block[1].b, length);
 }
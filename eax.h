@@ -68,6 +68,8 @@ struct eax_key
 {
   union nettle_block16 pad_block;
   union nettle_block16 pad_partial;
+  /* Encryptions of the initial OMAC blocks, for t = 0, 1, 2 */
+  union nettle_block16 omac_start[3];
 };
 
 struct eax_ctx
@@ -76,6 +78,9 @@ struct eax_ctx
   union nettle_block16 omac_data;
   union nettle_block16 omac_message;
   union nettle_block16 ctr;
+  /* Bit t is set while the OMAC state for t is still the initial
+     block, whose encryption is in omac_start[t]. */
+  unsigned omac_pending;
 };
 
 void
@@ -0,0 +1,227 @@
+/* ecc-ecdsa-verify-batch.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ecdsa.h"
+#include "ecc-internal.h"
+
+/* Batch ECDSA verify. The inversions of s are replaced by a single
+   inversion of their product, using Montgomery's trick, and the
+   final check is done in Jacobian coordinates, avoiding the
+   inversion of z. */
+
+static int
+zero_p (const mp_limb_t *xp, mp_size_t n)
+{
+  while (n > 0)
+    if (xp[--n] > 0)
+      return 0;
+  return 1;
+}
+
+static int
+ecdsa_in_range (const struct ecc_curve *ecc, const mp_limb_t *xp)
+{
+  return !zero_p (xp, ecc->p.size)
+    && mpn_cmp (xp, ecc->q.m, ecc->p.size) < 0;
+}
+
+static void
+mod_canonical (const struct ecc_modulo *m, mp_limb_t *rp)
+{
+  while (mpn_cmp (rp, m->m, m->size) >= 0)
+    mpn_sub_n (rp, rp, m->m, m->size);
+}
+
+/* Checks if the x coordinate of the Jacobian point P, reduced modulo
+   q, equals r. With affine x = X / Z^2 < p, and p < 2q, this holds
+   if X = r Z^2 or, when r + q < p, X = (r + q) Z^2 (mod p). For
+   curves using redc, the products below cancel the extra factors.
+   Needs 7*ecc->p.size limbs of scratch. */
+static int
+equal_x_mod_q (const struct ecc_curve *ecc, const mp_limb_t *p,
+	       const mp_limb_t *rp, mp_limb_t *scratch)
+{
+#define z2 scratch
+#define xp (scratch + 2*ecc->p.size)
+#define tp (scratch + 4*ecc->p.size)
+#define rq (scratch + 6*ecc->p.size)
+
+  ecc_modp_sqr (ecc, z2, p + 2*ecc->p.size);
+
+  mpn_copyi (xp, p, ecc->p.size);
+  mpn_zero (xp + ecc->p.size, ecc->p.size);
+  ecc->p.reduce (&ecc->p, xp);
+  mod_canonical (&ecc->p, xp);
+
+  ecc_modp_mul (ecc, tp, z2, rp);
+  mod_canonical (&ecc->p, tp);
+  if (mpn_cmp (tp, xp, ecc->p.size) == 0)
+    return 1;
+
+  if (mpn_add_n (rq, rp, ecc->q.m, ecc->p.size)
+      || mpn_cmp (rq, ecc->p.m, ecc->p.size) >= 0)
+    return 0;
+
+  ecc_modp_mul (ecc, tp, z2, rq);
+  mod_canonical (&ecc->p, tp);
+  return mpn_cmp (tp, xp, ecc->p.size) == 0;
+
+#undef z2
+#undef xp
+#undef tp
+#undef rq
+}
+
+mp_size_t
+ecc_ecdsa_verify_batch_itch (const struct ecc_curve *ecc, size_t n)
+{
+  mp_size_t itch = ECC_MUL_ADD_GA_ITCH (ecc->p.size);
+  if (itch < ecc->q.invert_itch)
+    itch = ecc->q.invert_itch;
+  if (itch < ecc_ecdsa_verify_itch (ecc))
+    itch = ecc_ecdsa_verify_itch (ecc);
+
+  return n*ecc->p.size + 11*ecc->p.size + 1 + itch;
+}
+
+int
+ecc_ecdsa_verify_batch (const struct ecc_curve *ecc,
+			size_t n,
+			const mp_limb_t * const *pp, /* Public keys */
+			const size_t *length,
+			const uint8_t * const *digest,
+			const mp_limb_t *rp, const mp_limb_t *sp,
+			int *valid,
+			mp_limb_t *scratch)
+{
+  /* For each signature, the procedure is the same as for
+     ecc_ecdsa_verify. With c_i = s_0 s_1 ... s_i, we get
+
+       1 / s_i = c_{i-1} / c_i
+
+     so that one inversion of c_{n-1} suffices. Signatures out of
+     range use s_i = 1 in the product. */
+#define cp(i) (scratch + (i)*ecc->p.size)
+#define one (scratch + n*ecc->p.size)
+#define inv (one + ecc->p.size)
+#define tp (inv + ecc->p.size)
+#define u1 (tp + 2*ecc->p.size)
+#define u2 (u1 + ecc->p.size)
+#define P (u2 + ecc->p.size)
+#define hp (P + 3*ecc->p.size)
+#define scratch_out (hp + ecc->p.size + 1)
+#define S(i) (valid[i] ? sp + (i)*ecc->p.size : one)
+
+  size_t i;
+  int res;
+
+  if (ecc_edwards_p (ecc))
+    {
+      /* Edwards curve, not supported by ecc_mul_add_ga. */
+      for (i = 0, res = 1; i < n; i++)
+	{
+	  valid[i] = ecc_ecdsa_verify (ecc, pp[i], length[i], digest[i],
+				       rp + i*ecc->p.size, sp + i*ecc->p.size,
+				       scratch);
+	  res &= valid[i];
+	}
+      return res;
+    }
+
+  if (n == 0)
+    return 1;
+
+  mpn_zero (one, ecc->p.size);
+  one[0] = 1;
+
+  for (i = 0; i < n; i++)
+    {
+      valid[i] = (ecdsa_in_range (ecc, rp + i*ecc->p.size)
+		  && ecdsa_in_range (ecc, sp + i*ecc->p.size));
+      if (i == 0)
+	mpn_copyi (cp(0), S(0), ecc->p.size);
+      else
+	{
+	  ecc_modq_mul (ecc, tp, cp(i-1), S(i));
+	  mpn_copyi (cp(i), tp, ecc->p.size);
+	}
+    }
+
+  ecc->q.invert (&ecc->q, inv, cp(n-1), scratch_out);
+
+  /* Replace each c_i by 1/s_i. */
+  for (i = n; --i > 0; )
+    {
+      ecc_modq_mul (ecc, tp, inv, cp(i-1));
+      mpn_copyi (cp(i), tp, ecc->p.size);
+      ecc_modq_mul (ecc, tp, inv, S(i));
+      mpn_copyi (inv, tp, ecc->p.size);
+    }
+  mpn_copyi (cp(0), inv, ecc->p.size);
+
+  for (i = 0, res = 1; i < n; i++)
+    {
+      if (!valid[i])
+	{
+	  res = 0;
+	  continue;
+	}
+
+      /* u1 = h / s, u2 = r / s */
+      ecc_hash (&ecc->q, hp, length[i], digest[i]);
+      ecc_modq_mul (ecc, tp, hp, cp(i));
+      mod_canonical (&ecc->q, tp);
+      mpn_copyi (u1, tp, ecc->p.size);
+      ecc_modq_mul (ecc, tp, rp + i*ecc->p.size, cp(i));
+      mod_canonical (&ecc->q, tp);
+      mpn_copyi (u2, tp, ecc->p.size);
+
+      valid[i] = (ecc_mul_add_ga (ecc, P, u1, u2, pp[i], scratch_out)
+		  && equal_x_mod_q (ecc, P, rp + i*ecc->p.size, scratch_out));
+      res &= valid[i];
+    }
+  return res;
+
+#undef cp
+#undef one
+#undef inv
+#undef tp
+#undef u1
+#undef u2
+#undef P
+#undef hp
+#undef scratch_out
+#undef S
+}
@@ -67,7 +67,6 @@ ecc_ecdsa_verify_itch (const struct ecc_curve *ecc)
   return 5*ecc->p.size + ecc->mul_itch;
 }
 
-/* FIXME: Use faster primitives, not requiring side-channel silence. */
 int
 ecc_ecdsa_verify (const struct ecc_curve *ecc,
 		  const mp_limb_t *pp, /* Public key */
@@ -103,10 +102,6 @@ ecc_ecdsa_verify (const struct ecc_curve *ecc,
 	 && ecdsa_in_range (ecc, sp)))
     return 0;
 
-  /* FIXME: Micro optimizations: Either simultaneous multiplication.
-     Or convert to projective coordinates (can be done without
-     division, I think), and write an ecc_add_ppp. */
-
   /* Compute sinv */
   ecc->q.invert (&ecc->q, sinv, sp, sinv + 2*ecc->p.size);
 
@@ -117,6 +112,29 @@ ecc_ecdsa_verify (const struct ecc_curve *ecc,
   /* u2 = r / s, P2 = u2 * Y */
   ecc_modq_mul (ecc, u2, rp, sinv);
 
+  if (!ecc_edwards_p (ecc))
+    {
+      /* ecc_mul_add_ga needs scalars < q, while ecc_modq_mul only
+	 guarantees results < 2q. When the limbs have room for extra
+	 bits, the result may even exceed 2^{q.bit_size}, and then the
+	 wNAF recoding of u2 would lose the high bits. */
+      if (mpn_cmp (u1, ecc->q.m, ecc->p.size) >= 0)
+	mpn_sub_n (u1, u1, ecc->q.m, ecc->p.size);
+      if (mpn_cmp (u2, ecc->q.m, ecc->p.size) >= 0)
+	mpn_sub_n (u2, u2, ecc->q.m, ecc->p.size);
+
+      /* R = u1 G + u2 Y, using a single, variable time, chain of
+	 doublings. Total storage: 5*ecc->p.size +
+	 ECC_MUL_ADD_GA_ITCH (ecc->p.size) */
+      if (!ecc_mul_add_ga (ecc, P2, u1, u2, pp, u2 + ecc->p.size))
+	return 0;
+
+      /* x coordinate only, modulo q */
+      ecc->h_to_a (ecc, 2, u1, P2, u2 + ecc->p.size);
+
+      return (mpn_cmp (rp, u1, ecc->p.size) == 0);
+    }
+
    /* Total storage: 5*ecc->p.size + ecc->mul_itch */
   ecc->mul (ecc, P2, u2, pp, u2 + ecc->p.size);
 
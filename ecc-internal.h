@@ -66,6 +66,9 @@
 #define ecc_mul_a _nettle_ecc_mul_a
 #define ecc_mul_g_eh _nettle_ecc_mul_g_eh
 #define ecc_mul_a_eh _nettle_ecc_mul_a_eh
+#define ecc_mul_add_ga _nettle_ecc_mul_add_ga
+#define ecc_mul_add_ga_eh _nettle_ecc_mul_add_ga_eh
+#define ecc_wnaf _nettle_ecc_wnaf
 #define cnd_copy _nettle_cnd_copy
 #define sec_add_1 _nettle_sec_add_1
 #define sec_sub_1 _nettle_sec_sub_1
@@ -89,6 +92,9 @@ extern const struct ecc_curve _nettle_curve25519;
 #define ECC_MUL_A_WBITS 4
 /* And for ecc_mul_a_eh */
 #define ECC_MUL_A_EH_WBITS 4
+/* Window size for the wNAF representation used by ecc_mul_add_ga.
+   The table holds 2^{w-2} odd multiples. */
+#define ECC_MUL_ADD_GA_WBITS 5
 
 struct ecc_modulo;
 
@@ -353,6 +359,38 @@ ecc_mul_a (const struct ecc_curve *ecc,
 	   const mp_limb_t *np, const mp_limb_t *p,
 	   mp_limb_t *scratch);
 
+/* True for curves in Edwards form, identified by their point addition
+   function. */
+#define ecc_edwards_p(ecc) ((ecc)->add_hhh == ecc_add_ehh)
+
+/* Computes N * G + M * P, in variable time, for use with public
+   inputs only. N and M are in the range 0 <= N, M < group order, and
+   P is a non-zero point on the curve, in affine coordinates. Output
+   R is in Jacobian coordinates. Returns 1 if R is non-zero, and 0 if
+   the sum is the point at infinity, in which case R is undefined.
+   Not for Edwards curves. */
+int
+ecc_mul_add_ga (const struct ecc_curve *ecc, mp_limb_t *r,
+		const mp_limb_t *np, const mp_limb_t *mp,
+		const mp_limb_t *p, mp_limb_t *scratch);
+
+/* Same as ecc_mul_add_ga, for Edwards curves, with output in
+   homogeneous coordinates. Since the Edwards addition law is
+   complete, there are no exceptional cases, and R is the neutral
+   element when the sum is zero. */
+void
+ecc_mul_add_ga_eh (const struct ecc_curve *ecc, mp_limb_t *r,
+		   const mp_limb_t *np, const mp_limb_t *mp,
+		   const mp_limb_t *p, mp_limb_t *scratch);
+
+/* Computes the wNAF representation of the bit_size bits of np, with
+   window size ECC_MUL_ADD_GA_WBITS, one digit per bit position, and
+   bit_size + 1 positions. Each non-zero digit is odd, less than
+   2^{w-1} in absolute value, and followed by at least w-1 zero
+   digits. */
+void
+ecc_wnaf (signed char *naf, const mp_limb_t *np, unsigned bit_size);
+
 void
 ecc_mul_g_eh (const struct ecc_curve *ecc, mp_limb_t *r,
 	      const mp_limb_t *np, mp_limb_t *scratch);
@@ -405,6 +443,10 @@ curve25519_eh_to_x (mp_limb_t *xp, const mp_limb_t *p,
 #define ECC_MUL_A_EH_ITCH(size) \
   (((3 << ECC_MUL_A_EH_WBITS) + 10) * (size))
 #endif
+#define ECC_MUL_ADD_GA_ITCH(size) \
+  (((3 << (ECC_MUL_ADD_GA_WBITS - 2)) + 11) * (size))
+#define ECC_MUL_ADD_GA_EH_ITCH(size) \
+  (((3 << (ECC_MUL_ADD_GA_WBITS - 2)) + 10) * (size))
 #define ECC_ECDSA_SIGN_ITCH(size) (12*(size))
 #define ECC_MOD_RANDOM_ITCH(size) (size)
 #define ECC_HASH_ITCH(size) (1+(size))
@@ -0,0 +1,137 @@
+/* ecc-mul-add-ga-eh.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ecc.h"
+#include "ecc-internal.h"
+
+/* Variable time computation of N G + M P on an Edwards curve, using
+   a wNAF representation of M and the ecc_mul_g_eh tables for G, like
+   ecc_mul_add_ga. Doublings are skipped while the accumulator is
+   still the neutral element. */
+
+#define TABLE_SIZE (1U << (ECC_MUL_ADD_GA_WBITS - 2))
+#define TABLE(j) (table + (j) * 3*ecc->p.size)
+
+void
+ecc_mul_add_ga_eh (const struct ecc_curve *ecc, mp_limb_t *r,
+		   const mp_limb_t *np, const mp_limb_t *mp,
+		   const mp_limb_t *p, mp_limb_t *scratch)
+{
+#define table scratch
+#define tp (scratch + 3*TABLE_SIZE*ecc->p.size)
+#define scratch_out (tp + 3*ecc->p.size)
+
+  signed char naf[ECC_MAX_SIZE * GMP_NUMB_BITS + 1];
+  unsigned k, c;
+  unsigned i, j;
+  unsigned bit_rows;
+  int is_zero;
+
+  /* Odd multiples (2j+1) P, j = 0, ..., TABLE_SIZE - 1. */
+  ecc_a_to_j (ecc, TABLE(0), p);
+  ecc_dup_eh (ecc, tp, TABLE(0), scratch_out);
+  for (j = 1; j < TABLE_SIZE; j++)
+    ecc_add_ehh (ecc, TABLE(j), TABLE(j-1), tp, scratch_out);
+
+  /* Use all bits, since M need not be fully reduced. */
+  ecc_wnaf (naf, mp, ecc->p.bit_size);
+
+  k = ecc->pippenger_k;
+  c = ecc->pippenger_c;
+
+  bit_rows = (ecc->p.bit_size + k - 1) / k;
+
+  /* x = 0, y = 1, z = 1 */
+  mpn_zero (r, 3*ecc->p.size);
+  r[ecc->p.size] = r[2*ecc->p.size] = 1;
+
+  for (i = ecc->p.bit_size + 1, is_zero = 1; i-- > 0; )
+    {
+      int d;
+      if (!is_zero)
+	ecc_dup_eh (ecc, r, r, scratch_out);
+
+      d = naf[i];
+      if (d != 0)
+	{
+	  const mp_limb_t *q = TABLE ((d < 0 ? -d : d) >> 1);
+	  if (d < 0)
+	    {
+	      /* -(x, y) = (-x, y) */
+	      ecc_modp_sub (ecc, tp, ecc->p.m, q);
+	      mpn_copyi (tp + ecc->p.size, q + ecc->p.size, 2*ecc->p.size);
+	      q = tp;
+	    }
+	  ecc_add_ehh (ecc, r, q, r, scratch_out);
+	  is_zero = 0;
+	}
+      if (i >= k)
+	continue;
+
+      for (j = 0; j * c < bit_rows; j++)
+	{
+	  unsigned bits;
+	  unsigned bit_index;
+
+	  /* Same bit extraction as in ecc_mul_g_eh. */
+	  for (bits = 0, bit_index = i + k*(c*j+c); bit_index > i + k*c*j; )
+	    {
+	      mp_size_t limb_index;
+	      unsigned shift;
+
+	      bit_index -= k;
+
+	      limb_index = bit_index / GMP_NUMB_BITS;
+	      if (limb_index >= ecc->p.size)
+		continue;
+
+	      shift = bit_index % GMP_NUMB_BITS;
+	      bits = (bits << 1) | ((np[limb_index] >> shift) & 1);
+	    }
+	  if (bits == 0)
+	    continue;
+
+	  ecc_add_eh (ecc, r, r,
+		      (ecc->pippenger_table
+		       + (2*ecc->p.size * (mp_size_t) j << c)
+		       + 2*ecc->p.size * (mp_size_t) bits),
+		      scratch_out);
+	  is_zero = 0;
+	}
+    }
+#undef table
+#undef tp
+#undef scratch_out
+}
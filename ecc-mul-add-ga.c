@@ -0,0 +1,232 @@
+/* ecc-mul-add-ga.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include "ecc.h"
+#include "ecc-internal.h"
+
+/* Variable time computation of N G + M P, for signature
+   verification, where all inputs are public. The multiplication by P
+   uses a signed window representation (wNAF) of M, with a table of
+   the odd multiples P, 3P, ..., (2^{w-1} - 1) P. The multiplication
+   by G uses the same tables as ecc_mul_g. Since ecc_mul_g does its
+   k doublings last, its additions are interleaved with the final k
+   doublings of the wNAF loop, so the doublings are shared. */
+
+#define TABLE_SIZE (1U << (ECC_MUL_ADD_GA_WBITS - 2))
+#define TABLE(j) (table + (j) * 3*ecc->p.size)
+
+static int
+zero_p (const mp_limb_t *xp, mp_size_t n)
+{
+  while (n > 0)
+    if (xp[--n] > 0)
+      return 0;
+  return 1;
+}
+
+/* Checks if x = 0 (mod p). Needs 2*ecc->p.size limbs of scratch. */
+static int
+mod_zero_p (const struct ecc_curve *ecc, const mp_limb_t *xp,
+	    mp_limb_t *scratch)
+{
+  mpn_copyi (scratch, xp, ecc->p.size);
+  mpn_zero (scratch + ecc->p.size, ecc->p.size);
+  ecc->p.mod (&ecc->p, scratch);
+  while (mpn_cmp (scratch, ecc->p.m, ecc->p.size) >= 0)
+    mpn_sub_n (scratch, scratch, ecc->p.m, ecc->p.size);
+  return zero_p (scratch, ecc->p.size);
+}
+
+/* Adds Q to the non-zero point R, in place. Q is in affine
+   coordinates if affine is non-zero, otherwise jacobian. Unlike
+   ecc_add_jja and ecc_add_jjj, handles the cases R = Q and R = -Q,
+   which can happen only for carefully chosen inputs. In both cases,
+   the addition formulas give z_3 = 0, and x_3 = 0 only if R = Q.
+   Returns 1 if the sum is zero. */
+static int
+add_nonsec (const struct ecc_curve *ecc, int affine,
+	    mp_limb_t *r, const mp_limb_t *q, mp_limb_t *scratch)
+{
+  if (affine)
+    ecc_add_jja (ecc, r, r, q, scratch);
+  else
+    ecc_add_jjj (ecc, r, r, q, scratch);
+
+  if (!mod_zero_p (ecc, r + 2*ecc->p.size, scratch))
+    return 0;
+  if (!mod_zero_p (ecc, r, scratch))
+    return 1;
+
+  mpn_copyi (r, q, 2*ecc->p.size);
+  mpn_copyi (r + 2*ecc->p.size, affine ? ecc->unit : q + 2*ecc->p.size,
+	     ecc->p.size);
+  ecc_dup_jj (ecc, r, r, scratch);
+  return 0;
+}
+
+static unsigned
+bit_p (const mp_limb_t *np, unsigned bit_size, unsigned i)
+{
+  if (i >= bit_size)
+    return 0;
+  return (np[i / GMP_NUMB_BITS] >> (i % GMP_NUMB_BITS)) & 1;
+}
+
+void
+ecc_wnaf (signed char *naf, const mp_limb_t *np, unsigned bit_size)
+{
+  unsigned i, carry;
+
+  for (i = 0; i <= bit_size; i++)
+    naf[i] = 0;
+
+  for (i = 0, carry = 0; i <= bit_size; )
+    {
+      unsigned j, window;
+      if (((bit_p (np, bit_size, i)) ^ carry) == 0)
+	{
+	  i++;
+	  continue;
+	}
+      for (j = 0, window = carry; j < ECC_MUL_ADD_GA_WBITS; j++)
+	window += bit_p (np, bit_size, i + j) << j;
+
+      carry = window >> (ECC_MUL_ADD_GA_WBITS - 1);
+      naf[i] = (int) window - (int) (carry << ECC_MUL_ADD_GA_WBITS);
+      i += ECC_MUL_ADD_GA_WBITS;
+    }
+  assert (carry == 0);
+}
+
+int
+ecc_mul_add_ga (const struct ecc_curve *ecc, mp_limb_t *r,
+		const mp_limb_t *np, const mp_limb_t *mp,
+		const mp_limb_t *p, mp_limb_t *scratch)
+{
+#define table scratch
+#define tp (scratch + 3*TABLE_SIZE*ecc->p.size)
+#define scratch_out (tp + 3*ecc->p.size)
+
+  signed char naf[ECC_MAX_SIZE * GMP_NUMB_BITS + 1];
+  unsigned k, c;
+  unsigned i, j;
+  unsigned bit_rows;
+  int is_zero;
+
+  /* Odd multiples (2j+1) P, j = 0, ..., TABLE_SIZE - 1. */
+  ecc_a_to_j (ecc, TABLE(0), p);
+  ecc_dup_jj (ecc, tp, TABLE(0), scratch_out);
+  for (j = 1; j < TABLE_SIZE; j++)
+    ecc_add_jjj (ecc, TABLE(j), TABLE(j-1), tp, scratch_out);
+
+  ecc_wnaf (naf, mp, ecc->q.bit_size);
+
+  k = ecc->pippenger_k;
+  c = ecc->pippenger_c;
+
+  bit_rows = (ecc->p.bit_size + k - 1) / k;
+
+  for (i = ecc->q.bit_size + 1, is_zero = 1; i-- > 0; )
+    {
+      int d;
+      if (!is_zero)
+	ecc_dup_jj (ecc, r, r, scratch_out);
+
+      d = naf[i];
+      if (d != 0)
+	{
+	  const mp_limb_t *q = TABLE ((d < 0 ? -d : d) >> 1);
+	  if (d < 0)
+	    {
+	      mpn_copyi (tp, q, ecc->p.size);
+	      ecc_modp_sub (ecc, tp + ecc->p.size, ecc->p.m, q + ecc->p.size);
+	      mpn_copyi (tp + 2*ecc->p.size, q + 2*ecc->p.size, ecc->p.size);
+	      q = tp;
+	    }
+	  if (is_zero)
+	    {
+	      mpn_copyi (r, q, 3*ecc->p.size);
+	      is_zero = 0;
+	    }
+	  else
+	    is_zero = add_nonsec (ecc, 0, r, q, scratch_out);
+	}
+      if (i >= k)
+	continue;
+
+      for (j = 0; j * c < bit_rows; j++)
+	{
+	  const mp_limb_t *q;
+	  unsigned bits;
+	  unsigned bit_index;
+
+	  /* Same bit extraction as in ecc_mul_g. */
+	  for (bits = 0, bit_index = i + k*(c*j+c); bit_index > i + k*c*j; )
+	    {
+	      mp_size_t limb_index;
+	      unsigned shift;
+
+	      bit_index -= k;
+
+	      limb_index = bit_index / GMP_NUMB_BITS;
+	      if (limb_index >= ecc->p.size)
+		continue;
+
+	      shift = bit_index % GMP_NUMB_BITS;
+	      bits = (bits << 1) | ((np[limb_index] >> shift) & 1);
+	    }
+	  if (bits == 0)
+	    continue;
+
+	  q = (ecc->pippenger_table
+	       + (2*ecc->p.size * (mp_size_t) j << c)
+	       + 2*ecc->p.size * (mp_size_t) bits);
+	  if (is_zero)
+	    {
+	      mpn_copyi (r, q, 2*ecc->p.size);
+	      mpn_copyi (r + 2*ecc->p.size, ecc->unit, ecc->p.size);
+	      is_zero = 0;
+	    }
+	  else
+	    is_zero = add_nonsec (ecc, 1, r, q, scratch_out);
+	}
+    }
+  return !is_zero;
+#undef table
+#undef tp
+#undef scratch_out
+}
@@ -0,0 +1,106 @@
+/* ecdsa-verify-batch.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ecdsa.h"
+
+#include "gmp-glue.h"
+
+/* Largest number of signatures sharing one inversion. Beyond this
+   size, the inversion is a negligible part of the work. */
+#define ECDSA_BATCH_SIZE 64
+
+int
+ecdsa_verify_batch (size_t n,
+		    const struct ecc_point *pub,
+		    const size_t *length, const uint8_t * const *digest,
+		    const struct dsa_signature *signature,
+		    int *valid)
+{
+  const mp_limb_t *pp[ECDSA_BATCH_SIZE];
+  int batch_valid[ECDSA_BATCH_SIZE];
+  size_t i, j, count;
+  int res;
+
+  /* Each batch is a run of signatures using the same curve. */
+  for (i = 0, res = 1; i < n; i += count)
+    {
+      const struct ecc_curve *ecc = pub[i].ecc;
+      mp_limb_t size = ecc_size (ecc);
+      mp_size_t itch;
+      mp_limb_t *scratch;
+
+      for (count = 1;
+	   count < ECDSA_BATCH_SIZE && i + count < n
+	     && pub[i + count].ecc == ecc;
+	   count++)
+	;
+
+      itch = 2*count*size + ecc_ecdsa_verify_batch_itch (ecc, count);
+      scratch = gmp_alloc_limbs (itch);
+
+#define rp scratch
+#define sp (scratch + count*size)
+#define scratch_out (scratch + 2*count*size)
+
+      for (j = 0; j < count; j++)
+	{
+	  const struct dsa_signature *s = signature + i + j;
+	  pp[j] = pub[i + j].p;
+
+	  /* Out of range values are replaced by zero, which is
+	     rejected by ecc_ecdsa_verify_batch. */
+	  if (mpz_sgn (s->r) <= 0 || mpz_size (s->r) > size
+	      || mpz_sgn (s->s) <= 0 || mpz_size (s->s) > size)
+	    {
+	      mpn_zero (rp + j*size, size);
+	      mpn_zero (sp + j*size, size);
+	    }
+	  else
+	    {
+	      mpz_limbs_copy (rp + j*size, s->r, size);
+	      mpz_limbs_copy (sp + j*size, s->s, size);
+	    }
+	}
+
+      res &= ecc_ecdsa_verify_batch (ecc, count, pp, length + i, digest + i,
+				     rp, sp, valid ? valid + i : batch_valid,
+				     scratch_out);
+      gmp_free_limbs (scratch, itch);
+#undef rp
+#undef sp
+#undef scratch_out
+    }
+  return res;
+}
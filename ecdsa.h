@@ -44,11 +44,14 @@ extern "C" {
 /* Name mangling */
 #define ecdsa_sign nettle_ecdsa_sign
 #define ecdsa_verify nettle_ecdsa_verify
+#define ecdsa_verify_batch nettle_ecdsa_verify_batch
 #define ecdsa_generate_keypair nettle_ecdsa_generate_keypair
 #define ecc_ecdsa_sign nettle_ecc_ecdsa_sign
 #define ecc_ecdsa_sign_itch nettle_ecc_ecdsa_sign_itch
 #define ecc_ecdsa_verify nettle_ecc_ecdsa_verify
 #define ecc_ecdsa_verify_itch nettle_ecc_ecdsa_verify_itch
+#define ecc_ecdsa_verify_batch nettle_ecc_ecdsa_verify_batch
+#define ecc_ecdsa_verify_batch_itch nettle_ecc_ecdsa_verify_batch_itch
 
 /* High level ECDSA functions.
  *
@@ -66,6 +69,17 @@ ecdsa_verify (const struct ecc_point *pub,
 	      size_t length, const uint8_t *digest,
 	      const struct dsa_signature *signature);
 
+/* Verifies n signatures, sharing the inversions between signatures
+   using the same curve. Returns 1 if all signatures are valid. If
+   valid is non-NULL, valid[i] is set to the result for signature
+   i. */
+int
+ecdsa_verify_batch (size_t n,
+		    const struct ecc_point *pub,
+		    const size_t *length, const uint8_t * const *digest,
+		    const struct dsa_signature *signature,
+		    int *valid);
+
 void
 ecdsa_generate_keypair (struct ecc_point *pub,
 			struct ecc_scalar *key,
@@ -95,6 +109,20 @@ ecc_ecdsa_verify (const struct ecc_curve *ecc,
 		  const mp_limb_t *rp, const mp_limb_t *sp,
 		  mp_limb_t *scratch);
 
+mp_size_t
+ecc_ecdsa_verify_batch_itch (const struct ecc_curve *ecc, size_t n);
+
+/* The values rp and sp are arrays of n signatures of ecc_size limbs
+   each. Sets valid[i] to the result of each verification. */
+int
+ecc_ecdsa_verify_batch (const struct ecc_curve *ecc,
+			size_t n,
+			const mp_limb_t * const *pp, /* Public keys */
+			const size_t *length,
+			const uint8_t * const *digest,
+			const mp_limb_t *rp, const mp_limb_t *sp,
+			int *valid,
+			mp_limb_t *scratch);
 
 #ifdef __cplusplus
 }
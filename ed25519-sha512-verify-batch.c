@@ -0,0 +1,110 @@
+/* ed25519-sha512-verify-batch.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <string.h>
+
+#include "eddsa.h"
+
+#include "ecc-internal.h"
+#include "sha2.h"
+
+/* Largest number of signatures in each multi-scalar multiplication.
+   The work per signature decreases slowly beyond this size, while
+   the cost of locating a bad signature grows. */
+#define ED25519_BATCH_SIZE 128
+
+/* Gives z = 1, to check a single signature using the batch
+   equation. */
+static void
+unit_random (void *ctx UNUSED, size_t length, uint8_t *dst)
+{
+  memset (dst, 0, length);
+  dst[0] = 1;
+}
+
+int
+ed25519_sha512_verify_batch (size_t n,
+			     const uint8_t * const *pub,
+			     const size_t *length,
+			     const uint8_t * const *msg,
+			     const uint8_t * const *signature,
+			     void *random_ctx, nettle_random_func *random,
+			     int *valid)
+{
+  const struct ecc_curve *ecc = &_nettle_curve25519;
+  mp_size_t itch;
+  mp_limb_t *scratch;
+  struct sha512_ctx ctx;
+  size_t i, j, size;
+  int res;
+
+  size = n < ED25519_BATCH_SIZE ? n : ED25519_BATCH_SIZE;
+  itch = _eddsa_verify_batch_itch (ecc, size);
+  scratch = gmp_alloc_limbs (itch);
+
+  for (i = 0, res = 1; i < n; i += size)
+    {
+      if (size > n - i)
+	size = n - i;
+
+      if (_eddsa_verify_batch (ecc, &nettle_sha512, &ctx, size,
+			       pub + i, length + i, msg + i, signature + i,
+			       random_ctx, random, scratch))
+	{
+	  if (valid)
+	    for (j = 0; j < size; j++)
+	      valid[i + j] = 1;
+	  continue;
+	}
+
+      if (!valid)
+	{
+	  res = 0;
+	  break;
+	}
+      /* Check each signature with the same cofactored equation, so
+	 that the result doesn't depend on the rest of the batch. */
+      for (j = 0; j < size; j++)
+	{
+	  valid[i + j] = _eddsa_verify_batch (ecc, &nettle_sha512, &ctx, 1,
+					      pub + i + j, length + i + j,
+					      msg + i + j, signature + i + j,
+					      NULL, unit_random, scratch);
+	  res &= valid[i + j];
+	}
+    }
+  gmp_free_limbs (scratch, itch);
+  return res;
+}
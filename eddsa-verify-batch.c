@@ -0,0 +1,323 @@
+/* eddsa-verify-batch.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <string.h>
+
+#include "eddsa.h"
+
+#include "ecc.h"
+#include "ecc-internal.h"
+#include "nettle-meta.h"
+
+/* Batch verification checks the single equation
+
+     8 (sum_i z_i R_i + sum_i (z_i h_i) A_i - (sum_i z_i s_i) G) = 0
+
+   for random 128-bit z_i. With the cofactor multiplication, points
+   of small order in R_i or A_i are ignored, so a batch can be
+   accepted even though _eddsa_verify rejects some of its signatures.
+   Signatures like that can be created only by the owner of the
+   private key. For consistent results, ed25519_sha512_verify_batch
+   uses this function with n = 1 and z = 1 to check single
+   signatures. The multi-scalar multiplication uses Pippenger's
+   bucket method, with all points in affine coordinates. */
+
+#define EDDSA_BATCH_Z_SIZE 16
+#define EDDSA_BATCH_MAX_BITS 8
+
+/* Window size for n points. */
+static unsigned
+bucket_bits (size_t n)
+{
+  unsigned c;
+  for (c = 1; c < EDDSA_BATCH_MAX_BITS && (n >> (c + 3)) > 0; c++)
+    ;
+  return c;
+}
+
+mp_size_t
+_eddsa_verify_batch_itch (const struct ecc_curve *ecc, size_t n)
+{
+  /* Storage for points and scalars, the result, some scalars, and
+     the key indices, followed by scratch for the hash digest,
+     _eddsa_decompress, or mul_multi. */
+  mp_size_t size = ecc->p.size;
+  mp_size_t itch = _eddsa_decompress_itch (ecc);
+  mp_size_t mul_itch = (3 << bucket_bits (2*n + 1)) * size + 3*size
+    + ECC_ADD_EHH_ITCH (size);
+
+  if (itch < mul_itch)
+    itch = mul_itch;
+
+  return 3*(2*n + 1)*size + 9*size + n + itch;
+}
+
+static int
+zero_p (const mp_limb_t *xp, mp_size_t n)
+{
+  while (n > 0)
+    if (xp[--n] > 0)
+      return 0;
+  return 1;
+}
+
+static void
+mod_canonical (const struct ecc_modulo *m, mp_limb_t *rp)
+{
+  while (mpn_cmp (rp, m->m, m->size) >= 0)
+    mpn_sub_n (rp, rp, m->m, m->size);
+}
+
+/* Checks if a = b (mod p). Needs 2*ecc->p.size limbs of scratch. */
+static int
+equal_p (const struct ecc_curve *ecc, const mp_limb_t *a,
+	 const mp_limb_t *b, mp_limb_t *scratch)
+{
+  ecc_modp_sub (ecc, scratch, a, b);
+  mpn_zero (scratch + ecc->p.size, ecc->p.size);
+  ecc->p.mod (&ecc->p, scratch);
+  mod_canonical (&ecc->p, scratch);
+  return zero_p (scratch, ecc->p.size);
+}
+
+static unsigned
+get_bits (const mp_limb_t *np, mp_size_t size,
+	  unsigned bit_index, unsigned c)
+{
+  mp_size_t limb_index = bit_index / GMP_NUMB_BITS;
+  unsigned shift = bit_index % GMP_NUMB_BITS;
+  mp_limb_t bits;
+
+  if (limb_index >= size)
+    return 0;
+  bits = np[limb_index] >> shift;
+  if (shift + c > GMP_NUMB_BITS && limb_index + 1 < size)
+    bits |= np[limb_index + 1] << (GMP_NUMB_BITS - shift);
+
+  return bits & ((1U << c) - 1);
+}
+
+/* Computes r = sum_i n_i P_i, for affine points P_i and scalars n_i
+   of at most bit_size bits, in homogeneous coordinates. */
+static void
+mul_multi (const struct ecc_curve *ecc, mp_limb_t *r,
+	   size_t n, const mp_limb_t *points, const mp_limb_t *scalars,
+	   unsigned bit_size, mp_limb_t *scratch)
+{
+  unsigned c = bucket_bits (n);
+  unsigned buckets = (1U << c) - 1;
+  unsigned windows = (bit_size + c - 1) / c;
+  mp_size_t size = ecc->p.size;
+  char used[1 << EDDSA_BATCH_MAX_BITS];
+  unsigned w, b;
+  size_t i;
+
+#define bucket(b) (scratch + 3*size*(b))
+#define sum (scratch + 3*size*buckets)
+#define acc (sum + 3*size)
+#define scratch_out (acc + 3*size)
+
+  /* x = 0, y = 1, z = 1 */
+  mpn_zero (r, 3*size);
+  r[size] = r[2*size] = 1;
+
+  for (w = windows; w-- > 0; )
+    {
+      int sum_used, acc_used;
+
+      if (w + 1 < windows)
+	for (b = 0; b < c; b++)
+	  ecc_dup_eh (ecc, r, r, scratch_out);
+
+      memset (used, 0, buckets);
+      for (i = 0; i < n; i++)
+	{
+	  const mp_limb_t *p = points + 2*size*i;
+	  unsigned bits = get_bits (scalars + size*i, size, w*c, c);
+	  if (!bits)
+	    continue;
+	  if (used[bits-1])
+	    ecc_add_eh (ecc, bucket(bits-1), bucket(bits-1), p, scratch_out);
+	  else
+	    {
+	      mpn_copyi (bucket(bits-1), p, 2*size);
+	      mpn_copyi (bucket(bits-1) + 2*size, ecc->unit, size);
+	      used[bits-1] = 1;
+	    }
+	}
+
+      /* acc = sum_b b * bucket(b-1) */
+      for (b = buckets, sum_used = acc_used = 0; b-- > 0; )
+	{
+	  if (used[b])
+	    {
+	      if (sum_used)
+		ecc_add_ehh (ecc, sum, sum, bucket(b), scratch_out);
+	      else
+		mpn_copyi (sum, bucket(b), 3*size);
+	      sum_used = 1;
+	    }
+	  if (sum_used)
+	    {
+	      if (acc_used)
+		ecc_add_ehh (ecc, acc, acc, sum, scratch_out);
+	      else
+		mpn_copyi (acc, sum, 3*size);
+	      acc_used = 1;
+	    }
+	}
+      if (acc_used)
+	ecc_add_ehh (ecc, r, r, acc, scratch_out);
+    }
+#undef bucket
+#undef sum
+#undef acc
+#undef scratch_out
+}
+
+int
+_eddsa_verify_batch (const struct ecc_curve *ecc,
+		     const struct nettle_hash *H,
+		     void *ctx,
+		     size_t n,
+		     const uint8_t * const *pub,
+		     const size_t *length,
+		     const uint8_t * const *msg,
+		     const uint8_t * const *signature,
+		     void *random_ctx, nettle_random_func *random,
+		     mp_limb_t *scratch)
+{
+  mp_size_t size = ecc->p.size;
+  size_t nbytes;
+  size_t i, j, k;
+  uint8_t zb[EDDSA_BATCH_Z_SIZE];
+
+  /* Points are R_i, followed by G and then the distinct A_j. */
+#define points scratch
+#define scalars (points + 2*size*(2*n + 1))
+#define r (scalars + size*(2*n + 1))
+#define sp (r + 3*size)
+#define hp (sp + size)
+#define zp (hp + 2*size)
+#define tp (zp + size)
+#define keys (tp + 2*size)
+#define scratch_out (keys + n)
+#define hash ((uint8_t *) scratch_out)
+#define R(i) (points + 2*size*(i))
+#define A(j) (points + 2*size*(n + 1 + (j)))
+#define Rs(i) (scalars + size*(i))
+#define As(j) (scalars + size*(n + 1 + (j)))
+#define Gs (scalars + size*n)
+
+  nbytes = 1 + ecc->p.bit_size / 8;
+
+  mpn_copyi (R(n), ecc->g, 2*size);
+  mpn_zero (Gs, size);
+
+  for (i = k = 0; i < n; i++)
+    {
+      if (!_eddsa_decompress (ecc, R(i), signature[i], scratch_out))
+	return 0;
+
+      mpn_set_base256_le (sp, ecc->q.size, signature[i] + nbytes, nbytes);
+      /* Check that s < q */
+      if (mpn_cmp (sp, ecc->q.m, ecc->q.size) >= 0)
+	return 0;
+
+      /* Only distinct public keys get a point of their own. */
+      for (j = 0; j < k; j++)
+	if (memcmp (pub[i], pub[keys[j]], nbytes) == 0)
+	  break;
+      if (j == k)
+	{
+	  if (!_eddsa_decompress (ecc, A(k), pub[i], scratch_out))
+	    return 0;
+	  mpn_zero (As(k), size);
+	  keys[k++] = i;
+	}
+
+      H->init (ctx);
+      H->update (ctx, nbytes, signature[i]);
+      H->update (ctx, nbytes, pub[i]);
+      H->update (ctx, length[i], msg[i]);
+      H->digest (ctx, 2*nbytes, hash);
+      _eddsa_hash (&ecc->q, hp, hash);
+
+      random (random_ctx, sizeof (zb), zb);
+      mpn_set_base256_le (zp, size, zb, sizeof (zb));
+      mpn_copyi (Rs(i), zp, size);
+
+      /* A_j coefficient += z h */
+      ecc_mod_mul (&ecc->q, tp, zp, hp);
+      mod_canonical (&ecc->q, tp);
+      ecc_mod_add (&ecc->q, As(j), As(j), tp);
+      mod_canonical (&ecc->q, As(j));
+
+      /* G coefficient -= z s */
+      ecc_mod_mul (&ecc->q, tp, zp, sp);
+      mod_canonical (&ecc->q, tp);
+      ecc_mod_add (&ecc->q, Gs, Gs, tp);
+      mod_canonical (&ecc->q, Gs);
+    }
+  if (!zero_p (Gs, size))
+    mpn_sub_n (Gs, ecc->q.m, Gs, size);
+
+  mul_multi (ecc, r, n + 1 + k, points, scalars, ecc->q.bit_size,
+	     scratch_out);
+  ecc_dup_eh (ecc, r, r, scratch_out);
+  ecc_dup_eh (ecc, r, r, scratch_out);
+  ecc_dup_eh (ecc, r, r, scratch_out);
+
+  /* The neutral element is (0, 1), so check that x = 0, y = z. */
+  mpn_zero (tp, size);
+  return (equal_p (ecc, r, tp, scratch_out)
+	  && equal_p (ecc, r + size, r + 2*size, scratch_out));
+
+#undef points
+#undef scalars
+#undef r
+#undef sp
+#undef hp
+#undef zp
+#undef tp
+#undef keys
+#undef scratch_out
+#undef hash
+#undef R
+#undef A
+#undef Rs
+#undef As
+#undef Gs
+}
@@ -69,7 +69,7 @@ equal_h (const struct ecc_modulo *p,
 mp_size_t
 _eddsa_verify_itch (const struct ecc_curve *ecc)
 {
-  return 8*ecc->p.size + ecc->mul_itch;
+  return 11*ecc->p.size + ECC_MUL_ADD_GA_EH_ITCH (ecc->p.size);
 }
 
 int
@@ -89,7 +89,7 @@ _eddsa_verify (const struct ecc_curve *ecc,
 #define hp (scratch + 3*ecc->p.size)
 #define P (scratch + 5*ecc->p.size)
 #define scratch_out (scratch + 8*ecc->p.size)
-#define S R
+#define S scratch_out
 #define hash ((uint8_t *) P)
 
   nbytes = 1 + ecc->p.bit_size / 8;
@@ -111,19 +111,18 @@ _eddsa_verify (const struct ecc_curve *ecc,
   H->digest (ctx, 2*nbytes, hash);
   _eddsa_hash (&ecc->q, hp, hash);
 
-  /* Compute h A + R - s G, which should be the neutral point */
-  ecc->mul (ecc, P, hp, A, scratch_out);
-  ecc_add_eh (ecc, P, P, R, scratch_out);
-  /* Move out of the way. */
-  mpn_copyi (hp, sp, ecc->q.size);
-  ecc->mul_g (ecc, S, hp, scratch_out);
+  /* Compute s G - h A, using variable time arithmetic since all
+     inputs are public, and compare to R. */
+  ecc_modp_sub (ecc, P, ecc->p.m, A);
+  mpn_copyi (P + ecc->p.size, A + ecc->p.size, ecc->p.size);
+  ecc_mul_add_ga_eh (ecc, S, sp, hp, P, S + 3*ecc->p.size);
 
   return equal_h (&ecc->p,
-		   P, P + 2*ecc->p.size,
-		   S, S + 2*ecc->p.size, scratch_out)
+		   R, ecc->unit,
+		   S, S + 2*ecc->p.size, S + 3*ecc->p.size)
     && equal_h (&ecc->p,
-		P + ecc->p.size, P + 2*ecc->p.size,
-		S + ecc->p.size, S + 2*ecc->p.size, scratch_out);
+		R + ecc->p.size, ecc->unit,
+		S + ecc->p.size, S + 2*ecc->p.size, S + 3*ecc->p.size);
 
 #undef R
 #undef sp
@@ -45,6 +45,7 @@ extern "C" {
 #define ed25519_sha512_public_key nettle_ed25519_sha512_public_key
 #define ed25519_sha512_sign nettle_ed25519_sha512_sign
 #define ed25519_sha512_verify nettle_ed25519_sha512_verify
+#define ed25519_sha512_verify_batch nettle_ed25519_sha512_verify_batch
 
 #define _eddsa_compress _nettle_eddsa_compress
 #define _eddsa_compress_itch _nettle_eddsa_compress_itch
@@ -56,6 +57,8 @@ extern "C" {
 #define _eddsa_sign_itch _nettle_eddsa_sign_itch
 #define _eddsa_verify _nettle_eddsa_verify
 #define _eddsa_verify_itch _nettle_eddsa_verify_itch
+#define _eddsa_verify_batch _nettle_eddsa_verify_batch
+#define _eddsa_verify_batch_itch _nettle_eddsa_verify_batch_itch
 #define _eddsa_public_key_itch _nettle_eddsa_public_key_itch
 #define _eddsa_public_key _nettle_eddsa_public_key
 
@@ -76,6 +79,26 @@ ed25519_sha512_verify (const uint8_t *pub,
 		       size_t length, const uint8_t *msg,
 		       const uint8_t *signature);
 
+/* Verifies n signatures at once, using a random linear combination.
+   Returns 1 if all are valid. If valid is non-NULL, valid[i] is set
+   to the result for signature i. The random function must be
+   unpredictable for whoever created the signatures.
+
+   Unlike ed25519_sha512_verify, this function uses the cofactored
+   verification equation, 8 s G = 8 R + 8 h A, also for the per
+   signature results. Hence it accepts some signatures with
+   small-order components in R or A, which ed25519_sha512_verify
+   rejects. Such signatures can be created only by the owner of the
+   private key. */
+int
+ed25519_sha512_verify_batch (size_t n,
+			     const uint8_t * const *pub,
+			     const size_t *length,
+			     const uint8_t * const *msg,
+			     const uint8_t * const *signature,
+			     void *random_ctx, nettle_random_func *random,
+			     int *valid);
+
 /* Low-level internal functions */
 
 struct ecc_curve;
@@ -126,6 +149,21 @@ _eddsa_verify (const struct ecc_curve *ecc,
 	       const uint8_t *signature,
 	       mp_limb_t *scratch);
 
+mp_size_t
+_eddsa_verify_batch_itch (const struct ecc_curve *ecc, size_t n);
+
+int
+_eddsa_verify_batch (const struct ecc_curve *ecc,
+		     const struct nettle_hash *H,
+		     void *ctx,
+		     size_t n,
+		     const uint8_t * const *pub,
+		     const size_t *length,
+		     const uint8_t * const *msg,
+		     const uint8_t * const *signature,
+		     void *random_ctx, nettle_random_func *random,
+		     mp_limb_t *scratch);
+
 void
 _eddsa_expand_key (const struct ecc_curve *ecc,
 		   const struct nettle_hash *H,
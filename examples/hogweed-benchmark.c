@@ -48,6 +48,7 @@
 #include "dsa.h"
 #include "rsa.h"
 #include "curve25519.h"
+#include "eddsa.h"
 
 #include "nettle-meta.h"
 #include "sexp.h"
@@ -165,7 +166,17 @@ struct rsa_ctx
 {
   struct rsa_public_key pub;
   struct rsa_private_key key;
+  struct rsa_blinding_ctx blinding;
+  struct rsa_prepared_private_key prep;
+  struct rsa_prepared_blinding_ctx prep_blinding;
+  struct rsa_prepared_public_key prep_pub;
+  struct knuth_lfib_ctx lfib;
+  mp_limb_t *scratch;
+  mp_limb_t *verify_scratch;
   uint8_t *digest;
+  uint8_t *signature;
+  /* The signature s, as an octet string */
+  uint8_t *s_octets;
   mpz_t s;
 };
 
@@ -241,7 +252,22 @@ bench_rsa_init (unsigned size)
   ctx->digest = hash_string (&nettle_sha256, "foo");
 
   rsa_sha256_sign_digest (&ctx->key, ctx->digest, ctx->s);
-  
+
+  knuth_lfib_init (&ctx->lfib, 1);
+  rsa_blinding_init (&ctx->blinding);
+  rsa_prepared_blinding_init (&ctx->prep_blinding);
+  if (!rsa_prepared_private_key_init (&ctx->prep, &ctx->pub, &ctx->key))
+    die ("Internal error, rsa_prepared_private_key_init failed.\n");
+  ctx->scratch = xalloc (rsa_prepared_itch (&ctx->prep) * sizeof (mp_limb_t));
+  ctx->signature = xalloc (ctx->key.size);
+
+  if (!rsa_prepared_public_key_init (&ctx->prep_pub, &ctx->pub))
+    die ("Internal error, rsa_prepared_public_key_init failed.\n");
+  ctx->verify_scratch
+    = xalloc (rsa_prepared_public_itch (&ctx->prep_pub) * sizeof (mp_limb_t));
+  ctx->s_octets = xalloc (ctx->pub.size);
+  nettle_mpz_get_str_256 (ctx->pub.size, ctx->s_octets, ctx->s);
+
   return ctx;
 }
 
@@ -256,6 +282,59 @@ bench_rsa_sign (void *p)
   mpz_clear (s);
 }
 
+static void
+bench_rsa_tr_sign (void *p)
+{
+  struct rsa_ctx *ctx = p;
+
+  mpz_t s;
+  mpz_init (s);
+  rsa_sha256_sign_digest_tr (&ctx->pub, &ctx->key,
+			     &ctx->lfib, (nettle_random_func *) knuth_lfib_random,
+			     ctx->digest, s);
+  mpz_clear (s);
+}
+
+static void
+bench_rsa_blinding_sign (void *p)
+{
+  struct rsa_ctx *ctx = p;
+
+  mpz_t s;
+  mpz_init (s);
+  rsa_sha256_sign_digest_blinding_tr (&ctx->pub, &ctx->key, &ctx->blinding,
+				      &ctx->lfib,
+				      (nettle_random_func *) knuth_lfib_random,
+				      ctx->digest, s);
+  mpz_clear (s);
+}
+
+static void
+bench_rsa_prepared_sign (void *p)
+{
+  struct rsa_ctx *ctx = p;
+
+  if (!rsa_prepared_sha256_sign_digest_tr (&ctx->prep, NULL,
+					   &ctx->lfib,
+					   (nettle_random_func *) knuth_lfib_random,
+					   ctx->digest, ctx->signature,
+					   ctx->scratch))
+    die ("Internal error, rsa_prepared_sha256_sign_digest_tr failed.\n");
+}
+
+static void
+bench_rsa_prepared_blinding_sign (void *p)
+{
+  struct rsa_ctx *ctx = p;
+
+  if (!rsa_prepared_sha256_sign_digest_tr (&ctx->prep, &ctx->prep_blinding,
+					   &ctx->lfib,
+					   (nettle_random_func *) knuth_lfib_random,
+					   ctx->digest, ctx->signature,
+					   ctx->scratch))
+    die ("Internal error, rsa_prepared_sha256_sign_digest_tr failed.\n");
+}
+
 static void
 bench_rsa_verify (void *p)
 {
@@ -264,6 +343,15 @@ bench_rsa_verify (void *p)
     die ("Internal error, rsa_sha256_verify_digest failed.\n");
 }
 
+static void
+bench_rsa_prepared_verify (void *p)
+{
+  struct rsa_ctx *ctx = p;
+  if (! rsa_prepared_sha256_verify_digest (&ctx->prep_pub, ctx->digest,
+					   ctx->s_octets, ctx->verify_scratch))
+    die ("Internal error, rsa_prepared_sha256_verify_digest failed.\n");
+}
+
 static void
 bench_rsa_clear (void *p)
 {
@@ -271,12 +359,60 @@ bench_rsa_clear (void *p)
 
   rsa_public_key_clear (&ctx->pub);
   rsa_private_key_clear (&ctx->key);
+  rsa_blinding_clear (&ctx->blinding);
   mpz_clear (ctx->s);
-  
+
+  free (ctx->scratch);
+  free (ctx->verify_scratch);
+  free (ctx->signature);
+  free (ctx->s_octets);
   free (ctx->digest);
   free (ctx);
 }
 
+#define RSA_BATCH_SIZE 64
+
+struct rsa_batch_ctx
+{
+  struct rsa_ctx *key;
+  const uint8_t *digest[RSA_BATCH_SIZE];
+  const uint8_t *signature[RSA_BATCH_SIZE];
+};
+
+static void
+bench_rsa_verify_batch (void *p)
+{
+  struct rsa_batch_ctx *ctx = p;
+  if (!rsa_prepared_sha256_verify_digest_batch (&ctx->key->prep_pub,
+						RSA_BATCH_SIZE,
+						ctx->digest, ctx->signature,
+						NULL, ctx->key->verify_scratch))
+    die ("Internal error, rsa_prepared_sha256_verify_digest_batch failed.\n");
+}
+
+/* Verifies a batch of copies of the same signature, and reports the
+   rate per signature. */
+static void
+bench_rsa_batch (unsigned size)
+{
+  struct rsa_batch_ctx ctx;
+  double verify;
+  unsigned i;
+
+  ctx.key = bench_rsa_init (size);
+  for (i = 0; i < RSA_BATCH_SIZE; i++)
+    {
+      ctx.digest[i] = ctx.key->digest;
+      ctx.signature[i] = ctx.key->s_octets;
+    }
+  verify = time_function (bench_rsa_verify_batch, &ctx) / RSA_BATCH_SIZE;
+
+  printf("%15s %4d %9s %9.4f\n",
+	 "rsa (batch)", size, "", 1e-3/verify);
+
+  bench_rsa_clear (ctx.key);
+}
+
 struct dsa_ctx
 {
   struct dsa_params params;
@@ -507,6 +643,150 @@ bench_ecdsa_clear (void *p)
   free (ctx);
 }
 
+#define ECDSA_BATCH_SIZE 64
+
+struct ecdsa_batch_ctx
+{
+  struct ecdsa_ctx *key;
+  struct ecc_point pub[ECDSA_BATCH_SIZE];
+  struct dsa_signature s[ECDSA_BATCH_SIZE];
+  const uint8_t *digest[ECDSA_BATCH_SIZE];
+  size_t length[ECDSA_BATCH_SIZE];
+};
+
+static void
+bench_ecdsa_verify_batch (void *p)
+{
+  struct ecdsa_batch_ctx *ctx = p;
+  if (!ecdsa_verify_batch (ECDSA_BATCH_SIZE, ctx->pub, ctx->length,
+			   ctx->digest, ctx->s, NULL))
+    die ("Internal error, ecdsa_verify_batch failed.\n");
+}
+
+/* Verifies a batch of copies of the same signature, and reports the
+   rate per signature. */
+static void
+bench_ecdsa_batch (unsigned size)
+{
+  struct ecdsa_batch_ctx ctx;
+  double verify;
+  unsigned i;
+
+  ctx.key = bench_ecdsa_init (size);
+  for (i = 0; i < ECDSA_BATCH_SIZE; i++)
+    {
+      ctx.pub[i] = ctx.key->pub;
+      ctx.s[i] = ctx.key->s;
+      ctx.digest[i] = ctx.key->digest;
+      ctx.length[i] = ctx.key->digest_size;
+    }
+  verify = time_function (bench_ecdsa_verify_batch, &ctx) / ECDSA_BATCH_SIZE;
+
+  printf("%15s %4d %9s %9.4f\n",
+	 "ecdsa (batch)", size, "", 1e-3/verify);
+
+  bench_ecdsa_clear (ctx.key);
+}
+
+struct eddsa_ctx
+{
+  uint8_t priv[ED25519_KEY_SIZE];
+  uint8_t pub[ED25519_KEY_SIZE];
+  uint8_t signature[ED25519_SIGNATURE_SIZE];
+};
+
+static void *
+bench_eddsa_init (unsigned size)
+{
+  struct eddsa_ctx *ctx;
+  struct knuth_lfib_ctx lfib;
+
+  assert (size == 255);
+
+  ctx = xalloc (sizeof(*ctx));
+
+  knuth_lfib_init (&lfib, 3);
+  knuth_lfib_random (&lfib, sizeof(ctx->priv), ctx->priv);
+  ed25519_sha512_public_key (ctx->pub, ctx->priv);
+  ed25519_sha512_sign (ctx->pub, ctx->priv, 3, (const uint8_t *) "abc",
+		       ctx->signature);
+
+  return ctx;
+}
+
+static void
+bench_eddsa_sign (void *p)
+{
+  struct eddsa_ctx *ctx = p;
+  uint8_t signature[ED25519_SIGNATURE_SIZE];
+  ed25519_sha512_sign (ctx->pub, ctx->priv, 3, (const uint8_t *) "abc",
+		       signature);
+}
+
+static void
+bench_eddsa_verify (void *p)
+{
+  struct eddsa_ctx *ctx = p;
+  if (!ed25519_sha512_verify (ctx->pub, 3, (const uint8_t *) "abc",
+			      ctx->signature))
+    die ("Internal error, ed25519_sha512_verify failed.\n");
+}
+
+static void
+bench_eddsa_clear (void *p)
+{
+  free (p);
+}
+
+#define EDDSA_BATCH_SIZE 128
+
+struct eddsa_batch_ctx
+{
+  struct eddsa_ctx *key;
+  struct knuth_lfib_ctx lfib;
+  const uint8_t *pub[EDDSA_BATCH_SIZE];
+  const uint8_t *msg[EDDSA_BATCH_SIZE];
+  const uint8_t *signature[EDDSA_BATCH_SIZE];
+  size_t length[EDDSA_BATCH_SIZE];
+};
+
+static void
+bench_eddsa_verify_batch (void *p)
+{
+  struct eddsa_batch_ctx *ctx = p;
+  if (!ed25519_sha512_verify_batch (EDDSA_BATCH_SIZE, ctx->pub, ctx->length,
+				    ctx->msg, ctx->signature, &ctx->lfib,
+				    (nettle_random_func *) knuth_lfib_random,
+				    NULL))
+    die ("Internal error, ed25519_sha512_verify_batch failed.\n");
+}
+
+/* Verifies a batch of signatures, all with the same key and message,
+   and reports the rate per signature. */
+static void
+bench_eddsa_batch (void)
+{
+  struct eddsa_batch_ctx ctx;
+  double verify;
+  unsigned i;
+
+  ctx.key = bench_eddsa_init (255);
+  knuth_lfib_init (&ctx.lfib, 4);
+  for (i = 0; i < EDDSA_BATCH_SIZE; i++)
+    {
+      ctx.pub[i] = ctx.key->pub;
+      ctx.msg[i] = (const uint8_t *) "abc";
+      ctx.length[i] = 3;
+      ctx.signature[i] = ctx.key->signature;
+    }
+  verify = time_function (bench_eddsa_verify_batch, &ctx) / EDDSA_BATCH_SIZE;
+
+  printf("%15s %4d %9s %9.4f\n",
+	 "eddsa (batch)", 255, "", 1e-3/verify);
+
+  bench_eddsa_clear (ctx.key);
+}
+
 #if WITH_OPENSSL
 struct openssl_rsa_ctx
 {
@@ -693,6 +973,10 @@ bench_curve25519 (void)
 struct alg alg_list[] = {
   { "rsa",   1024, bench_rsa_init,   bench_rsa_sign,   bench_rsa_verify,   bench_rsa_clear },
   { "rsa",   2048, bench_rsa_init,   bench_rsa_sign,   bench_rsa_verify,   bench_rsa_clear },
+  { "rsa (tr)", 2048, bench_rsa_init, bench_rsa_tr_sign, bench_rsa_verify, bench_rsa_clear },
+  { "rsa (blinding)", 2048, bench_rsa_init, bench_rsa_blinding_sign, bench_rsa_verify, bench_rsa_clear },
+  { "rsa (prepared)", 2048, bench_rsa_init, bench_rsa_prepared_sign, bench_rsa_prepared_verify, bench_rsa_clear },
+  { "rsa (prep+bl)", 2048, bench_rsa_init, bench_rsa_prepared_blinding_sign, bench_rsa_prepared_verify, bench_rsa_clear },
 #if WITH_OPENSSL
   { "rsa (openssl)",  1024, bench_openssl_rsa_init, bench_openssl_rsa_sign, bench_openssl_rsa_verify, bench_openssl_rsa_clear },
   { "rsa (openssl)",  2048, bench_openssl_rsa_init, bench_openssl_rsa_sign, bench_openssl_rsa_verify, bench_openssl_rsa_clear },
@@ -706,6 +990,7 @@ struct alg alg_list[] = {
   { "ecdsa",  256, bench_ecdsa_init, bench_ecdsa_sign, bench_ecdsa_verify, bench_ecdsa_clear },
   { "ecdsa",  384, bench_ecdsa_init, bench_ecdsa_sign, bench_ecdsa_verify, bench_ecdsa_clear },
   { "ecdsa",  521, bench_ecdsa_init, bench_ecdsa_sign, bench_ecdsa_verify, bench_ecdsa_clear },
+  { "eddsa",  255, bench_eddsa_init, bench_eddsa_sign, bench_eddsa_verify, bench_eddsa_clear },
 #if WITH_OPENSSL
   { "ecdsa (openssl)",  192, bench_openssl_ecdsa_init, bench_openssl_ecdsa_sign, bench_openssl_ecdsa_verify, bench_openssl_ecdsa_clear },
   { "ecdsa (openssl)",  224, bench_openssl_ecdsa_init, bench_openssl_ecdsa_sign, bench_openssl_ecdsa_verify, bench_openssl_ecdsa_clear },
@@ -734,6 +1019,21 @@ main (int argc, char **argv)
     if (!filter || strstr (alg_list[i].name, filter))
       bench_alg (&alg_list[i]);
 
+  if (!filter || strstr("rsa (batch)", filter))
+    bench_rsa_batch (2048);
+
+  if (!filter || strstr("ecdsa (batch)", filter))
+    {
+      bench_ecdsa_batch (192);
+      bench_ecdsa_batch (224);
+      bench_ecdsa_batch (256);
+      bench_ecdsa_batch (384);
+      bench_ecdsa_batch (521);
+    }
+
+  if (!filter || strstr("eddsa (batch)", filter))
+    bench_eddsa_batch();
+
   if (!filter || strstr("curve25519", filter))
     bench_curve25519();
 
@@ -52,10 +52,12 @@
 #include "blowfish.h"
 #include "cast128.h"
 #include "cbc.h"
+#include "ccm.h"
 #include "ctr.h"
 #include "des.h"
 #include "eax.h"
 #include "gcm.h"
+#include "gcm-siv.h"
 #include "memxor.h"
 #include "salsa20.h"
 #include "serpent.h"
@@ -64,6 +66,7 @@
 #include "sha3.h"
 #include "twofish.h"
 #include "umac.h"
+#include "xts.h"
 #include "poly1305.h"
 
 #include "nettle-meta.h"
@@ -190,6 +193,37 @@ bench_hash(void *arg)
   info->update(info->ctx, BENCH_BLOCK, info->data);
 }
 
+typedef void bench_update_n_func(unsigned n, void **ctx,
+				 size_t length, const uint8_t **data);
+typedef void bench_digest_n_func(unsigned n, void **ctx,
+				 size_t length, uint8_t **digest);
+
+struct bench_hash_n_info
+{
+  unsigned n;
+  size_t length;
+  void **ctx;
+  const uint8_t **data;
+  uint8_t **digest;
+  bench_update_n_func *update_n;
+  bench_digest_n_func *digest_n;
+};
+
+static void
+bench_hash_n_update(void *arg)
+{
+  struct bench_hash_n_info *info = arg;
+  info->update_n(info->n, info->ctx, info->length, info->data);
+}
+
+static void
+bench_hash_n_digest(void *arg)
+{
+  struct bench_hash_n_info *info = arg;
+  info->update_n(info->n, info->ctx, info->length, info->data);
+  info->digest_n(info->n, info->ctx, SHA1_DIGEST_SIZE, info->digest);
+}
+
 struct bench_cipher_info
 {
   void *ctx;
@@ -242,6 +276,53 @@ bench_ctr(void *arg)
 	    BENCH_BLOCK, info->data, info->data);
 }
 
+struct bench_cbc_n_info
+{
+  unsigned n;
+  const struct aes128_ctx **ctx;
+  uint8_t **iv;
+  uint8_t **data;
+};
+
+static void
+bench_cbc_aes128_encrypt_n(void *arg)
+{
+  struct bench_cbc_n_info *info = arg;
+  cbc_aes128_encrypt_n(info->n, info->ctx, info->iv,
+		       BENCH_BLOCK / info->n, info->data,
+		       (const uint8_t **) info->data);
+}
+
+/* XTS, with BENCH_BLOCK split into sectors of this size. */
+#define BENCH_XTS_SECTOR 512
+
+typedef void bench_xts_func(const void *ctx, const uint8_t *tweak,
+			    size_t length, uint8_t *dst,
+			    const uint8_t *src);
+
+struct bench_xts_info
+{
+  void *ctx;
+  bench_xts_func *crypt;
+  uint8_t *data;
+};
+
+static void
+bench_xts(void *arg)
+{
+  struct bench_xts_info *info = arg;
+  uint8_t tweak[XTS_BLOCK_SIZE];
+  size_t i;
+
+  memset(tweak, 0, sizeof(tweak));
+  for (i = 0; i < BENCH_BLOCK; i += BENCH_XTS_SECTOR)
+    {
+      tweak[0] = i / BENCH_XTS_SECTOR;
+      info->crypt(info->ctx, tweak, BENCH_XTS_SECTOR,
+		  info->data + i, info->data + i);
+    }
+}
+
 struct bench_aead_info
 {
   void *ctx;
@@ -264,6 +345,75 @@ bench_aead_update(void *arg)
   info->update (info->ctx, BENCH_BLOCK, info->data);
 }
 
+/* Short messages, each with a new nonce, associated data and digest. */
+#define BENCH_AEAD_MESSAGE 64
+#define BENCH_AEAD_ADATA 16
+
+struct bench_aead_message_info
+{
+  const struct nettle_aead *aead;
+  void *ctx;
+  const uint8_t *nonce;
+  uint8_t *data;
+};
+
+static void
+bench_aead_message(void *arg)
+{
+  const struct bench_aead_message_info *info = arg;
+  const struct nettle_aead *aead = info->aead;
+  uint8_t digest[NETTLE_MAX_HASH_DIGEST_SIZE];
+  size_t i;
+
+  for (i = 0; i < BENCH_BLOCK; i += BENCH_AEAD_MESSAGE)
+    {
+      aead->set_nonce (info->ctx, info->nonce);
+      aead->update (info->ctx, BENCH_AEAD_ADATA, info->data + i);
+      aead->encrypt (info->ctx, BENCH_AEAD_MESSAGE,
+		     info->data + i, info->data + i);
+      aead->digest (info->ctx, aead->digest_size, digest);
+    }
+}
+
+/* GCM-SIV needs the complete message, so each iteration processes a
+   single message of BENCH_BLOCK octets, including the tag. */
+typedef void bench_gcm_siv_encrypt_func(void *ctx, const uint8_t *nonce,
+					size_t alength, const uint8_t *adata,
+					size_t clength,
+					uint8_t *dst, const uint8_t *src);
+
+typedef int bench_gcm_siv_decrypt_func(void *ctx, const uint8_t *nonce,
+				       size_t alength, const uint8_t *adata,
+				       size_t mlength,
+				       uint8_t *dst, const uint8_t *src);
+
+struct bench_gcm_siv_info
+{
+  void *ctx;
+  bench_gcm_siv_encrypt_func *encrypt;
+  bench_gcm_siv_decrypt_func *decrypt;
+  const uint8_t *nonce;
+  uint8_t *data;
+};
+
+static void
+bench_gcm_siv_encrypt(void *arg)
+{
+  struct bench_gcm_siv_info *info = arg;
+  info->encrypt(info->ctx, info->nonce, 0, NULL,
+		BENCH_BLOCK, info->data, info->data);
+}
+
+static void
+bench_gcm_siv_decrypt(void *arg)
+{
+  struct bench_gcm_siv_info *info = arg;
+  /* Only the first call succeeds, but that doesn't matter for the
+     timing. */
+  info->decrypt(info->ctx, info->nonce, 0, NULL,
+		BENCH_BLOCK - GCM_SIV_DIGEST_SIZE, info->data, info->data);
+}
+
 /* Set data[i] = floor(sqrt(i)) */
 static void
 init_data(uint8_t *data)
@@ -393,6 +543,59 @@ time_hash(const struct nettle_hash *hash)
   free(info.ctx);
 }
 
+/* Many independent messages, eight long ones, or short ones as for
+   the leaves of a hash tree. */
+#define BENCH_HASH_N_SHORT 64
+#define BENCH_HASH_N_MAX (BENCH_BLOCK / BENCH_HASH_N_SHORT)
+
+static void
+time_hash_n(const char *name, size_t context_size,
+	    nettle_hash_init_func *init,
+	    bench_update_n_func *update_n, bench_digest_n_func *digest_n)
+{
+  static uint8_t data[BENCH_BLOCK];
+  static uint8_t out[BENCH_HASH_N_MAX * SHA1_DIGEST_SIZE];
+  void *ctx[BENCH_HASH_N_MAX];
+  const uint8_t *dp[BENCH_HASH_N_MAX];
+  uint8_t *digest[BENCH_HASH_N_MAX];
+  struct bench_hash_n_info info;
+  uint8_t *contexts;
+  unsigned i;
+
+  contexts = xalloc(BENCH_HASH_N_MAX * context_size);
+  init_data(data);
+  for (i = 0; i < BENCH_HASH_N_MAX; i++)
+    {
+      ctx[i] = contexts + i * context_size;
+      init(ctx[i]);
+      digest[i] = out + i * SHA1_DIGEST_SIZE;
+    }
+
+  info.ctx = ctx;
+  info.data = dp;
+  info.digest = digest;
+  info.update_n = update_n;
+  info.digest_n = digest_n;
+
+  info.n = 8;
+  info.length = BENCH_BLOCK / 8;
+  for (i = 0; i < info.n; i++)
+    dp[i] = data + i * info.length;
+
+  display(name, "update x8", 64,
+	  time_function(bench_hash_n_update, &info));
+
+  info.n = BENCH_HASH_N_MAX;
+  info.length = BENCH_HASH_N_SHORT;
+  for (i = 0; i < info.n; i++)
+    dp[i] = data + i * info.length;
+
+  display(name, "64 octets", 64,
+	  time_function(bench_hash_n_digest, &info));
+
+  free(contexts);
+}
+
 static void
 time_umac(void)
 {
@@ -455,6 +658,154 @@ time_poly1305_aes(void)
 	  time_function(bench_hash, &info));
 }
 
+/* Independent CBC streams, with different keys. */
+#define BENCH_CBC_N 4
+
+static void
+time_cbc_aes_n(void)
+{
+  static uint8_t data[BENCH_BLOCK];
+  struct aes128_ctx aes[BENCH_CBC_N];
+  const struct aes128_ctx *ctx[BENCH_CBC_N];
+  uint8_t ivs[BENCH_CBC_N][AES_BLOCK_SIZE];
+  uint8_t *iv[BENCH_CBC_N];
+  uint8_t *dp[BENCH_CBC_N];
+  struct bench_cbc_n_info info;
+  uint8_t key[AES128_KEY_SIZE];
+  unsigned i;
+
+  init_data(data);
+  init_key(sizeof(key), key);
+  for (i = 0; i < BENCH_CBC_N; i++)
+    {
+      key[0] = i;
+      aes128_set_encrypt_key(&aes[i], key);
+      ctx[i] = &aes[i];
+      memset(ivs[i], i, AES_BLOCK_SIZE);
+      iv[i] = ivs[i];
+      dp[i] = data + i * (BENCH_BLOCK / BENCH_CBC_N);
+    }
+
+  info.n = BENCH_CBC_N;
+  info.ctx = ctx;
+  info.iv = iv;
+  info.data = dp;
+
+  display("aes128", "CBC encrypt x4", AES_BLOCK_SIZE,
+	  time_function(bench_cbc_aes128_encrypt_n, &info));
+}
+
+static void
+time_xts(void)
+{
+  static uint8_t data[BENCH_BLOCK];
+  struct bench_xts_info info;
+  struct xts_aes128_key ctx128;
+  struct xts_aes256_key ctx256;
+  uint8_t key[XTS_AES256_KEY_SIZE];
+
+  init_data(data);
+  init_key(sizeof(key), key);
+  info.data = data;
+
+  info.ctx = &ctx128;
+  xts_aes128_set_encrypt_key(&ctx128, key);
+  info.crypt = (bench_xts_func *) xts_aes128_encrypt_message;
+  display("xts_aes128", "encrypt", AES_BLOCK_SIZE,
+	  time_function(bench_xts, &info));
+
+  xts_aes128_set_decrypt_key(&ctx128, key);
+  info.crypt = (bench_xts_func *) xts_aes128_decrypt_message;
+  display("xts_aes128", "decrypt", AES_BLOCK_SIZE,
+	  time_function(bench_xts, &info));
+
+  info.ctx = &ctx256;
+  xts_aes256_set_encrypt_key(&ctx256, key);
+  info.crypt = (bench_xts_func *) xts_aes256_encrypt_message;
+  display("xts_aes256", "encrypt", AES_BLOCK_SIZE,
+	  time_function(bench_xts, &info));
+
+  xts_aes256_set_decrypt_key(&ctx256, key);
+  info.crypt = (bench_xts_func *) xts_aes256_decrypt_message;
+  display("xts_aes256", "decrypt", AES_BLOCK_SIZE,
+	  time_function(bench_xts, &info));
+}
+
+static void
+time_ccm(void)
+{
+  static uint8_t data[BENCH_BLOCK];
+  struct bench_aead_info info;
+  struct ccm_aes128_ctx ctx128;
+  struct ccm_aes256_ctx ctx256;
+  uint8_t key[AES256_KEY_SIZE];
+  uint8_t nonce[CCM_MAX_NONCE_SIZE];
+
+  init_data(data);
+  init_key(sizeof(key), key);
+  init_nonce(sizeof(nonce), nonce);
+  info.data = data;
+
+  info.ctx = &ctx128;
+  ccm_aes128_set_key(&ctx128, key);
+  ccm_aes128_set_nonce(&ctx128, 12, nonce,
+		       0, BENCH_BLOCK, CCM_DIGEST_SIZE);
+  info.crypt = (nettle_crypt_func *) ccm_aes128_encrypt;
+  display("ccm_aes128", "encrypt", AES_BLOCK_SIZE,
+	  time_function(bench_aead_crypt, &info));
+
+  info.crypt = (nettle_crypt_func *) ccm_aes128_decrypt;
+  display("ccm_aes128", "decrypt", AES_BLOCK_SIZE,
+	  time_function(bench_aead_crypt, &info));
+
+  info.ctx = &ctx256;
+  ccm_aes256_set_key(&ctx256, key);
+  ccm_aes256_set_nonce(&ctx256, 12, nonce,
+		       0, BENCH_BLOCK, CCM_DIGEST_SIZE);
+  info.crypt = (nettle_crypt_func *) ccm_aes256_encrypt;
+  display("ccm_aes256", "encrypt", AES_BLOCK_SIZE,
+	  time_function(bench_aead_crypt, &info));
+
+  info.crypt = (nettle_crypt_func *) ccm_aes256_decrypt;
+  display("ccm_aes256", "decrypt", AES_BLOCK_SIZE,
+	  time_function(bench_aead_crypt, &info));
+}
+
+static void
+time_gcm_siv(void)
+{
+  static uint8_t data[BENCH_BLOCK];
+  struct bench_gcm_siv_info info;
+  struct gcm_siv_aes128_ctx ctx128;
+  struct gcm_siv_aes256_ctx ctx256;
+  uint8_t key[AES256_KEY_SIZE];
+  uint8_t nonce[GCM_SIV_NONCE_SIZE];
+
+  init_data(data);
+  init_key(sizeof(key), key);
+  init_nonce(sizeof(nonce), nonce);
+  info.data = data;
+  info.nonce = nonce;
+
+  info.ctx = &ctx128;
+  gcm_siv_aes128_set_key(&ctx128, key);
+  info.encrypt = (bench_gcm_siv_encrypt_func *) gcm_siv_aes128_encrypt_message;
+  info.decrypt = (bench_gcm_siv_decrypt_func *) gcm_siv_aes128_decrypt_message;
+  display("gcm_siv_aes128", "encrypt", GCM_SIV_BLOCK_SIZE,
+	  time_function(bench_gcm_siv_encrypt, &info));
+  display("gcm_siv_aes128", "decrypt", GCM_SIV_BLOCK_SIZE,
+	  time_function(bench_gcm_siv_decrypt, &info));
+
+  info.ctx = &ctx256;
+  gcm_siv_aes256_set_key(&ctx256, key);
+  info.encrypt = (bench_gcm_siv_encrypt_func *) gcm_siv_aes256_encrypt_message;
+  info.decrypt = (bench_gcm_siv_decrypt_func *) gcm_siv_aes256_decrypt_message;
+  display("gcm_siv_aes256", "encrypt", GCM_SIV_BLOCK_SIZE,
+	  time_function(bench_gcm_siv_encrypt, &info));
+  display("gcm_siv_aes256", "decrypt", GCM_SIV_BLOCK_SIZE,
+	  time_function(bench_gcm_siv_decrypt, &info));
+}
+
 static int
 prefix_p(const char *prefix, const char *s)
 {
@@ -631,6 +982,20 @@ time_aead(const struct nettle_aead *aead)
       display(aead->name, "update", aead->block_size,
 	      time_function(bench_aead_update, &info));
     }
+
+  if (aead->set_nonce && aead->update)
+    {
+      struct bench_aead_message_info info;
+      info.aead = aead;
+      info.ctx = ctx;
+      info.nonce = nonce;
+      info.data = data;
+
+      aead->set_encrypt_key(ctx, key);
+
+      display(aead->name, "msg 64", aead->block_size,
+	      time_function(bench_aead_message, &info));
+    }
   free(ctx);
   free(key);
   free(nonce);
@@ -818,6 +1183,30 @@ main(int argc, char **argv)
     if (!alg || strstr(hashes[i]->name, alg))
       time_hash(hashes[i]);
 
+  if (!alg || strstr ("sha1", alg))
+    time_hash_n("sha1", sizeof(struct sha1_ctx),
+		(nettle_hash_init_func *) sha1_init,
+		(bench_update_n_func *) sha1_update_n,
+		(bench_digest_n_func *) sha1_digest_n);
+
+  if (!alg || strstr ("sha256", alg))
+    time_hash_n("sha256", sizeof(struct sha256_ctx),
+		(nettle_hash_init_func *) sha256_init,
+		(bench_update_n_func *) sha256_update_n,
+		(bench_digest_n_func *) sha256_digest_n);
+
+  if (!alg || strstr ("sha512", alg))
+    time_hash_n("sha512", sizeof(struct sha512_ctx),
+		(nettle_hash_init_func *) sha512_init,
+		(bench_update_n_func *) sha512_update_n,
+		(bench_digest_n_func *) sha512_digest_n);
+
+  if (!alg || strstr ("sha3_256", alg))
+    time_hash_n("sha3_256", sizeof(struct sha3_256_ctx),
+		(nettle_hash_init_func *) sha3_256_init,
+		(bench_update_n_func *) sha3_256_update_n,
+		(bench_digest_n_func *) sha3_256_digest_n);
+
   if (!alg || strstr ("umac", alg))
     time_umac();
 
@@ -828,6 +1217,18 @@ main(int argc, char **argv)
     if (!alg || strstr(ciphers[i]->name, alg))
       time_cipher(ciphers[i]);
 
+  if (!alg || strstr ("aes128", alg))
+    time_cbc_aes_n();
+
+  if (!alg || strstr ("xts", alg))
+    time_xts();
+
+  if (!alg || strstr ("ccm", alg))
+    time_ccm();
+
+  if (!alg || strstr ("gcm_siv", alg))
+    time_gcm_siv();
+
   for (i = 0; aeads[i]; i++)
     if (!alg || strstr(aeads[i]->name, alg))
       time_aead(aeads[i]);
@@ -159,17 +159,55 @@ typedef void aes_crypt_internal_func (unsigned rounds, const uint32_t *keys,
 				      size_t length, uint8_t *dst,
 				      const uint8_t *src);
 
+typedef void aes_ctr_crypt_func (unsigned rounds, const uint32_t *keys,
+				 uint8_t *ctr, size_t length,
+				 uint8_t *dst, const uint8_t *src);
+
+typedef void aes_cbc_decrypt_func (unsigned rounds, const uint32_t *keys,
+				   uint8_t *iv, size_t length,
+				   uint8_t *dst, const uint8_t *src);
+
+typedef void aes_cbc_encrypt_4_func (unsigned rounds, const uint32_t **keys,
+				     uint8_t **iv, size_t length,
+				     uint8_t **dst, const uint8_t **src);
+
 typedef void *(memxor_func)(void *dst, const void *src, size_t n);
 
+struct gcm_key;
+typedef void gcm_init_key_func (union nettle_block16 *table);
+typedef void gcm_hash_func (const struct gcm_key *key, union nettle_block16 *x,
+			    size_t length, const uint8_t *data);
+typedef size_t gcm_aes_crypt_func (struct gcm_key *key, unsigned rounds,
+				   size_t length, uint8_t *dst,
+				   const uint8_t *src);
+
+struct ccm_ctx;
+typedef size_t ccm_aes_crypt_func (struct ccm_ctx *ctx, unsigned rounds,
+				   const uint32_t *keys, size_t length,
+				   uint8_t *dst, const uint8_t *src);
+
+struct poly1305_ctx;
+typedef void poly1305_blocks_func (struct poly1305_ctx *ctx, size_t blocks,
+				   const uint8_t *m);
+
+typedef void chacha_core_func (uint32_t *dst, const uint32_t *src, unsigned rounds);
+
 typedef void salsa20_core_func (uint32_t *dst, const uint32_t *src, unsigned rounds);
 
 typedef void sha1_compress_func(uint32_t *state, const uint8_t *input);
 typedef void sha256_compress_func(uint32_t *state, const uint8_t *input, const uint32_t *k);
+typedef void sha1_compress_8_func(uint32_t *state, const uint8_t **input,
+				  size_t blocks);
+typedef void sha256_compress_8_func(uint32_t *state, const uint8_t **input,
+				    size_t blocks, const uint32_t *k);
 
 struct sha3_state;
 typedef void sha3_permute_func (struct sha3_state *state);
+typedef void sha3_permute_4_func (uint64_t *state);
 
 typedef void sha512_compress_func (uint64_t *state, const uint8_t *input, const uint64_t *k);
+typedef void sha512_compress_4_func (uint64_t *state, const uint8_t **input,
+				     size_t blocks, const uint64_t *k);
 
 typedef uint64_t umac_nh_func (const uint32_t *key, unsigned length, const uint8_t *msg);
 typedef void umac_nh_n_func (uint64_t *out, unsigned n, const uint32_t *key,
@@ -47,11 +47,15 @@
 #include "fat-setup.h"
 
 void _nettle_cpuid (uint32_t input, uint32_t regs[4]);
+uint32_t _nettle_xgetbv (uint32_t xcr);
 
 struct x86_features
 {
   enum x86_vendor { X86_OTHER, X86_INTEL, X86_AMD } vendor;
   int have_aesni;
+  int have_pclmul;
+  int have_avx2;
+  int have_sha_ni;
 };
 
 #define SKIP(s, slen, literal, llen)				\
@@ -66,6 +70,9 @@ get_x86_features (struct x86_features *features)
   const char *s;
   features->vendor = X86_OTHER;
   features->have_aesni = 0;
+  features->have_pclmul = 0;
+  features->have_avx2 = 0;
+  features->have_sha_ni = 0;
 
   s = secure_getenv (ENV_OVERRIDE);
   if (s)
@@ -84,6 +91,12 @@ get_x86_features (struct x86_features *features)
 	  }
 	else if (MATCH (s, length, "aesni", 5))
 	  features->have_aesni = 1;
+	else if (MATCH (s, length, "pclmul", 6))
+	  features->have_pclmul = 1;
+	else if (MATCH (s, length, "avx2", 4))
+	  features->have_avx2 = 1;
+	else if (MATCH (s, length, "sha_ni", 6))
+	  features->have_sha_ni = 1;
 	if (!sep)
 	  break;
 	s = sep + 1;	
@@ -91,7 +104,10 @@ get_x86_features (struct x86_features *features)
   else
     {
       uint32_t cpuid_data[4];
+      uint32_t max_leaf;
+      int have_ymm = 0;
       _nettle_cpuid (0, cpuid_data);
+      max_leaf = cpuid_data[0];
       if (memcmp (cpuid_data + 1, "Genu" "ntel" "ineI", 12) == 0)
 	features->vendor = X86_INTEL;
       else if (memcmp (cpuid_data + 1, "Auth" "cAMD" "enti", 12) == 0)
@@ -100,6 +116,22 @@ get_x86_features (struct x86_features *features)
       _nettle_cpuid (1, cpuid_data);
       if (cpuid_data[2] & 0x02000000)
 	features->have_aesni = 1;      
+      if (cpuid_data[2] & 0x00000002)
+	features->have_pclmul = 1;
+      /* The ymm registers can be used if the OS has enabled xsave,
+	 and saves the sse and avx state. */
+      if ((cpuid_data[2] & 0x18000000) == 0x18000000
+	  && (_nettle_xgetbv (0) & 6) == 6)
+	have_ymm = 1;
+
+      if (max_leaf >= 7)
+	{
+	  _nettle_cpuid (7, cpuid_data);
+	  if (have_ymm && (cpuid_data[1] & 0x00000020))
+	    features->have_avx2 = 1;
+	  if (cpuid_data[1] & 0x20000000)
+	    features->have_sha_ni = 1;
+	}
     }
 }
 
@@ -111,6 +143,80 @@ DECLARE_FAT_FUNC(_nettle_aes_decrypt, aes_crypt_internal_func)
 DECLARE_FAT_FUNC_VAR(aes_decrypt, aes_crypt_internal_func, x86_64)
 DECLARE_FAT_FUNC_VAR(aes_decrypt, aes_crypt_internal_func, aesni)
 
+DECLARE_FAT_FUNC(_nettle_aes_ctr_crypt, aes_ctr_crypt_func)
+DECLARE_FAT_FUNC_VAR(aes_ctr_crypt, aes_ctr_crypt_func, c)
+DECLARE_FAT_FUNC_VAR(aes_ctr_crypt, aes_ctr_crypt_func, aesni)
+
+DECLARE_FAT_FUNC(_nettle_aes_cbc_decrypt, aes_cbc_decrypt_func)
+DECLARE_FAT_FUNC_VAR(aes_cbc_decrypt, aes_cbc_decrypt_func, c)
+DECLARE_FAT_FUNC_VAR(aes_cbc_decrypt, aes_cbc_decrypt_func, aesni)
+
+DECLARE_FAT_FUNC(_nettle_aes_cbc_encrypt_4, aes_cbc_encrypt_4_func)
+DECLARE_FAT_FUNC_VAR(aes_cbc_encrypt_4, aes_cbc_encrypt_4_func, c)
+DECLARE_FAT_FUNC_VAR(aes_cbc_encrypt_4, aes_cbc_encrypt_4_func, aesni)
+
+/* The table based gcm_hash is the plain x86_64 gcm-hash8.asm. */
+gcm_hash_func _nettle_gcm_hash8;
+
+DECLARE_FAT_FUNC(_nettle_gcm_init_key, gcm_init_key_func)
+DECLARE_FAT_FUNC_VAR(gcm_init_key, gcm_init_key_func, c)
+DECLARE_FAT_FUNC_VAR(gcm_init_key, gcm_init_key_func, pclmul)
+
+DECLARE_FAT_FUNC(_nettle_gcm_hash, gcm_hash_func)
+DECLARE_FAT_FUNC_VAR(gcm_hash, gcm_hash_func, pclmul)
+
+DECLARE_FAT_FUNC(_nettle_chacha_8core, chacha_core_func)
+DECLARE_FAT_FUNC_VAR(chacha_8core, chacha_core_func, c)
+DECLARE_FAT_FUNC_VAR(chacha_8core, chacha_core_func, avx2)
+
+DECLARE_FAT_FUNC(_nettle_poly1305_blocks, poly1305_blocks_func)
+DECLARE_FAT_FUNC_VAR(poly1305_blocks, poly1305_blocks_func, c)
+DECLARE_FAT_FUNC_VAR(poly1305_blocks, poly1305_blocks_func, avx2)
+
+DECLARE_FAT_FUNC(_nettle_gcm_aes_encrypt, gcm_aes_crypt_func)
+DECLARE_FAT_FUNC_VAR(gcm_aes_encrypt, gcm_aes_crypt_func, c)
+DECLARE_FAT_FUNC_VAR(gcm_aes_encrypt, gcm_aes_crypt_func, aesni_pclmul)
+
+DECLARE_FAT_FUNC(_nettle_gcm_aes_decrypt, gcm_aes_crypt_func)
+DECLARE_FAT_FUNC_VAR(gcm_aes_decrypt, gcm_aes_crypt_func, c)
+DECLARE_FAT_FUNC_VAR(gcm_aes_decrypt, gcm_aes_crypt_func, aesni_pclmul)
+
+DECLARE_FAT_FUNC(_nettle_ccm_aes_encrypt, ccm_aes_crypt_func)
+DECLARE_FAT_FUNC_VAR(ccm_aes_encrypt, ccm_aes_crypt_func, c)
+DECLARE_FAT_FUNC_VAR(ccm_aes_encrypt, ccm_aes_crypt_func, aesni)
+
+DECLARE_FAT_FUNC(_nettle_ccm_aes_decrypt, ccm_aes_crypt_func)
+DECLARE_FAT_FUNC_VAR(ccm_aes_decrypt, ccm_aes_crypt_func, c)
+DECLARE_FAT_FUNC_VAR(ccm_aes_decrypt, ccm_aes_crypt_func, aesni)
+
+DECLARE_FAT_FUNC(_nettle_sha1_compress, sha1_compress_func)
+DECLARE_FAT_FUNC_VAR(sha1_compress, sha1_compress_func, x86_64)
+DECLARE_FAT_FUNC_VAR(sha1_compress, sha1_compress_func, sha_ni)
+
+DECLARE_FAT_FUNC(_nettle_sha256_compress, sha256_compress_func)
+DECLARE_FAT_FUNC_VAR(sha256_compress, sha256_compress_func, x86_64)
+DECLARE_FAT_FUNC_VAR(sha256_compress, sha256_compress_func, sha_ni)
+
+DECLARE_FAT_FUNC(_nettle_sha1_compress_8, sha1_compress_8_func)
+DECLARE_FAT_FUNC_VAR(sha1_compress_8, sha1_compress_8_func, c)
+DECLARE_FAT_FUNC_VAR(sha1_compress_8, sha1_compress_8_func, avx2)
+
+DECLARE_FAT_FUNC(_nettle_sha256_compress_8, sha256_compress_8_func)
+DECLARE_FAT_FUNC_VAR(sha256_compress_8, sha256_compress_8_func, c)
+DECLARE_FAT_FUNC_VAR(sha256_compress_8, sha256_compress_8_func, avx2)
+
+DECLARE_FAT_FUNC(_nettle_sha512_compress, sha512_compress_func)
+DECLARE_FAT_FUNC_VAR(sha512_compress, sha512_compress_func, x86_64)
+DECLARE_FAT_FUNC_VAR(sha512_compress, sha512_compress_func, avx2)
+
+DECLARE_FAT_FUNC(_nettle_sha512_compress_4, sha512_compress_4_func)
+DECLARE_FAT_FUNC_VAR(sha512_compress_4, sha512_compress_4_func, c)
+DECLARE_FAT_FUNC_VAR(sha512_compress_4, sha512_compress_4_func, avx2)
+
+DECLARE_FAT_FUNC(_nettle_sha3_permute_4, sha3_permute_4_func)
+DECLARE_FAT_FUNC_VAR(sha3_permute_4, sha3_permute_4_func, c)
+DECLARE_FAT_FUNC_VAR(sha3_permute_4, sha3_permute_4_func, avx2)
+
 DECLARE_FAT_FUNC(nettle_memxor, memxor_func)
 DECLARE_FAT_FUNC_VAR(memxor, memxor_func, x86_64)
 DECLARE_FAT_FUNC_VAR(memxor, memxor_func, sse2)
@@ -135,9 +241,12 @@ fat_init (void)
     {
       const char * const vendor_names[3] =
 	{ "other", "intel", "amd" };
-      fprintf (stderr, "libnettle: cpu features: vendor:%s%s\n",
+      fprintf (stderr, "libnettle: cpu features: vendor:%s%s%s%s%s\n",
 	       vendor_names[features.vendor],
-	       features.have_aesni ? ",aesni" : "");
+	       features.have_aesni ? ",aesni" : "",
+	       features.have_pclmul ? ",pclmul" : "",
+	       features.have_avx2 ? ",avx2" : "",
+	       features.have_sha_ni ? ",sha_ni" : "");
     }
   if (features.have_aesni)
     {
@@ -145,6 +254,11 @@ fat_init (void)
 	fprintf (stderr, "libnettle: using aes instructions.\n");
       _nettle_aes_encrypt_vec = _nettle_aes_encrypt_aesni;
       _nettle_aes_decrypt_vec = _nettle_aes_decrypt_aesni;
+      _nettle_aes_ctr_crypt_vec = _nettle_aes_ctr_crypt_aesni;
+      _nettle_aes_cbc_decrypt_vec = _nettle_aes_cbc_decrypt_aesni;
+      _nettle_aes_cbc_encrypt_4_vec = _nettle_aes_cbc_encrypt_4_aesni;
+      _nettle_ccm_aes_encrypt_vec = _nettle_ccm_aes_encrypt_aesni;
+      _nettle_ccm_aes_decrypt_vec = _nettle_ccm_aes_decrypt_aesni;
     }
   else
     {
@@ -152,6 +266,82 @@ fat_init (void)
 	fprintf (stderr, "libnettle: not using aes instructions.\n");
       _nettle_aes_encrypt_vec = _nettle_aes_encrypt_x86_64;
       _nettle_aes_decrypt_vec = _nettle_aes_decrypt_x86_64;
+      _nettle_aes_ctr_crypt_vec = _nettle_aes_ctr_crypt_c;
+      _nettle_aes_cbc_decrypt_vec = _nettle_aes_cbc_decrypt_c;
+      _nettle_aes_cbc_encrypt_4_vec = _nettle_aes_cbc_encrypt_4_c;
+      _nettle_ccm_aes_encrypt_vec = _nettle_ccm_aes_encrypt_c;
+      _nettle_ccm_aes_decrypt_vec = _nettle_ccm_aes_decrypt_c;
+    }
+
+  if (features.have_pclmul)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using pclmulqdq instructions.\n");
+      _nettle_gcm_init_key_vec = _nettle_gcm_init_key_pclmul;
+      _nettle_gcm_hash_vec = _nettle_gcm_hash_pclmul;
+    }
+  else
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: not using pclmulqdq instructions.\n");
+      _nettle_gcm_init_key_vec = _nettle_gcm_init_key_c;
+      _nettle_gcm_hash_vec = _nettle_gcm_hash8;
+    }
+
+  if (features.have_aesni && features.have_pclmul)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using stitched aes-gcm.\n");
+      _nettle_gcm_aes_encrypt_vec = _nettle_gcm_aes_encrypt_aesni_pclmul;
+      _nettle_gcm_aes_decrypt_vec = _nettle_gcm_aes_decrypt_aesni_pclmul;
+    }
+  else
+    {
+      _nettle_gcm_aes_encrypt_vec = _nettle_gcm_aes_encrypt_c;
+      _nettle_gcm_aes_decrypt_vec = _nettle_gcm_aes_decrypt_c;
+    }
+
+  if (features.have_avx2)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using avx2 instructions.\n");
+      _nettle_chacha_8core_vec = _nettle_chacha_8core_avx2;
+      _nettle_poly1305_blocks_vec = _nettle_poly1305_blocks_avx2;
+      _nettle_sha1_compress_8_vec = _nettle_sha1_compress_8_avx2;
+      _nettle_sha256_compress_8_vec = _nettle_sha256_compress_8_avx2;
+      _nettle_sha512_compress_vec = _nettle_sha512_compress_avx2;
+      _nettle_sha512_compress_4_vec = _nettle_sha512_compress_4_avx2;
+      _nettle_sha3_permute_4_vec = _nettle_sha3_permute_4_avx2;
+    }
+  else
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: not using avx2 instructions.\n");
+      _nettle_chacha_8core_vec = _nettle_chacha_8core_c;
+      _nettle_poly1305_blocks_vec = _nettle_poly1305_blocks_c;
+      _nettle_sha1_compress_8_vec = _nettle_sha1_compress_8_c;
+      _nettle_sha256_compress_8_vec = _nettle_sha256_compress_8_c;
+      _nettle_sha512_compress_vec = _nettle_sha512_compress_x86_64;
+      _nettle_sha512_compress_4_vec = _nettle_sha512_compress_4_c;
+      _nettle_sha3_permute_4_vec = _nettle_sha3_permute_4_c;
+    }
+
+  if (features.have_sha_ni)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using sha instructions.\n");
+      _nettle_sha1_compress_vec = _nettle_sha1_compress_sha_ni;
+      _nettle_sha256_compress_vec = _nettle_sha256_compress_sha_ni;
+      /* One message at a time, the sha instructions are about as fast
+	 as eight avx2 lanes for sha256, but not for sha1. */
+      _nettle_sha256_compress_8_vec = _nettle_sha256_compress_8_c;
+    }
+  else
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: not using sha instructions.\n");
+      _nettle_sha1_compress_vec = _nettle_sha1_compress_x86_64;
+      _nettle_sha256_compress_vec = _nettle_sha256_compress_x86_64;
     }
 
   if (features.vendor == X86_INTEL)
@@ -182,6 +372,92 @@ DEFINE_FAT_FUNC(_nettle_aes_decrypt, void,
 		 const uint8_t *src),
 		(rounds, keys, T, length, dst, src))
 
+DEFINE_FAT_FUNC(_nettle_aes_ctr_crypt, void,
+		(unsigned rounds, const uint32_t *keys,
+		 uint8_t *ctr, size_t length,
+		 uint8_t *dst, const uint8_t *src),
+		(rounds, keys, ctr, length, dst, src))
+
+DEFINE_FAT_FUNC(_nettle_aes_cbc_decrypt, void,
+		(unsigned rounds, const uint32_t *keys,
+		 uint8_t *iv, size_t length,
+		 uint8_t *dst, const uint8_t *src),
+		(rounds, keys, iv, length, dst, src))
+
+DEFINE_FAT_FUNC(_nettle_aes_cbc_encrypt_4, void,
+		(unsigned rounds, const uint32_t **keys,
+		 uint8_t **iv, size_t length,
+		 uint8_t **dst, const uint8_t **src),
+		(rounds, keys, iv, length, dst, src))
+
+DEFINE_FAT_FUNC(_nettle_gcm_init_key, void,
+		(union nettle_block16 *table),
+		(table))
+
+DEFINE_FAT_FUNC(_nettle_gcm_hash, void,
+		(const struct gcm_key *key, union nettle_block16 *x,
+		 size_t length, const uint8_t *data),
+		(key, x, length, data))
+
+DEFINE_FAT_FUNC(_nettle_chacha_8core, void,
+		(uint32_t *dst, const uint32_t *src, unsigned rounds),
+		(dst, src, rounds))
+
+DEFINE_FAT_FUNC(_nettle_poly1305_blocks, void,
+		(struct poly1305_ctx *ctx, size_t blocks, const uint8_t *m),
+		(ctx, blocks, m))
+
+DEFINE_FAT_FUNC(_nettle_gcm_aes_encrypt, size_t,
+		(struct gcm_key *key, unsigned rounds,
+		 size_t length, uint8_t *dst, const uint8_t *src),
+		(key, rounds, length, dst, src))
+
+DEFINE_FAT_FUNC(_nettle_gcm_aes_decrypt, size_t,
+		(struct gcm_key *key, unsigned rounds,
+		 size_t length, uint8_t *dst, const uint8_t *src),
+		(key, rounds, length, dst, src))
+
+DEFINE_FAT_FUNC(_nettle_ccm_aes_encrypt, size_t,
+		(struct ccm_ctx *ctx, unsigned rounds,
+		 const uint32_t *keys, size_t length,
+		 uint8_t *dst, const uint8_t *src),
+		(ctx, rounds, keys, length, dst, src))
+
+DEFINE_FAT_FUNC(_nettle_ccm_aes_decrypt, size_t,
+		(struct ccm_ctx *ctx, unsigned rounds,
+		 const uint32_t *keys, size_t length,
+		 uint8_t *dst, const uint8_t *src),
+		(ctx, rounds, keys, length, dst, src))
+
+DEFINE_FAT_FUNC(_nettle_sha1_compress, void,
+		(uint32_t *state, const uint8_t *input),
+		(state, input))
+
+DEFINE_FAT_FUNC(_nettle_sha256_compress, void,
+		(uint32_t *state, const uint8_t *input, const uint32_t *k),
+		(state, input, k))
+
+DEFINE_FAT_FUNC(_nettle_sha1_compress_8, void,
+		(uint32_t *state, const uint8_t **input, size_t blocks),
+		(state, input, blocks))
+
+DEFINE_FAT_FUNC(_nettle_sha256_compress_8, void,
+		(uint32_t *state, const uint8_t **input,
+		 size_t blocks, const uint32_t *k),
+		(state, input, blocks, k))
+
+DEFINE_FAT_FUNC(_nettle_sha512_compress, void,
+		(uint64_t *state, const uint8_t *input, const uint64_t *k),
+		(state, input, k))
+
+DEFINE_FAT_FUNC(_nettle_sha512_compress_4, void,
+		(uint64_t *state, const uint8_t **input,
+		 size_t blocks, const uint64_t *k),
+		(state, input, blocks, k))
+
+DEFINE_FAT_FUNC(_nettle_sha3_permute_4, void,
+		(uint64_t *state), (state))
+
 DEFINE_FAT_FUNC(nettle_memxor, void *,
 		(void *dst, const void *src, size_t n),
 		(dst, src, n))
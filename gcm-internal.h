@@ -0,0 +1,88 @@
+/* gcm-internal.h
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_GCM_INTERNAL_H_INCLUDED
+#define NETTLE_GCM_INTERNAL_H_INCLUDED
+
+#include "gcm.h"
+
+/* Name mangling */
+#define _gcm_aes_encrypt _nettle_gcm_aes_encrypt
+#define _gcm_aes_decrypt _nettle_gcm_aes_decrypt
+#define _polyval_set_key _nettle_polyval_set_key
+#define _polyval_update _nettle_polyval_update
+
+/* POLYVAL, for gcm-siv, using the GHASH table and hash functions. The
+   state x is byte reversed compared to POLYVAL, and must be reversed
+   to get the result. A final partial block is zero padded. */
+void
+_polyval_set_key (struct gcm_key *key, const uint8_t *h);
+
+void
+_polyval_update (const struct gcm_key *key, union nettle_block16 *x,
+		 size_t length, const uint8_t *data);
+
+/* Combined AES and GCM processing, available only in some
+   configurations. To reduce the number of arguments (at most 6
+   register arguments on x86_64), the key argument is really a pointer
+   to the first member of the appropriate gcm_aes*_ctx struct. Only a
+   prefix of the data may be processed, and the return value is the
+   number of bytes done, always a multiple of the block size. The
+   caller must process the rest of the data the usual way. The
+   assembly implementations get the offsets of the GCM_CTX fields from
+   the GCM structure in asm.m4, which must be kept in sync. */
+#if HAVE_NATIVE_gcm_aes_encrypt
+size_t
+_gcm_aes_encrypt (struct gcm_key *key, unsigned rounds,
+		  size_t length, uint8_t *dst, const uint8_t *src);
+/* For fat builds */
+size_t
+_nettle_gcm_aes_encrypt_c (struct gcm_key *key, unsigned rounds,
+			   size_t length, uint8_t *dst, const uint8_t *src);
+#else
+#undef _gcm_aes_encrypt
+#define _gcm_aes_encrypt(key, rounds, length, dst, src) ((size_t) 0)
+#endif
+
+#if HAVE_NATIVE_gcm_aes_decrypt
+size_t
+_gcm_aes_decrypt (struct gcm_key *key, unsigned rounds,
+		  size_t length, uint8_t *dst, const uint8_t *src);
+/* For fat builds */
+size_t
+_nettle_gcm_aes_decrypt_c (struct gcm_key *key, unsigned rounds,
+			   size_t length, uint8_t *dst, const uint8_t *src);
+#else
+#undef _gcm_aes_decrypt
+#define _gcm_aes_decrypt(key, rounds, length, dst, src) ((size_t) 0)
+#endif
+
+#endif /* NETTLE_GCM_INTERNAL_H_INCLUDED */
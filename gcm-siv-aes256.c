@@ -0,0 +1,118 @@
+/* gcm-siv-aes256.c
+
+   AES-GCM-SIV using AES256 as the underlying cipher.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include "gcm-siv.h"
+
+void
+gcm_siv_aes256_set_key(struct gcm_siv_aes256_ctx *ctx, const uint8_t *key)
+{
+  aes256_set_encrypt_key(&ctx->cipher, key);
+}
+
+void
+gcm_siv_aes256_set_nonce(struct gcm_siv_aes256_ctx *ctx,
+			 const uint8_t *nonce)
+{
+  uint8_t key[AES256_KEY_SIZE];
+
+  gcm_siv_set_nonce(&ctx->siv,
+		    &ctx->cipher, (nettle_cipher_func *) aes256_encrypt,
+		    AES256_KEY_SIZE, key, nonce);
+  aes256_set_encrypt_key(&ctx->enc, key);
+}
+
+void
+gcm_siv_aes256_update(struct gcm_siv_aes256_ctx *ctx,
+		      size_t length, const uint8_t *data)
+{
+  gcm_siv_update(&ctx->siv, length, data);
+}
+
+void
+gcm_siv_aes256_encrypt(struct gcm_siv_aes256_ctx *ctx,
+		       size_t length, uint8_t *dst, const uint8_t *src)
+{
+  gcm_siv_encrypt(&ctx->siv, &ctx->enc, (nettle_cipher_func *) aes256_encrypt,
+		  length, dst, src);
+}
+
+int
+gcm_siv_aes256_decrypt(struct gcm_siv_aes256_ctx *ctx,
+		       const uint8_t *tag,
+		       size_t length, uint8_t *dst, const uint8_t *src)
+{
+  return gcm_siv_decrypt(&ctx->siv,
+			 &ctx->enc, (nettle_cipher_func *) aes256_encrypt,
+			 tag, length, dst, src);
+}
+
+void
+gcm_siv_aes256_digest(struct gcm_siv_aes256_ctx *ctx,
+		      size_t length, uint8_t *digest)
+{
+  gcm_siv_digest(&ctx->siv, length, digest);
+}
+
+void
+gcm_siv_aes256_encrypt_message(struct gcm_siv_aes256_ctx *ctx,
+			       const uint8_t *nonce,
+			       size_t alength, const uint8_t *adata,
+			       size_t clength, uint8_t *dst, const uint8_t *src)
+{
+  size_t mlength;
+
+  assert(clength >= GCM_SIV_DIGEST_SIZE);
+  mlength = clength - GCM_SIV_DIGEST_SIZE;
+
+  gcm_siv_aes256_set_nonce(ctx, nonce);
+  gcm_siv_aes256_update(ctx, alength, adata);
+  gcm_siv_aes256_encrypt(ctx, mlength, dst, src);
+  gcm_siv_aes256_digest(ctx, GCM_SIV_DIGEST_SIZE, dst + mlength);
+}
+
+int
+gcm_siv_aes256_decrypt_message(struct gcm_siv_aes256_ctx *ctx,
+			       const uint8_t *nonce,
+			       size_t alength, const uint8_t *adata,
+			       size_t mlength, uint8_t *dst, const uint8_t *src)
+{
+  gcm_siv_aes256_set_nonce(ctx, nonce);
+  gcm_siv_aes256_update(ctx, alength, adata);
+  return gcm_siv_aes256_decrypt(ctx, src + mlength, mlength, dst, src);
+}
@@ -0,0 +1,212 @@
+/* gcm-siv.c
+
+   AES-GCM-SIV, nonce misuse-resistant authenticated encryption,
+   see RFC 8452.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "gcm-siv.h"
+
+#include "gcm-internal.h"
+#include "macros.h"
+#include "memops.h"
+#include "memxor.h"
+
+#define GCM_SIV_MAX_KEY_SIZE 32
+
+/* Limit on the associated data and on the message, from RFC 8452.
+   For the message, this is 2^32 blocks, so that the 32-bit counter
+   doesn't repeat. */
+#define GCM_SIV_MAX_SIZE ((uint64_t) 1 << 36)
+
+/* Process this many blocks with each call to the cipher function. */
+#define GCM_SIV_BUFFER_BLOCKS 32
+
+/* CTR mode with a 32-bit little-endian counter in the first word of
+   the block, wrapping around without carry into the rest. The
+   initial counter block is the tag, with the most significant bit
+   set. */
+static void
+gcm_siv_ctr_crypt (const void *cipher, nettle_cipher_func *f,
+		   const uint8_t *tag,
+		   size_t length, uint8_t *dst, const uint8_t *src)
+{
+  union nettle_block16 buffer[GCM_SIV_BUFFER_BLOCKS];
+  union nettle_block16 ctr;
+  uint32_t c;
+
+  memcpy (ctr.b, tag, GCM_SIV_BLOCK_SIZE);
+  ctr.b[GCM_SIV_BLOCK_SIZE - 1] |= 0x80;
+  c = LE_READ_UINT32 (ctr.b);
+
+  while (length > 0)
+    {
+      size_t chunk = length;
+      size_t blocks;
+      size_t i;
+
+      if (chunk > sizeof(buffer))
+	chunk = sizeof(buffer);
+
+      blocks = (chunk + GCM_SIV_BLOCK_SIZE - 1) / GCM_SIV_BLOCK_SIZE;
+      for (i = 0; i < blocks; i++, c++)
+	{
+	  buffer[i] = ctr;
+	  LE_WRITE_UINT32 (buffer[i].b, c);
+	}
+      f (cipher, blocks * GCM_SIV_BLOCK_SIZE, buffer[0].b, buffer[0].b);
+      memxor3 (dst, src, buffer[0].b, chunk);
+
+      length -= chunk;
+      dst += chunk;
+      src += chunk;
+    }
+}
+
+/* Completes the POLYVAL with the length block, and computes the tag
+   using the message encryption cipher. */
+static void
+gcm_siv_tag (const struct gcm_siv_ctx *ctx, union nettle_block16 *x,
+	     const void *cipher, nettle_cipher_func *f,
+	     size_t length, uint8_t *tag)
+{
+  uint8_t block[GCM_SIV_BLOCK_SIZE];
+  unsigned i;
+
+  LE_WRITE_UINT64 (block, ctx->auth_size * 8);
+  LE_WRITE_UINT64 (block + 8, (uint64_t) length * 8);
+  _polyval_update (&ctx->key, x, GCM_SIV_BLOCK_SIZE, block);
+
+  for (i = 0; i < GCM_SIV_BLOCK_SIZE; i++)
+    block[i] = x->b[GCM_SIV_BLOCK_SIZE - 1 - i];
+
+  memxor (block, ctx->nonce, GCM_SIV_NONCE_SIZE);
+  block[GCM_SIV_BLOCK_SIZE - 1] &= 0x7f;
+  f (cipher, GCM_SIV_BLOCK_SIZE, tag, block);
+}
+
+void
+gcm_siv_set_nonce (struct gcm_siv_ctx *ctx,
+		   const void *cipher, nettle_cipher_func *f,
+		   size_t key_size, uint8_t *enc_key,
+		   const uint8_t *nonce)
+{
+  /* Each block gives 8 octets of key material. Two for the POLYVAL
+     key, followed by the encryption key. */
+  union nettle_block16 block[2 + GCM_SIV_MAX_KEY_SIZE / 8];
+  uint8_t auth_key[GCM_SIV_BLOCK_SIZE];
+  unsigned n = 2 + key_size / 8;
+  unsigned i;
+
+  assert (key_size % 8 == 0);
+  assert (key_size <= GCM_SIV_MAX_KEY_SIZE);
+
+  for (i = 0; i < sizeof(block) / sizeof(block[0]); i++)
+    {
+      LE_WRITE_UINT32 (block[i].b, i);
+      memcpy (block[i].b + 4, nonce, GCM_SIV_NONCE_SIZE);
+    }
+  f (cipher, n * GCM_SIV_BLOCK_SIZE, block[0].b, block[0].b);
+
+  memcpy (auth_key, block[0].b, 8);
+  memcpy (auth_key + 8, block[1].b, 8);
+  for (i = 2; i < n; i++)
+    memcpy (enc_key + 8 * (i - 2), block[i].b, 8);
+
+  _polyval_set_key (&ctx->key, auth_key);
+
+  memset (ctx->x.b, 0, sizeof(ctx->x));
+  memcpy (ctx->nonce, nonce, GCM_SIV_NONCE_SIZE);
+  ctx->auth_size = 0;
+  ctx->done = 0;
+}
+
+void
+gcm_siv_update (struct gcm_siv_ctx *ctx,
+		size_t length, const uint8_t *data)
+{
+  assert (!ctx->done);
+  assert (ctx->auth_size % GCM_SIV_BLOCK_SIZE == 0);
+  assert (length <= GCM_SIV_MAX_SIZE - ctx->auth_size);
+
+  _polyval_update (&ctx->key, &ctx->x, length, data);
+  ctx->auth_size += length;
+}
+
+void
+gcm_siv_encrypt (struct gcm_siv_ctx *ctx,
+		 const void *cipher, nettle_cipher_func *f,
+		 size_t length, uint8_t *dst, const uint8_t *src)
+{
+  union nettle_block16 x = ctx->x;
+
+  assert (!ctx->done);
+  assert (length <= GCM_SIV_MAX_SIZE);
+  ctx->done = 1;
+
+  _polyval_update (&ctx->key, &x, length, src);
+  gcm_siv_tag (ctx, &x, cipher, f, length, ctx->tag.b);
+  gcm_siv_ctr_crypt (cipher, f, ctx->tag.b, length, dst, src);
+}
+
+int
+gcm_siv_decrypt (struct gcm_siv_ctx *ctx,
+		 const void *cipher, nettle_cipher_func *f,
+		 const uint8_t *tag,
+		 size_t length, uint8_t *dst, const uint8_t *src)
+{
+  union nettle_block16 x = ctx->x;
+
+  assert (!ctx->done);
+  assert (length <= GCM_SIV_MAX_SIZE);
+  ctx->done = 1;
+
+  gcm_siv_ctr_crypt (cipher, f, tag, length, dst, src);
+  _polyval_update (&ctx->key, &x, length, dst);
+  gcm_siv_tag (ctx, &x, cipher, f, length, ctx->tag.b);
+
+  return memeql_sec (ctx->tag.b, tag, GCM_SIV_DIGEST_SIZE);
+}
+
+void
+gcm_siv_digest (const struct gcm_siv_ctx *ctx,
+		size_t length, uint8_t *digest)
+{
+  assert (ctx->done);
+  assert (length <= GCM_SIV_DIGEST_SIZE);
+  memcpy (digest, ctx->tag.b, length);
+}
@@ -0,0 +1,224 @@
+/* gcm-siv.h
+
+   AES-GCM-SIV, nonce misuse-resistant authenticated encryption,
+   see RFC 8452.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_GCM_SIV_H_INCLUDED
+#define NETTLE_GCM_SIV_H_INCLUDED
+
+#include "aes.h"
+#include "gcm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Name mangling */
+#define gcm_siv_set_nonce nettle_gcm_siv_set_nonce
+#define gcm_siv_update nettle_gcm_siv_update
+#define gcm_siv_encrypt nettle_gcm_siv_encrypt
+#define gcm_siv_decrypt nettle_gcm_siv_decrypt
+#define gcm_siv_digest nettle_gcm_siv_digest
+
+#define gcm_siv_aes128_set_key nettle_gcm_siv_aes128_set_key
+#define gcm_siv_aes128_set_nonce nettle_gcm_siv_aes128_set_nonce
+#define gcm_siv_aes128_update nettle_gcm_siv_aes128_update
+#define gcm_siv_aes128_encrypt nettle_gcm_siv_aes128_encrypt
+#define gcm_siv_aes128_decrypt nettle_gcm_siv_aes128_decrypt
+#define gcm_siv_aes128_digest nettle_gcm_siv_aes128_digest
+#define gcm_siv_aes128_encrypt_message nettle_gcm_siv_aes128_encrypt_message
+#define gcm_siv_aes128_decrypt_message nettle_gcm_siv_aes128_decrypt_message
+
+#define gcm_siv_aes256_set_key nettle_gcm_siv_aes256_set_key
+#define gcm_siv_aes256_set_nonce nettle_gcm_siv_aes256_set_nonce
+#define gcm_siv_aes256_update nettle_gcm_siv_aes256_update
+#define gcm_siv_aes256_encrypt nettle_gcm_siv_aes256_encrypt
+#define gcm_siv_aes256_decrypt nettle_gcm_siv_aes256_decrypt
+#define gcm_siv_aes256_digest nettle_gcm_siv_aes256_digest
+#define gcm_siv_aes256_encrypt_message nettle_gcm_siv_aes256_encrypt_message
+#define gcm_siv_aes256_decrypt_message nettle_gcm_siv_aes256_decrypt_message
+
+#define GCM_SIV_BLOCK_SIZE 16
+#define GCM_SIV_DIGEST_SIZE 16
+#define GCM_SIV_NONCE_SIZE 12
+
+/* Per-message state. The POLYVAL key and the encryption key are
+   derived from the key-generating key and the nonce. */
+struct gcm_siv_ctx
+{
+  struct gcm_key key;
+  /* POLYVAL of the associated data, byte reversed */
+  union nettle_block16 x;
+  union nettle_block16 tag;
+  uint8_t nonce[GCM_SIV_NONCE_SIZE];
+  uint64_t auth_size;
+  /* Set when the message has been processed, by gcm_siv_encrypt or
+     gcm_siv_decrypt. */
+  int done;
+};
+
+/* Derives the message keys, using the key-generating cipher. The
+   encryption key, of key_size octets, is written to enc_key, and the
+   caller must install it. */
+void
+gcm_siv_set_nonce (struct gcm_siv_ctx *ctx,
+		   const void *cipher, nettle_cipher_func *f,
+		   size_t key_size, uint8_t *enc_key,
+		   const uint8_t *nonce);
+
+/* Like gcm_update, all calls but the last must use a multiple of the
+   block size. The associated data, as well as the message, is limited
+   to 2^36 octets. */
+void
+gcm_siv_update (struct gcm_siv_ctx *ctx,
+		size_t length, const uint8_t *data);
+
+/* The tag depends on the complete message, which is needed before any
+   output can be produced. Hence these functions must be called exactly
+   once per message, with the complete message, and calling them again
+   without a new gcm_siv_set_nonce is an error. The cipher is the
+   message encryption cipher. */
+void
+gcm_siv_encrypt (struct gcm_siv_ctx *ctx,
+		 const void *cipher, nettle_cipher_func *f,
+		 size_t length, uint8_t *dst, const uint8_t *src);
+
+/* The tag is the expected one, needed as the initial counter.
+   Returns 1 if the message is authentic, 0 otherwise. */
+int
+gcm_siv_decrypt (struct gcm_siv_ctx *ctx,
+		 const void *cipher, nettle_cipher_func *f,
+		 const uint8_t *tag,
+		 size_t length, uint8_t *dst, const uint8_t *src);
+
+/* Must be called after gcm_siv_encrypt. */
+void
+gcm_siv_digest (const struct gcm_siv_ctx *ctx,
+		size_t length, uint8_t *digest);
+
+struct gcm_siv_aes128_ctx
+{
+  /* Key-generating key */
+  struct aes128_ctx cipher;
+  /* Message encryption key */
+  struct aes128_ctx enc;
+  struct gcm_siv_ctx siv;
+};
+
+void
+gcm_siv_aes128_set_key(struct gcm_siv_aes128_ctx *ctx, const uint8_t *key);
+
+void
+gcm_siv_aes128_set_nonce(struct gcm_siv_aes128_ctx *ctx,
+			 const uint8_t *nonce);
+
+void
+gcm_siv_aes128_update(struct gcm_siv_aes128_ctx *ctx,
+		      size_t length, const uint8_t *data);
+
+void
+gcm_siv_aes128_encrypt(struct gcm_siv_aes128_ctx *ctx,
+		       size_t length, uint8_t *dst, const uint8_t *src);
+
+int
+gcm_siv_aes128_decrypt(struct gcm_siv_aes128_ctx *ctx,
+		       const uint8_t *tag,
+		       size_t length, uint8_t *dst, const uint8_t *src);
+
+void
+gcm_siv_aes128_digest(struct gcm_siv_aes128_ctx *ctx,
+		      size_t length, uint8_t *digest);
+
+/* The ciphertext is the encrypted message followed by the tag, so
+   clength = mlength + GCM_SIV_DIGEST_SIZE. */
+void
+gcm_siv_aes128_encrypt_message(struct gcm_siv_aes128_ctx *ctx,
+			       const uint8_t *nonce,
+			       size_t alength, const uint8_t *adata,
+			       size_t clength, uint8_t *dst, const uint8_t *src);
+
+int
+gcm_siv_aes128_decrypt_message(struct gcm_siv_aes128_ctx *ctx,
+			       const uint8_t *nonce,
+			       size_t alength, const uint8_t *adata,
+			       size_t mlength, uint8_t *dst, const uint8_t *src);
+
+struct gcm_siv_aes256_ctx
+{
+  /* Key-generating key */
+  struct aes256_ctx cipher;
+  /* Message encryption key */
+  struct aes256_ctx enc;
+  struct gcm_siv_ctx siv;
+};
+
+void
+gcm_siv_aes256_set_key(struct gcm_siv_aes256_ctx *ctx, const uint8_t *key);
+
+void
+gcm_siv_aes256_set_nonce(struct gcm_siv_aes256_ctx *ctx,
+			 const uint8_t *nonce);
+
+void
+gcm_siv_aes256_update(struct gcm_siv_aes256_ctx *ctx,
+		      size_t length, const uint8_t *data);
+
+void
+gcm_siv_aes256_encrypt(struct gcm_siv_aes256_ctx *ctx,
+		       size_t length, uint8_t *dst, const uint8_t *src);
+
+int
+gcm_siv_aes256_decrypt(struct gcm_siv_aes256_ctx *ctx,
+		       const uint8_t *tag,
+		       size_t length, uint8_t *dst, const uint8_t *src);
+
+void
+gcm_siv_aes256_digest(struct gcm_siv_aes256_ctx *ctx,
+		      size_t length, uint8_t *digest);
+
+void
+gcm_siv_aes256_encrypt_message(struct gcm_siv_aes256_ctx *ctx,
+			       const uint8_t *nonce,
+			       size_t alength, const uint8_t *adata,
+			       size_t clength, uint8_t *dst, const uint8_t *src);
+
+int
+gcm_siv_aes256_decrypt_message(struct gcm_siv_aes256_ctx *ctx,
+			       const uint8_t *nonce,
+			       size_t alength, const uint8_t *adata,
+			       size_t mlength, uint8_t *dst, const uint8_t *src);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETTLE_GCM_SIV_H_INCLUDED */
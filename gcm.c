@@ -47,6 +47,7 @@
 #include <string.h>
 
 #include "gcm.h"
+#include "gcm-internal.h"
 
 #include "memxor.h"
 #include "nettle-internal.h"
@@ -220,7 +221,13 @@ gcm_gf_mul (union nettle_block16 *x, const union nettle_block16 *table)
   memcpy (x->b, Z.b, sizeof(Z));
 }
 # elif GCM_TABLE_BITS == 8
-#  if HAVE_NATIVE_gcm_hash8
+#  if HAVE_NATIVE_gcm_hash
+
+#define gcm_hash _nettle_gcm_hash
+void
+_nettle_gcm_hash (const struct gcm_key *key, union nettle_block16 *x,
+		  size_t length, const uint8_t *data);
+#  elif HAVE_NATIVE_gcm_hash8
 
 #define gcm_hash _nettle_gcm_hash8
 void
@@ -317,7 +324,7 @@ gcm_gf_mul (union nettle_block16 *x, const union nettle_block16 *table)
   gcm_gf_shift_8(&Z);
   gcm_gf_add(x, &Z, &table[x->b[0]]);
 }
-#  endif /* ! HAVE_NATIVE_gcm_hash8 */
+#  endif /* ! HAVE_NATIVE_gcm_hash8 && ! HAVE_NATIVE_gcm_hash */
 # else /* GCM_TABLE_BITS != 8 */
 #  error Unsupported table size. 
 # endif /* GCM_TABLE_BITS != 8 */
@@ -329,6 +336,46 @@ gcm_gf_mul (union nettle_block16 *x, const union nettle_block16 *table)
 /* Increment the rightmost 32 bits. */
 #define INC32(block) INCREMENT(4, (block.b) + GCM_BLOCK_SIZE - 4)
 
+#if GCM_TABLE_BITS == 8 && HAVE_NATIVE_gcm_init_key
+
+#define gcm_init_key _nettle_gcm_init_key
+void
+_nettle_gcm_init_key (union nettle_block16 *table);
+/* For fat builds */
+void
+_nettle_gcm_init_key_c (union nettle_block16 *table);
+#endif /* HAVE_NATIVE_gcm_init_key */
+
+/* Computes the remaining table entries, given H in the middle element
+   (or the first element, if GCM_TABLE_BITS == 0). A native
+   implementation may use a different layout, and only needs to fill
+   in the entries its gcm_hash function uses. */
+#if HAVE_NATIVE_gcm_init_key
+void
+_nettle_gcm_init_key_c (union nettle_block16 *table)
+#else
+static void
+gcm_init_key (union nettle_block16 *table)
+#endif
+{
+#if GCM_TABLE_BITS
+  /* Middle element if GCM_TABLE_BITS > 0, otherwise the first
+     element */
+  unsigned i = (1<<GCM_TABLE_BITS)/2;
+
+  /* Algorithm 3 from the gcm paper. First do powers of two, then do
+     the rest by adding. */
+  while (i /= 2)
+    gcm_gf_shift(&table[i], &table[2*i]);
+  for (i = 2; i < 1<<GCM_TABLE_BITS; i *= 2)
+    {
+      unsigned j;
+      for (j = 1; j < i; j++)
+	gcm_gf_add(&table[i+j], &table[i], &table[j]);
+    }
+#endif
+}
+
 /* Initialization of GCM.
  * @ctx: The context of GCM
  * @cipher: The context of the underlying block cipher
@@ -345,19 +392,8 @@ gcm_set_key(struct gcm_key *key,
   /* H */  
   memset(key->h[0].b, 0, GCM_BLOCK_SIZE);
   f (cipher, GCM_BLOCK_SIZE, key->h[i].b, key->h[0].b);
-  
-#if GCM_TABLE_BITS
-  /* Algorithm 3 from the gcm paper. First do powers of two, then do
-     the rest by adding. */
-  while (i /= 2)
-    gcm_gf_shift(&key->h[i], &key->h[2*i]);
-  for (i = 2; i < 1<<GCM_TABLE_BITS; i *= 2)
-    {
-      unsigned j;
-      for (j = 1; j < i; j++)
-	gcm_gf_add(&key->h[i+j], &key->h[i],&key->h[j]);
-    }
-#endif
+
+  gcm_init_key (key->h);
 }
 
 #ifndef gcm_hash
@@ -379,6 +415,71 @@ gcm_hash(const struct gcm_key *key, union nettle_block16 *x,
 }
 #endif /* !gcm_hash */
 
+/* POLYVAL, from RFC 8452, is computed using GHASH, following its
+   appendix A: POLYVAL(H, X_1, ..., X_n) = ByteReverse(GHASH(
+   mulX_GHASH(ByteReverse(H)), ByteReverse(X_1), ..., ByteReverse(X_n))).
+   The state is kept in the byte reversed GHASH representation. */
+
+/* Allows dst == src */
+static void
+block16_reverse (uint8_t *dst, const uint8_t *src)
+{
+  unsigned i;
+  for (i = 0; i < GCM_BLOCK_SIZE / 2; i++)
+    {
+      uint8_t t = src[i];
+      dst[i] = src[GCM_BLOCK_SIZE - 1 - i];
+      dst[GCM_BLOCK_SIZE - 1 - i] = t;
+    }
+}
+
+void
+_nettle_polyval_set_key (struct gcm_key *key, const uint8_t *h)
+{
+  /* Middle element if GCM_TABLE_BITS > 0, otherwise the first
+     element */
+  unsigned i = (1<<GCM_TABLE_BITS)/2;
+
+  memset (key->h[0].b, 0, GCM_BLOCK_SIZE);
+  block16_reverse (key->h[i].b, h);
+  gcm_gf_shift (&key->h[i], &key->h[i]);
+
+  gcm_init_key (key->h);
+}
+
+/* Number of blocks reversed per call to gcm_hash. */
+#define POLYVAL_BUFFER_BLOCKS 16
+
+void
+_nettle_polyval_update (const struct gcm_key *key, union nettle_block16 *x,
+			size_t length, const uint8_t *data)
+{
+  union nettle_block16 buffer[POLYVAL_BUFFER_BLOCKS];
+
+  while (length >= GCM_BLOCK_SIZE)
+    {
+      size_t blocks = length / GCM_BLOCK_SIZE;
+      size_t i;
+
+      if (blocks > POLYVAL_BUFFER_BLOCKS)
+	blocks = POLYVAL_BUFFER_BLOCKS;
+
+      for (i = 0; i < blocks; i++, data += GCM_BLOCK_SIZE)
+	block16_reverse (buffer[i].b, data);
+
+      gcm_hash (key, x, blocks * GCM_BLOCK_SIZE, buffer[0].b);
+      length -= blocks * GCM_BLOCK_SIZE;
+    }
+  if (length > 0)
+    {
+      /* Zero padding is on the right, before reversal. */
+      memset (buffer[0].b, 0, GCM_BLOCK_SIZE);
+      memcpy (buffer[0].b, data, length);
+      block16_reverse (buffer[0].b, buffer[0].b);
+      gcm_hash (key, x, GCM_BLOCK_SIZE, buffer[0].b);
+    }
+}
+
 static void
 gcm_hash_sizes(const struct gcm_key *key, union nettle_block16 *x,
 	       uint64_t auth_size, uint64_t data_size)
@@ -497,6 +598,27 @@ gcm_decrypt(struct gcm_ctx *ctx, const struct gcm_key *key,
   ctx->data_size += length;
 }
 
+#if HAVE_NATIVE_gcm_aes_encrypt
+/* For fat builds, when the native code can't be used. */
+size_t
+_nettle_gcm_aes_encrypt_c (struct gcm_key *key UNUSED, unsigned rounds UNUSED,
+			   size_t length UNUSED, uint8_t *dst UNUSED,
+			   const uint8_t *src UNUSED)
+{
+  return 0;
+}
+#endif
+
+#if HAVE_NATIVE_gcm_aes_decrypt
+size_t
+_nettle_gcm_aes_decrypt_c (struct gcm_key *key UNUSED, unsigned rounds UNUSED,
+			   size_t length UNUSED, uint8_t *dst UNUSED,
+			   const uint8_t *src UNUSED)
+{
+  return 0;
+}
+#endif
+
 void
 gcm_digest(struct gcm_ctx *ctx, const struct gcm_key *key,
 	   const void *cipher, nettle_cipher_func *f,
@@ -43,55 +43,50 @@
 #include "gmp-glue.h"
 
 int
-pkcs1_decrypt (size_t key_size,
-	       const mpz_t m,
-	       size_t *length, uint8_t *message)
+_pkcs1_decrypt_em (size_t key_size, const uint8_t *em,
+		   size_t *length, uint8_t *message)
 {
-  TMP_GMP_DECL(em, uint8_t);
-  uint8_t *terminator;
+  const uint8_t *terminator;
   size_t padding;
   size_t message_length;
-  int ret;
-
-  TMP_GMP_ALLOC(em, key_size);
-  nettle_mpz_get_str_256(key_size, em, m);
 
   /* Check format */
   if (em[0] || em[1] != 2)
-    {
-      ret = 0;
-      goto cleanup;
-    }
+    return 0;
 
   terminator = memchr(em + 2, 0, key_size - 2);
 
   if (!terminator)
-    {
-      ret = 0;
-      goto cleanup;
-    }
-  
+    return 0;
+
   padding = terminator - (em + 2);
   if (padding < 8)
-    {
-      ret = 0;
-      goto cleanup;
-    }
+    return 0;
 
   message_length = key_size - 3 - padding;
 
   if (*length < message_length)
-    {
-      ret = 0;
-      goto cleanup;
-    }
-  
+    return 0;
+
   memcpy(message, terminator + 1, message_length);
   *length = message_length;
 
-  ret = 1;
-cleanup:
+  return 1;
+}
+
+int
+pkcs1_decrypt (size_t key_size,
+	       const mpz_t m,
+	       size_t *length, uint8_t *message)
+{
+  TMP_GMP_DECL(em, uint8_t);
+  int ret;
+
+  TMP_GMP_ALLOC(em, key_size);
+  nettle_mpz_get_str_256(key_size, em, m);
+
+  ret = _pkcs1_decrypt_em (key_size, em, length, message);
+
   TMP_GMP_FREE(em);
   return ret;
 }
-	       
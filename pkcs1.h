@@ -54,6 +54,11 @@ extern "C" {
 #define pkcs1_rsa_sha512_encode_digest nettle_pkcs1_rsa_sha512_encode_digest
 #define pkcs1_encrypt nettle_pkcs1_encrypt
 #define pkcs1_decrypt nettle_pkcs1_decrypt
+#define _pkcs1_decrypt_em _nettle_pkcs1_decrypt_em
+#define _pkcs1_rsa_md5_encode_digest_em _nettle_pkcs1_rsa_md5_encode_digest_em
+#define _pkcs1_rsa_sha1_encode_digest_em _nettle_pkcs1_rsa_sha1_encode_digest_em
+#define _pkcs1_rsa_sha256_encode_digest_em _nettle_pkcs1_rsa_sha256_encode_digest_em
+#define _pkcs1_rsa_sha512_encode_digest_em _nettle_pkcs1_rsa_sha512_encode_digest_em
 
 struct md5_ctx;
 struct sha1_ctx;
@@ -79,6 +84,28 @@ pkcs1_decrypt (size_t key_size,
 	       const mpz_t m,
 	       size_t *length, uint8_t *message);
 
+/* Variants operating directly on the encoded message, an octet
+   string of size key_size, with no allocation. */
+int
+_pkcs1_decrypt_em (size_t key_size, const uint8_t *em,
+		   size_t *length, uint8_t *message);
+
+int
+_pkcs1_rsa_md5_encode_digest_em(uint8_t *em, size_t key_size,
+				const uint8_t *digest);
+
+int
+_pkcs1_rsa_sha1_encode_digest_em(uint8_t *em, size_t key_size,
+				 const uint8_t *digest);
+
+int
+_pkcs1_rsa_sha256_encode_digest_em(uint8_t *em, size_t key_size,
+				   const uint8_t *digest);
+
+int
+_pkcs1_rsa_sha512_encode_digest_em(uint8_t *em, size_t key_size,
+				   const uint8_t *digest);
+
 int
 pkcs1_rsa_digest_encode(mpz_t m, size_t key_size,
 			size_t di_length, const uint8_t *digest_info);
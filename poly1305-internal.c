@@ -105,6 +105,8 @@ poly1305_set_key(struct poly1305_ctx *ctx, const uint8_t key[16])
   ctx->s3 = ctx->r3 * 5;
   ctx->s4 = ctx->r4 * 5;
 
+  ctx->have_powers = 0;
+
   ctx->h0 = 0;
   ctx->h1 = 0;
   ctx->h2 = 0;
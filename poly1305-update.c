@@ -0,0 +1,85 @@
+/* poly1305-update.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include "poly1305.h"
+
+#if HAVE_NATIVE_poly1305_blocks
+/* For fat builds */
+# define poly1305_blocks_c _nettle_poly1305_blocks_c
+void
+poly1305_blocks_c (struct poly1305_ctx *ctx, size_t blocks, const uint8_t *m);
+#else
+# define poly1305_blocks_c _poly1305_blocks
+#endif
+
+void
+poly1305_blocks_c (struct poly1305_ctx *ctx, size_t blocks, const uint8_t *m)
+{
+  for (; blocks > 0; blocks--, m += POLY1305_BLOCK_SIZE)
+    _poly1305_block (ctx, m, 1);
+}
+
+unsigned
+_poly1305_update (struct poly1305_ctx *ctx, uint8_t *block,
+		  unsigned index, size_t length, const uint8_t *m)
+{
+  size_t blocks;
+
+  if (index > 0)
+    {
+      unsigned left = POLY1305_BLOCK_SIZE - index;
+      if (length < left)
+	{
+	  memcpy (block + index, m, length);
+	  return index + length;
+	}
+      memcpy (block + index, m, left);
+      _poly1305_block (ctx, block, 1);
+      m += left;
+      length -= left;
+    }
+
+  blocks = length / POLY1305_BLOCK_SIZE;
+  if (blocks > 0)
+    {
+      _poly1305_blocks (ctx, blocks, m);
+      m += blocks * POLY1305_BLOCK_SIZE;
+      length -= blocks * POLY1305_BLOCK_SIZE;
+    }
+  memcpy (block, m, length);
+  return length;
+}
@@ -45,6 +45,8 @@ extern "C" {
 #define poly1305_set_key nettle_poly1305_set_key
 #define poly1305_digest nettle_poly1305_digest
 #define _poly1305_block _nettle_poly1305_block
+#define _poly1305_blocks _nettle_poly1305_blocks
+#define _poly1305_update _nettle_poly1305_update
 
 #define poly1305_aes_set_key nettle_poly1305_aes_set_key
 #define poly1305_aes_set_nonce nettle_poly1305_aes_set_nonce
@@ -74,6 +76,11 @@ struct poly1305_ctx {
     uint32_t h32[4];
     uint64_t h64[2];
   } h;
+  /* Powers of r cached by some implementations of
+     _poly1305_blocks, computed on first use. Invalidated by
+     poly1305_set_key. */
+  uint32_t powers[36];
+  uint32_t have_powers;
 };
 
 /* Low-level internal interface. */
@@ -83,6 +90,13 @@ void poly1305_digest (struct poly1305_ctx *ctx, union nettle_block16 *s);
 /* Internal function. Process one block. */
 void _poly1305_block (struct poly1305_ctx *ctx, const uint8_t *m,
 		      unsigned high);
+/* Internal function. Process several complete blocks. */
+void _poly1305_blocks (struct poly1305_ctx *ctx, size_t blocks,
+		       const uint8_t *m);
+/* Internal function. Buffers partial blocks in block, and returns
+   the new index. */
+unsigned _poly1305_update (struct poly1305_ctx *ctx, uint8_t *block,
+			   unsigned index, size_t length, const uint8_t *m);
 
 /* poly1305-aes */
 
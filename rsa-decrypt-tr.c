@@ -59,3 +59,41 @@ rsa_decrypt_tr(const struct rsa_public_key *pub,
   mpz_clear(m);
   return res;
 }
+
+int
+rsa_decrypt_blinding_tr(const struct rsa_public_key *pub,
+			const struct rsa_private_key *key,
+			struct rsa_blinding_ctx *blinding,
+			void *random_ctx, nettle_random_func *random,
+			size_t *length, uint8_t *message,
+			const mpz_t gibberish)
+{
+  mpz_t m;
+  int res;
+
+  mpz_init(m);
+
+  res = (rsa_compute_root_blinding_tr (pub, key, blinding,
+				       random_ctx, random, m, gibberish)
+	 && pkcs1_decrypt (key->size, m, length, message));
+
+  mpz_clear(m);
+  return res;
+}
+
+int
+rsa_prepared_decrypt_tr(const struct rsa_prepared_private_key *key,
+			struct rsa_prepared_blinding_ctx *blinding,
+			void *random_ctx, nettle_random_func *random,
+			size_t *length, uint8_t *message,
+			const uint8_t *ciphertext,
+			mp_limb_t *scratch)
+{
+  uint8_t *em = (uint8_t *) scratch;
+
+  return (rsa_prepared_compute_root_tr (key, blinding,
+					random_ctx, random,
+					em, ciphertext,
+					scratch + key->nn)
+	  && _pkcs1_decrypt_em (key->size, em, length, message));
+}
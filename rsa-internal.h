@@ -0,0 +1,136 @@
+/* rsa-internal.h
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_RSA_INTERNAL_H_INCLUDED
+#define NETTLE_RSA_INTERNAL_H_INCLUDED
+
+#include "nettle-types.h"
+#include "bignum.h"
+#include "gmp-glue.h"
+
+/* Name mangling */
+#define rsa_mont_minv _nettle_rsa_mont_minv
+#define rsa_mont_redc _nettle_rsa_mont_redc
+#define rsa_mont_mul _nettle_rsa_mont_mul
+#define rsa_mont_sqr _nettle_rsa_mont_sqr
+#define rsa_mont_from _nettle_rsa_mont_from
+#define rsa_mont_powm _nettle_rsa_mont_powm
+#define rsa_mont_powm_sec_n _nettle_rsa_mont_powm_sec_n
+#define rsa_mont_powm_n _nettle_rsa_mont_powm_n
+
+/* An odd modulo, with the constants needed for Montgomery
+   multiplication with R = B^size. All outputs of the functions below
+   are canonical, i.e., < m. */
+struct rsa_modulo
+{
+  mp_size_t size;
+  /* -m^{-1} mod B */
+  mp_limb_t minv;
+  const mp_limb_t *m;
+  /* R^2 mod m */
+  const mp_limb_t *rr;
+  /* R^3 mod m */
+  const mp_limb_t *rrr;
+};
+
+/* Returns -m0^{-1} mod B, for odd m0. */
+mp_limb_t
+rsa_mont_minv (mp_limb_t m0);
+
+/* Computes rp = tp / R mod m, where tp has 2 size limbs, and its
+   value is < m R. Clobbers tp. The output may coincide with the high
+   half of tp, but must not overlap the low half. */
+void
+rsa_mont_redc (const struct rsa_modulo *m, mp_limb_t *rp, mp_limb_t *tp);
+
+/* Computes rp = ap bp / R mod m, for inputs < m. Needs 2 size limbs
+   of scratch at tp. The output may overlap the inputs. */
+void
+rsa_mont_mul (const struct rsa_modulo *m, mp_limb_t *rp,
+	      const mp_limb_t *ap, const mp_limb_t *bp, mp_limb_t *tp);
+
+void
+rsa_mont_sqr (const struct rsa_modulo *m, mp_limb_t *rp,
+	      const mp_limb_t *ap, mp_limb_t *tp);
+
+/* Converts an arbitrary number of an <= 2 size limbs, with value < m
+   R, to Montgomery representation, rp = ap R mod m. Needs 2 size
+   limbs of scratch at tp, which must not overlap ap. */
+void
+rsa_mont_from (const struct rsa_modulo *m, mp_limb_t *rp,
+	       const mp_limb_t *ap, mp_size_t an, mp_limb_t *tp);
+
+/* Computes rp[i] = ap[i]^e[i] mod m[i] for 0 <= i < k, with all
+   values in Montgomery representation. The k exponentiations are
+   independent, and are interleaved. Side-channel silent, using a
+   fixed window of RSA_MONT_POWM_SEC_WBITS bits; each exponent is
+   processed as en[i] full limbs, leading zeros included. Each output
+   may overlap the corresponding input. Needs the sum of
+   RSA_MONT_POWM_SEC_ITCH (m[i]->size) limbs of scratch, plus twice
+   the largest size. */
+void
+rsa_mont_powm_sec_n (unsigned k, const struct rsa_modulo * const *m,
+		     mp_limb_t * const *rp, const mp_limb_t * const *ap,
+		     const mp_limb_t * const *ep, const mp_size_t *en,
+		     mp_limb_t *tp);
+
+/* Variable-time version, for public exponents. Requires e > 0, and
+   rp must not overlap ap. */
+void
+rsa_mont_powm (const struct rsa_modulo *m, mp_limb_t *rp,
+	       const mp_limb_t *ap,
+	       const mp_limb_t *ep, mp_size_t en,
+	       mp_limb_t *tp);
+
+/* Computes rp[l] = ap[l]^e mod m for 0 <= l < k, with a common
+   modulo and public exponent, in lock-step. Variable-time, requires e
+   > 0, and each rp[l] must not overlap ap[l]. Needs 2 size limbs of
+   scratch. */
+void
+rsa_mont_powm_n (unsigned k, const struct rsa_modulo *m,
+		 mp_limb_t * const *rp, const mp_limb_t * const *ap,
+		 const mp_limb_t *ep, mp_size_t en,
+		 mp_limb_t *tp);
+
+#define RSA_MONT_POWM_SEC_WBITS 4
+/* Maximum number of interleaved exponentiations */
+#define RSA_MONT_POWM_SEC_MAX 8
+
+/* Current scratch needs: */
+#define RSA_MONT_POWM_SEC_ITCH(size) \
+  (((1 << RSA_MONT_POWM_SEC_WBITS) + 1) * (size))
+#define RSA_MONT_POWM_ITCH(size) (2*(size))
+
+/* Number of signatures verified in lock-step by the batch verify
+   functions. */
+#define RSA_VERIFY_BATCH_SIZE 4
+
+#endif /* NETTLE_RSA_INTERNAL_H_INCLUDED */
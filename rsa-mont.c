@@ -0,0 +1,255 @@
+/* rsa-mont.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include "rsa-internal.h"
+#include "ecc-internal.h"
+
+static unsigned
+exp_bit (const mp_limb_t *ep, unsigned i)
+{
+  return (ep[i / GMP_NUMB_BITS] >> (i % GMP_NUMB_BITS)) & 1;
+}
+
+mp_limb_t
+rsa_mont_minv (mp_limb_t m0)
+{
+  mp_limb_t inv;
+  unsigned i;
+
+  assert (m0 & 1);
+
+  /* Correct to 3 bits, and each Newton step doubles the number of
+     correct bits. */
+  for (i = 3, inv = m0; i < GMP_NUMB_BITS; i *= 2)
+    inv *= 2 - m0 * inv;
+
+  return -inv;
+}
+
+void
+rsa_mont_redc (const struct rsa_modulo *m, mp_limb_t *rp, mp_limb_t *tp)
+{
+  mp_size_t n = m->size;
+  mp_size_t i;
+  mp_limb_t cy, borrow;
+
+  /* Each carry limb is stored in the limb just cleared, and added in
+     at the end. */
+  for (i = 0; i < n; i++)
+    tp[i] = mpn_addmul_1 (tp + i, m->m, n, tp[i] * m->minv);
+
+  /* Result is < 2m, so one conditional subtraction is enough. */
+  cy = mpn_add_n (rp, tp + n, tp, n);
+  borrow = mpn_sub_n (tp, rp, m->m, n);
+  cnd_copy (cy | (borrow ^ 1), rp, tp, n);
+}
+
+void
+rsa_mont_mul (const struct rsa_modulo *m, mp_limb_t *rp,
+	      const mp_limb_t *ap, const mp_limb_t *bp, mp_limb_t *tp)
+{
+  mpn_mul_n (tp, ap, bp, m->size);
+  rsa_mont_redc (m, rp, tp);
+}
+
+#if NETTLE_USE_MINI_GMP
+/* The mini-gmp mpn_sqr is a plain multiplication. Compute the cross
+   products only once, then double and add the diagonal. */
+static void
+sqr_n (mp_limb_t *rp, const mp_limb_t *ap, mp_size_t n)
+{
+  mp_limb_t cy, high;
+  mp_size_t i;
+
+  mpn_zero (rp, 2*n);
+  for (i = 0; i + 1 < n; i++)
+    rp[n+i] = mpn_addmul_1 (rp + 2*i + 1, ap + i + 1, n - i - 1, ap[i]);
+
+  for (i = 0, cy = high = 0; i < n; i++)
+    {
+      mp_limb_t lo, hi, w0, w1, c;
+
+      hi = mpn_mul_1 (&lo, ap + i, 1, ap[i]);
+
+      w0 = rp[2*i];
+      w1 = rp[2*i+1];
+      lo += cy; c = lo < cy;
+      hi += c; /* No carry, since hi <= B - 2 */
+      w0 = (w0 << 1) | high; high = rp[2*i] >> (GMP_NUMB_BITS - 1);
+      w1 = (w1 << 1) | high; high = rp[2*i+1] >> (GMP_NUMB_BITS - 1);
+
+      w0 += lo; c = w0 < lo;
+      w1 += c; cy = w1 < c;
+      w1 += hi; cy += w1 < hi;
+
+      rp[2*i] = w0;
+      rp[2*i+1] = w1;
+    }
+  assert (cy == 0 && high == 0);
+}
+#else
+#define sqr_n mpn_sqr
+#endif
+
+void
+rsa_mont_sqr (const struct rsa_modulo *m, mp_limb_t *rp,
+	      const mp_limb_t *ap, mp_limb_t *tp)
+{
+  sqr_n (tp, ap, m->size);
+  rsa_mont_redc (m, rp, tp);
+}
+
+void
+rsa_mont_from (const struct rsa_modulo *m, mp_limb_t *rp,
+	       const mp_limb_t *ap, mp_size_t an, mp_limb_t *tp)
+{
+  mp_size_t n = m->size;
+  assert (an <= 2*n);
+
+  mpn_copyi (tp, ap, an);
+  mpn_zero (tp + an, 2*n - an);
+
+  /* a / R, then multiply by R^3 / R. */
+  rsa_mont_redc (m, rp, tp);
+  rsa_mont_mul (m, rp, rp, m->rrr, tp);
+}
+
+void
+rsa_mont_powm_sec_n (unsigned k, const struct rsa_modulo * const *m,
+		     mp_limb_t * const *rp, const mp_limb_t * const *ap,
+		     const mp_limb_t * const *ep, const mp_size_t *en,
+		     mp_limb_t *tp)
+{
+#define TABLE_SIZE (1U << RSA_MONT_POWM_SEC_WBITS)
+  mp_limb_t *table[RSA_MONT_POWM_SEC_MAX];
+  mp_limb_t *sp[RSA_MONT_POWM_SEC_MAX];
+  mp_limb_t *scratch;
+  unsigned i, j, l;
+  unsigned bits;
+
+  assert (k <= RSA_MONT_POWM_SEC_MAX);
+
+  for (l = 0, scratch = tp, bits = 0; l < k; l++)
+    {
+      table[l] = scratch;
+      sp[l] = scratch + (m[l]->size << RSA_MONT_POWM_SEC_WBITS);
+      scratch = sp[l] + m[l]->size;
+      if (en[l] * GMP_NUMB_BITS > bits)
+	bits = en[l] * GMP_NUMB_BITS;
+    }
+
+  /* table[l] holds a^j for 0 <= j < TABLE_SIZE, the first entry
+     being R mod m, the Montgomery representation of 1. All tables are
+     written before any output, since rp and ap may overlap. */
+  for (l = 0; l < k; l++)
+    {
+      mp_size_t n = m[l]->size;
+      mpn_copyi (scratch, m[l]->rr, n);
+      mpn_zero (scratch + n, n);
+      rsa_mont_redc (m[l], table[l], scratch);
+      mpn_copyi (table[l] + n, ap[l], n);
+      for (j = 2; j < TABLE_SIZE; j++)
+	rsa_mont_mul (m[l], table[l] + j*n, table[l] + (j-1)*n, ap[l],
+		      scratch);
+    }
+  for (l = 0; l < k; l++)
+    mpn_copyi (rp[l], table[l], m[l]->size);
+
+  /* Fixed window, with GMP_NUMB_BITS a multiple of the window size.
+     The exponentiations run in lock-step, aligned at the least
+     significant end, so that each step works on independent data. */
+  for (i = bits; i > 0; )
+    {
+      i -= RSA_MONT_POWM_SEC_WBITS;
+
+      for (j = 0; j < RSA_MONT_POWM_SEC_WBITS; j++)
+	for (l = 0; l < k; l++)
+	  if (i < en[l] * GMP_NUMB_BITS)
+	    rsa_mont_sqr (m[l], rp[l], rp[l], scratch);
+
+      for (l = 0; l < k; l++)
+	if (i < en[l] * GMP_NUMB_BITS)
+	  {
+	    unsigned w = (ep[l][i / GMP_NUMB_BITS] >> (i % GMP_NUMB_BITS))
+	      & (TABLE_SIZE - 1);
+	    sec_tabselect (sp[l], m[l]->size, table[l], TABLE_SIZE, w);
+	    rsa_mont_mul (m[l], rp[l], rp[l], sp[l], scratch);
+	  }
+    }
+#undef TABLE_SIZE
+}
+
+void
+rsa_mont_powm (const struct rsa_modulo *m, mp_limb_t *rp,
+	       const mp_limb_t *ap,
+	       const mp_limb_t *ep, mp_size_t en,
+	       mp_limb_t *tp)
+{
+  rsa_mont_powm_n (1, m, &rp, &ap, ep, en, tp);
+}
+
+void
+rsa_mont_powm_n (unsigned k, const struct rsa_modulo *m,
+		 mp_limb_t * const *rp, const mp_limb_t * const *ap,
+		 const mp_limb_t *ep, mp_size_t en,
+		 mp_limb_t *tp)
+{
+  unsigned i, l;
+
+  while (en > 0 && ep[en-1] == 0)
+    en--;
+  assert (en > 0);
+
+  for (i = en * GMP_NUMB_BITS - 1; !exp_bit (ep, i); i--)
+    ;
+
+  for (l = 0; l < k; l++)
+    {
+      assert (rp[l] != ap[l]);
+      mpn_copyi (rp[l], ap[l], m->size);
+    }
+  while (i-- > 0)
+    {
+      unsigned bit = exp_bit (ep, i);
+      for (l = 0; l < k; l++)
+	{
+	  rsa_mont_sqr (m, rp[l], rp[l], tp);
+	  if (bit)
+	    rsa_mont_mul (m, rp[l], rp[l], ap[l], tp);
+	}
+    }
+}
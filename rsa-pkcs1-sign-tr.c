@@ -57,3 +57,40 @@ rsa_pkcs1_sign_tr(const struct rsa_public_key *pub,
   mpz_clear(m);
   return ret;
 }
+
+int
+rsa_pkcs1_sign_blinding_tr(const struct rsa_public_key *pub,
+			   const struct rsa_private_key *key,
+			   struct rsa_blinding_ctx *blinding,
+			   void *random_ctx, nettle_random_func *random,
+			   size_t length, const uint8_t *digest_info,
+			   mpz_t s)
+{
+  mpz_t m;
+  int ret;
+
+  mpz_init(m);
+
+  ret = (pkcs1_rsa_digest_encode (m, key->size, length, digest_info)
+	 && rsa_compute_root_blinding_tr (pub, key, blinding,
+					  random_ctx, random, s, m));
+  mpz_clear(m);
+  return ret;
+}
+
+int
+rsa_prepared_pkcs1_sign_tr(const struct rsa_prepared_private_key *key,
+			   struct rsa_prepared_blinding_ctx *blinding,
+			   void *random_ctx, nettle_random_func *random,
+			   size_t length, const uint8_t *digest_info,
+			   uint8_t *signature,
+			   mp_limb_t *scratch)
+{
+  uint8_t *em = (uint8_t *) scratch;
+
+  return (_pkcs1_signature_prefix(key->size, em, length, digest_info, 0)
+	  && rsa_prepared_compute_root_tr (key, blinding,
+					   random_ctx, random,
+					   signature, em,
+					   scratch + key->nn));
+}
@@ -0,0 +1,383 @@
+/* rsa-prepared.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include "rsa.h"
+
+#include "ecc-internal.h"
+#include "rsa-internal.h"
+
+static void
+set_modulo (mp_limb_t *minv, mp_limb_t *mp, mp_limb_t *rr, mp_limb_t *rrr,
+	    mpz_t t, const mpz_t m)
+{
+  mp_size_t n = mpz_size (m);
+
+  mpz_limbs_copy (mp, m, n);
+  *minv = rsa_mont_minv (mp[0]);
+
+  mpz_set_ui (t, 1);
+  mpz_mul_2exp (t, t, 2 * n * GMP_NUMB_BITS);
+  mpz_fdiv_r (t, t, m);
+  mpz_limbs_copy (rr, t, n);
+
+  if (rrr)
+    {
+      mpz_set_ui (t, 1);
+      mpz_mul_2exp (t, t, 3 * n * GMP_NUMB_BITS);
+      mpz_fdiv_r (t, t, m);
+      mpz_limbs_copy (rrr, t, n);
+    }
+}
+
+/* Checks that n < m R, the input condition for reducing a number mod
+   n, or a number mod the other factor, using rsa_mont_from. */
+static int
+mont_from_ok (mpz_t t, const mpz_t n, const mpz_t m)
+{
+  mpz_mul_2exp (t, m, mpz_size (m) * GMP_NUMB_BITS);
+  return mpz_cmp (n, t) < 0;
+}
+
+int
+rsa_prepared_private_key_init (struct rsa_prepared_private_key *prep,
+			       const struct rsa_public_key *pub,
+			       const struct rsa_private_key *key)
+{
+  mpz_t t;
+  int res;
+
+  if (mpz_even_p (pub->n) || mpz_even_p (key->p) || mpz_even_p (key->q)
+      || mpz_sgn (pub->e) <= 0
+      || mpz_sgn (key->a) < 0 || mpz_sgn (key->b) < 0)
+    return 0;
+
+  prep->nn = mpz_size (pub->n);
+  prep->en = mpz_size (pub->e);
+  prep->pn = mpz_size (key->p);
+  prep->qn = mpz_size (key->q);
+
+  if (prep->nn > _RSA_PREPARED_LIMBS || prep->en > prep->nn
+      || prep->pn > _RSA_PREPARED_HALF_LIMBS
+      || prep->qn > _RSA_PREPARED_HALF_LIMBS
+      || mpz_size (key->a) > (size_t) prep->pn
+      || mpz_size (key->b) > (size_t) prep->qn)
+    return 0;
+
+  mpz_init (t);
+
+  res = mont_from_ok (t, pub->n, key->p) && mont_from_ok (t, pub->n, key->q);
+  if (res)
+    {
+      prep->n_bits = mpz_sizeinbase (pub->n, 2);
+      prep->size = (prep->n_bits + 7) / 8;
+
+      set_modulo (&prep->ninv, prep->n, prep->n_rr, prep->n_rrr, t, pub->n);
+      set_modulo (&prep->pinv, prep->p, prep->p_rr, prep->p_rrr, t, key->p);
+      set_modulo (&prep->qinv, prep->q, prep->q_rr, prep->q_rrr, t, key->q);
+
+      mpz_add_ui (t, pub->n, 1);
+      mpz_tdiv_q_2exp (t, t, 1);
+      mpz_limbs_copy (prep->n_mp1h, t, prep->nn);
+
+      mpz_limbs_copy (prep->e, pub->e, prep->en);
+      mpz_limbs_copy (prep->a, key->a, prep->pn);
+      mpz_limbs_copy (prep->b, key->b, prep->qn);
+
+      mpz_fdiv_r (t, key->c, key->p);
+      mpz_limbs_copy (prep->c, t, prep->pn);
+    }
+  mpz_clear (t);
+  return res;
+}
+
+int
+rsa_prepared_public_key_init (struct rsa_prepared_public_key *prep,
+			      const struct rsa_public_key *pub)
+{
+  mpz_t t;
+
+  if (mpz_even_p (pub->n) || mpz_sgn (pub->e) <= 0)
+    return 0;
+
+  prep->nn = mpz_size (pub->n);
+  prep->en = mpz_size (pub->e);
+
+  if (prep->nn > _RSA_PREPARED_LIMBS || prep->en > prep->nn)
+    return 0;
+
+  prep->size = (mpz_sizeinbase (pub->n, 2) + 7) / 8;
+
+  mpz_init (t);
+  set_modulo (&prep->ninv, prep->n, prep->n_rr, NULL, t, pub->n);
+  mpz_clear (t);
+
+  mpz_limbs_copy (prep->e, pub->e, prep->en);
+  return 1;
+}
+
+mp_size_t
+rsa_prepared_public_itch (const struct rsa_prepared_public_key *key)
+{
+  /* The expected encoded messages, followed by the scratch for
+     _rsa_prepared_verify_n, for a full batch. */
+  return (3*RSA_VERIFY_BATCH_SIZE + 2) * key->nn;
+}
+
+static void
+get_modulo (struct rsa_modulo *m, mp_size_t size, mp_limb_t minv,
+	    const mp_limb_t *mp, const mp_limb_t *rr, const mp_limb_t *rrr)
+{
+  m->size = size;
+  m->minv = minv;
+  m->m = mp;
+  m->rr = rr;
+  m->rrr = rrr;
+}
+
+static int
+one_p (const mp_limb_t *xp, mp_size_t n)
+{
+  mp_limb_t w;
+  mp_size_t i;
+  for (i = 1, w = xp[0] ^ 1; i < n; i++)
+    w |= xp[i];
+  return w == 0;
+}
+
+static mp_size_t
+compute_root_itch (const struct rsa_prepared_private_key *key)
+{
+  mp_size_t nn = key->nn;
+  mp_size_t hn = key->pn > key->qn ? key->pn : key->qn;
+  mp_size_t out = RSA_MONT_POWM_SEC_ITCH (key->pn)
+    + RSA_MONT_POWM_SEC_ITCH (key->qn) + 2*hn;
+
+  if (out < 2*nn)
+    out = 2*nn;
+
+  return 8*nn + 2 + key->pn + key->qn + out;
+}
+
+mp_size_t
+rsa_prepared_itch (const struct rsa_prepared_private_key *key)
+{
+  /* Room for the encoded message, in front of the scratch for
+     rsa_prepared_compute_root_tr. */
+  return key->nn + compute_root_itch (key);
+}
+
+void
+rsa_prepared_blinding_init (struct rsa_prepared_blinding_ctx *ctx)
+{
+  ctx->count = 0;
+}
+
+/* Generates a fresh random r < 2^{n_bits - 1} <= n, and stores r^e R
+   at rep and r^{-1} R at rip. Needs 2 nn limbs at rip, and 6 nn
+   limbs of scratch. */
+static void
+blinding_fresh (const struct rsa_prepared_private_key *key,
+		const struct rsa_modulo *nm,
+		void *random_ctx, nettle_random_func *random,
+		mp_limb_t *rep, mp_limb_t *rip, mp_limb_t *scratch)
+{
+  struct ecc_modulo inv;
+  mp_size_t nn = key->nn;
+  mp_size_t k = (key->n_bits - 1) / GMP_NUMB_BITS;
+  unsigned shift = (key->n_bits - 1) % GMP_NUMB_BITS;
+
+#define rp scratch
+#define rmp (scratch + nn)
+#define tp (scratch + 2*nn)
+#define scratch_out (scratch + 4*nn)
+
+  inv.m = key->n;
+  inv.size = nn;
+  inv.bit_size = key->n_bits;
+  inv.mp1h = key->n_mp1h;
+
+  /* Retry in the unlikely case that r isn't invertible, checked by
+     computing r r^{-1} mod n. */
+  for (;;)
+    {
+      random (random_ctx, key->size, (uint8_t *) tp);
+      mpn_set_base256 (rp, nn, (uint8_t *) tp, key->size);
+      rp[k] &= ((mp_limb_t) 1 << shift) - 1;
+      if (k + 1 < nn)
+	mpn_zero (rp + k + 1, nn - k - 1);
+
+      ecc_mod_inv (&inv, rip, rp, scratch_out);
+
+      rsa_mont_mul (nm, rmp, rp, key->n_rr, tp);
+      rsa_mont_mul (nm, rp, rmp, rip, tp);
+      if (one_p (rp, nn))
+	break;
+    }
+  rsa_mont_mul (nm, rip, rip, key->n_rr, tp);
+  rsa_mont_powm (nm, rep, rmp, key->e, key->en, tp);
+
+#undef rp
+#undef rmp
+#undef tp
+#undef scratch_out
+}
+
+/* Computes x = (m r^e)^d r^{-1} mod n, using CRT, and checks that
+   x^e = m. Checking after unblinding also catches a blinding context
+   used with the wrong key. */
+int
+rsa_prepared_compute_root_tr (const struct rsa_prepared_private_key *key,
+			      struct rsa_prepared_blinding_ctx *blinding,
+			      void *random_ctx, nettle_random_func *random,
+			      uint8_t *x, const uint8_t *m,
+			      mp_limb_t *scratch)
+{
+  struct rsa_modulo nm, pm, qm;
+  const mp_limb_t *re;
+  const mp_limb_t *ri;
+
+  mp_size_t nn = key->nn;
+  mp_size_t pn = key->pn;
+  mp_size_t qn = key->qn;
+  int res;
+
+#define mp scratch
+#define rp (scratch + nn)
+#define rip (scratch + 2*nn)
+#define mbp (scratch + 4*nn)
+#define xbp (scratch + 5*nn)
+#define xpp (scratch + 6*nn)
+#define xqp (xpp + pn)
+#define tp (xqp + qn)
+#define scratch_out (tp + 2*nn + 2)
+
+  mpn_set_base256 (mp, nn, m, key->size);
+  if (mpn_cmp (mp, key->n, nn) >= 0)
+    return 0;
+
+  get_modulo (&nm, nn, key->ninv, key->n, key->n_rr, key->n_rrr);
+  get_modulo (&pm, pn, key->pinv, key->p, key->p_rr, key->p_rrr);
+  get_modulo (&qm, qn, key->qinv, key->q, key->q_rr, key->q_rrr);
+
+  if (blinding && blinding->count > 0)
+    {
+      blinding->count--;
+      rsa_mont_sqr (&nm, blinding->re, blinding->re, tp);
+      rsa_mont_sqr (&nm, blinding->ri, blinding->ri, tp);
+      re = blinding->re;
+      ri = blinding->ri;
+    }
+  else
+    {
+      /* Uses the area from mb and onwards as scratch. */
+      blinding_fresh (key, &nm, random_ctx, random, rp, rip, mbp);
+      if (blinding)
+	{
+	  mpn_copyi (blinding->re, rp, nn);
+	  mpn_copyi (blinding->ri, rip, nn);
+	  blinding->count = RSA_BLINDING_UPDATES;
+	}
+      re = rp;
+      ri = rip;
+    }
+
+  /* mb = m r^e mod n */
+  rsa_mont_mul (&nm, mbp, mp, re, tp);
+
+  /* Exponentiations mod p and q, in Montgomery representation. */
+  rsa_mont_from (&pm, xpp, mbp, nn, tp);
+  rsa_mont_from (&qm, xqp, mbp, nn, tp);
+  {
+    const struct rsa_modulo *moduli[2];
+    mp_limb_t *xs[2];
+    const mp_limb_t *es[2];
+    mp_size_t ens[2];
+
+    moduli[0] = &pm; xs[0] = xpp; es[0] = key->a; ens[0] = pn;
+    moduli[1] = &qm; xs[1] = xqp; es[1] = key->b; ens[1] = qn;
+    rsa_mont_powm_sec_n (2, moduli, xs, (const mp_limb_t * const *) xs,
+			 es, ens, scratch_out);
+  }
+
+  /* Convert xq to normal representation. */
+  mpn_copyi (tp, xqp, qn);
+  mpn_zero (tp + qn, qn);
+  rsa_mont_redc (&qm, xqp, tp);
+
+  /* h = c (xp - xq) mod p, computed as (xp - xq) R c / R. */
+  rsa_mont_from (&pm, xbp, xqp, qn, tp);
+  cnd_add_n (mpn_sub_n (xpp, xpp, xbp, pn), xpp, key->p, pn);
+  rsa_mont_mul (&pm, xbp, xpp, key->c, tp);
+
+  /* xb = xq + q h */
+  if (qn >= pn)
+    mpn_mul (tp, key->q, qn, xbp, pn);
+  else
+    mpn_mul (tp, xbp, pn, key->q, qn);
+  mpn_add (tp, tp, pn + qn, xqp, qn);
+  assert (pn + qn == nn || tp[nn] == 0);
+  mpn_copyi (xbp, tp, nn);
+
+  /* Unblind, x = xb r^{-1} mod n, stored at rp. */
+  rsa_mont_mul (&nm, rp, xbp, ri, tp);
+
+  /* Check that x^e = m, using the xp and xq area for the result. */
+  rsa_mont_mul (&nm, xbp, rp, key->n_rr, tp);
+  rsa_mont_powm (&nm, xpp, xbp, key->e, key->en, scratch_out);
+  mpn_copyi (tp, xpp, nn);
+  mpn_zero (tp + nn, nn);
+  rsa_mont_redc (&nm, xpp, tp);
+
+  res = (mpn_cmp (xpp, mp, nn) == 0);
+  if (res)
+    mpn_get_base256 (x, key->size, rp, nn);
+  else if (blinding)
+    /* Don't reuse a blinding factor which may be bad. */
+    blinding->count = 0;
+
+  return res;
+
+#undef mp
+#undef rp
+#undef rip
+#undef mbp
+#undef xbp
+#undef xpp
+#undef xqp
+#undef tp
+#undef scratch_out
+}
@@ -36,11 +36,13 @@
 #endif
 
 #include <assert.h>
+#include <string.h>
 
 #include "rsa.h"
 
 #include "bignum.h"
 #include "pkcs1.h"
+#include "rsa-internal.h"
 
 int
 rsa_sha256_verify(const struct rsa_public_key *key,
@@ -77,3 +79,87 @@ rsa_sha256_verify_digest(const struct rsa_public_key *key,
 
   return res;
 }
+
+int
+rsa_prepared_sha256_verify_digest(const struct rsa_prepared_public_key *key,
+				  const uint8_t *digest,
+				  const uint8_t *signature,
+				  mp_limb_t *scratch)
+{
+  uint8_t *em = (uint8_t *) scratch;
+
+  return (_pkcs1_rsa_sha256_encode_digest_em(em, key->size, digest)
+	  && _rsa_prepared_verify (key, em, signature, scratch + key->nn));
+}
+
+int
+rsa_prepared_sha256_verify_digest_batch(const struct rsa_prepared_public_key *key,
+					size_t n,
+					const uint8_t * const *digest,
+					const uint8_t * const *signature,
+					int *valid, mp_limb_t *scratch)
+{
+  const uint8_t *em[RSA_VERIFY_BATCH_SIZE];
+  int res[RSA_VERIFY_BATCH_SIZE];
+  mp_size_t nn = key->nn;
+  size_t i;
+  int all;
+
+  for (i = 0, all = 1; i < n; i += RSA_VERIFY_BATCH_SIZE)
+    {
+      unsigned k = (n - i < RSA_VERIFY_BATCH_SIZE
+		    ? n - i : RSA_VERIFY_BATCH_SIZE);
+      unsigned l;
+
+      for (l = 0; l < k; l++)
+	{
+	  uint8_t *p = (uint8_t *) (scratch + l*nn);
+	  em[l] = (_pkcs1_rsa_sha256_encode_digest_em (p, key->size,
+						       digest[i+l])
+		   ? p : NULL);
+	}
+      all &= _rsa_prepared_verify_n (key, k, em, signature + i, res,
+				     scratch + RSA_VERIFY_BATCH_SIZE*nn);
+      if (valid)
+	memcpy (valid + i, res, k * sizeof(*res));
+    }
+  return all;
+}
+
+int
+rsa_sha256_verify_digest_batch(const struct rsa_public_key *key,
+			       size_t n,
+			       const uint8_t * const *digest,
+			       const uint8_t * const *signature,
+			       int *valid)
+{
+  struct rsa_prepared_public_key prep;
+  size_t i;
+  int all;
+
+  if (rsa_prepared_public_key_init (&prep, key))
+    {
+      TMP_GMP_DECL(scratch, mp_limb_t);
+      TMP_GMP_ALLOC(scratch, rsa_prepared_public_itch (&prep));
+      all = rsa_prepared_sha256_verify_digest_batch (&prep, n, digest,
+						     signature, valid, scratch);
+      TMP_GMP_FREE(scratch);
+    }
+  else
+    {
+      /* Key not supported by the prepared functions. */
+      mpz_t s;
+      mpz_init (s);
+      for (i = 0, all = 1; i < n; i++)
+	{
+	  int res;
+	  nettle_mpz_set_str_256_u (s, key->size, signature[i]);
+	  res = rsa_sha256_verify_digest (key, digest[i], s);
+	  if (valid)
+	    valid[i] = res;
+	  all &= res;
+	}
+      mpz_clear (s);
+    }
+  return all;
+}
@@ -81,3 +81,42 @@ rsa_sha512_sign_digest_tr(const struct rsa_public_key *pub,
   mpz_clear (m);
   return res;
 }
+
+int
+rsa_sha512_sign_digest_blinding_tr(const struct rsa_public_key *pub,
+				   const struct rsa_private_key *key,
+				   struct rsa_blinding_ctx *blinding,
+				   void *random_ctx, nettle_random_func *random,
+				   const uint8_t *digest,
+				   mpz_t s)
+{
+  mpz_t m;
+  int res;
+
+  mpz_init (m);
+
+  res = (pkcs1_rsa_sha512_encode_digest(m, key->size, digest)
+	 && rsa_compute_root_blinding_tr (pub, key, blinding,
+					  random_ctx, random,
+					  s, m));
+
+  mpz_clear (m);
+  return res;
+}
+
+int
+rsa_prepared_sha512_sign_digest_tr(const struct rsa_prepared_private_key *key,
+				   struct rsa_prepared_blinding_ctx *blinding,
+				   void *random_ctx, nettle_random_func *random,
+				   const uint8_t *digest,
+				   uint8_t *signature,
+				   mp_limb_t *scratch)
+{
+  uint8_t *em = (uint8_t *) scratch;
+
+  return (_pkcs1_rsa_sha512_encode_digest_em(em, key->size, digest)
+	  && rsa_prepared_compute_root_tr (key, blinding,
+					   random_ctx, random,
+					   signature, em,
+					   scratch + key->nn));
+}
@@ -77,3 +77,15 @@ rsa_sha512_verify_digest(const struct rsa_public_key *key,
 
   return res;
 }
+
+int
+rsa_prepared_sha512_verify_digest(const struct rsa_prepared_public_key *key,
+				  const uint8_t *digest,
+				  const uint8_t *signature,
+				  mp_limb_t *scratch)
+{
+  uint8_t *em = (uint8_t *) scratch;
+
+  return (_pkcs1_rsa_sha512_encode_digest_em(em, key->size, digest)
+	  && _rsa_prepared_verify (key, em, signature, scratch + key->nn));
+}
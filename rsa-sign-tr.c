@@ -118,3 +118,86 @@ rsa_compute_root_tr(const struct rsa_public_key *pub,
 
   return res;
 }
+
+void
+rsa_blinding_init (struct rsa_blinding_ctx *ctx)
+{
+  mpz_init (ctx->re);
+  mpz_init (ctx->ri);
+  ctx->count = 0;
+}
+
+void
+rsa_blinding_clear (struct rsa_blinding_ctx *ctx)
+{
+  mpz_clear (ctx->re);
+  mpz_clear (ctx->ri);
+}
+
+/* Sets ctx->re = r^e and ctx->ri = r^{-1}, either for a fresh random
+   r, or by squaring the previous r. */
+static void
+rsa_blinding_update (const struct rsa_public_key *pub,
+		     struct rsa_blinding_ctx *ctx,
+		     void *random_ctx, nettle_random_func *random)
+{
+  if (ctx->count > 0)
+    {
+      ctx->count--;
+      mpz_mul (ctx->re, ctx->re, ctx->re);
+      mpz_fdiv_r (ctx->re, ctx->re, pub->n);
+      mpz_mul (ctx->ri, ctx->ri, ctx->ri);
+      mpz_fdiv_r (ctx->ri, ctx->ri, pub->n);
+    }
+  else
+    {
+      do
+	nettle_mpz_random(ctx->re, random_ctx, random, pub->n);
+      while (!mpz_invert (ctx->ri, ctx->re, pub->n));
+
+      mpz_powm_sec (ctx->re, ctx->re, pub->e, pub->n);
+      ctx->count = RSA_BLINDING_UPDATES;
+    }
+}
+
+/* Like rsa_compute_root_tr, but the check is done after unblinding,
+   so that it also catches a blinding context used with the wrong
+   key. */
+int
+rsa_compute_root_blinding_tr(const struct rsa_public_key *pub,
+			     const struct rsa_private_key *key,
+			     struct rsa_blinding_ctx *blinding,
+			     void *random_ctx, nettle_random_func *random,
+			     mpz_t x, const mpz_t m)
+{
+  int res;
+  mpz_t t, xb;
+
+  if (mpz_even_p (pub->n) || mpz_even_p (key->p) || mpz_even_p (key->q))
+    return 0;
+
+  mpz_init (xb);
+  mpz_init (t);
+
+  rsa_blinding_update (pub, blinding, random_ctx, random);
+
+  mpz_mul (t, m, blinding->re);
+  mpz_fdiv_r (t, t, pub->n);
+
+  rsa_compute_root (key, xb, t);
+  rsa_unblind (pub, xb, blinding->ri, xb);
+
+  mpz_powm_sec (t, xb, pub->e, pub->n);
+  res = (mpz_cmp (m, t) == 0);
+
+  if (res)
+    mpz_swap (x, xb);
+  else
+    /* Don't reuse a blinding factor which may be bad. */
+    blinding->count = 0;
+
+  mpz_clear (xb);
+  mpz_clear (t);
+
+  return res;
+}
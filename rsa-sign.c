@@ -38,6 +38,8 @@
 #include "rsa.h"
 
 #include "bignum.h"
+#include "gmp-glue.h"
+#include "rsa-internal.h"
 
 void
 rsa_private_key_init(struct rsa_private_key *key)
@@ -84,6 +86,89 @@ rsa_private_key_prepare(struct rsa_private_key *key)
   return (key->size > 0);
 }
 
+#if NETTLE_USE_MINI_GMP
+/* With mini-gmp, mpz_powm_sec is a plain mpz_powm, which is both slow
+   and not side-channel silent. So use our own mpn exponentiation.
+   With GMP, mpz_powm_sec is faster. */
+static void
+set_modulo (struct rsa_modulo *m, mp_limb_t *rr, mpz_t t, const mpz_t p)
+{
+  mp_size_t n = mpz_size (p);
+
+  mpz_set_ui (t, 1);
+  mpz_mul_2exp (t, t, 2 * n * GMP_NUMB_BITS);
+  mpz_fdiv_r (t, t, p);
+  mpz_limbs_copy (rr, t, n);
+
+  m->size = n;
+  m->minv = rsa_mont_minv (mpz_getlimbn (p, 0));
+  m->m = mpz_limbs_read (p);
+  m->rr = rr;
+  m->rrr = NULL;
+}
+
+/* Computes xp = xp^a mod p and xq = xq^b mod q, interleaving the two
+   exponentiations. Requires odd p and q, xp < p and xq < q. */
+static void
+rsa_powm_pq (const struct rsa_private_key *key, mpz_t xp, mpz_t xq)
+{
+  struct rsa_modulo pm, qm;
+  const struct rsa_modulo *moduli[2];
+  mp_limb_t *xs[2];
+  const mp_limb_t *es[2];
+  mp_size_t ens[2];
+  mp_size_t pn = mpz_size (key->p);
+  mp_size_t qn = mpz_size (key->q);
+  mp_size_t hn = pn > qn ? pn : qn;
+  mp_size_t itch;
+  mp_limb_t *tp;
+  mpz_t t;
+  TMP_GMP_DECL(scratch, mp_limb_t);
+
+  itch = 2*(pn + qn) + RSA_MONT_POWM_SEC_ITCH (pn)
+    + RSA_MONT_POWM_SEC_ITCH (qn) + 2*hn;
+  TMP_GMP_ALLOC(scratch, itch);
+
+  xs[0] = scratch;
+  xs[1] = xs[0] + pn;
+  tp = xs[1] + 2*qn + pn;
+
+  mpz_init (t);
+  set_modulo (&pm, xs[1] + qn, t, key->p);
+  set_modulo (&qm, xs[1] + qn + pn, t, key->q);
+  mpz_clear (t);
+
+  moduli[0] = &pm;
+  moduli[1] = &qm;
+  es[0] = mpz_limbs_read (key->a);
+  es[1] = mpz_limbs_read (key->b);
+  ens[0] = mpz_size (key->a);
+  ens[1] = mpz_size (key->b);
+
+  /* Convert to Montgomery representation, x R = x R^2 / R. */
+  mpz_limbs_copy (xs[0], xp, pn);
+  rsa_mont_mul (&pm, xs[0], xs[0], pm.rr, tp);
+  mpz_limbs_copy (xs[1], xq, qn);
+  rsa_mont_mul (&qm, xs[1], xs[1], qm.rr, tp);
+
+  rsa_mont_powm_sec_n (2, moduli, xs, (const mp_limb_t * const *) xs,
+		       es, ens, tp);
+
+  /* And back. */
+  mpn_copyi (tp, xs[0], pn);
+  mpn_zero (tp + pn, pn);
+  rsa_mont_redc (&pm, xs[0], tp);
+  mpz_set_n (xp, xs[0], pn);
+
+  mpn_copyi (tp, xs[1], qn);
+  mpn_zero (tp + qn, qn);
+  rsa_mont_redc (&qm, xs[1], tp);
+  mpz_set_n (xq, xs[1], qn);
+
+  TMP_GMP_FREE(scratch);
+}
+#endif /* NETTLE_USE_MINI_GMP */
+
 /* Computing an rsa root. */
 void
 rsa_compute_root(const struct rsa_private_key *key,
@@ -96,11 +181,20 @@ rsa_compute_root(const struct rsa_private_key *key,
 
   /* Compute xq = m^d % q = (m%q)^b % q */
   mpz_fdiv_r(xq, m, key->q);
-  mpz_powm_sec(xq, xq, key->b, key->q);
 
   /* Compute xp = m^d % p = (m%p)^a % p */
   mpz_fdiv_r(xp, m, key->p);
-  mpz_powm_sec(xp, xp, key->a, key->p);
+
+#if NETTLE_USE_MINI_GMP
+  /* Even p or q means an invalid key, leave it to mpz_powm_sec. */
+  if (mpz_odd_p (key->p) && mpz_odd_p (key->q))
+    rsa_powm_pq (key, xp, xq);
+  else
+#endif
+    {
+      mpz_powm_sec(xq, xq, key->b, key->q);
+      mpz_powm_sec(xp, xp, key->a, key->p);
+    }
 
   /* Set xp' = (xp - xq) c % p. */
   mpz_sub(xp, xp, xq);
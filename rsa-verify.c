@@ -35,9 +35,13 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
+#include <string.h>
+
 #include "rsa.h"
 
 #include "bignum.h"
+#include "rsa-internal.h"
 
 int
 _rsa_verify(const struct rsa_public_key *key,
@@ -62,3 +66,89 @@ _rsa_verify(const struct rsa_public_key *key,
 
   return res;
 }
+
+/* Verifies k signatures in lock-step. Lanes with em[l] == NULL, e.g.,
+   due to an encoding failure, are rejected without any
+   exponentiation. */
+int
+_rsa_prepared_verify_n(const struct rsa_prepared_public_key *key,
+		       unsigned k, const uint8_t * const *em,
+		       const uint8_t * const *signature,
+		       int *res, mp_limb_t *scratch)
+{
+  struct rsa_modulo nm;
+  mp_limb_t *sp[RSA_VERIFY_BATCH_SIZE];
+  mp_limb_t *yp[RSA_VERIFY_BATCH_SIZE];
+  unsigned lane[RSA_VERIFY_BATCH_SIZE];
+  mp_size_t nn = key->nn;
+  mp_limb_t *tp;
+  unsigned j, l;
+  int all;
+
+  assert (k <= RSA_VERIFY_BATCH_SIZE);
+
+  nm.size = nn;
+  nm.minv = key->ninv;
+  nm.m = key->n;
+  nm.rr = key->n_rr;
+  nm.rrr = NULL;
+
+  /* Collect the lanes with 0 < s < n, compacted to the front. */
+  for (l = j = 0; l < k; l++)
+    {
+      mp_limb_t w;
+      mp_size_t i;
+
+      res[l] = 0;
+      if (!em[l])
+	continue;
+
+      sp[j] = scratch + 2*j*nn;
+      yp[j] = sp[j] + nn;
+      mpn_set_base256 (sp[j], nn, signature[l], key->size);
+      for (i = 0, w = 0; i < nn; i++)
+	w |= sp[j][i];
+      if (w == 0 || mpn_cmp (sp[j], key->n, nn) >= 0)
+	continue;
+
+      lane[j++] = l;
+    }
+  if (j == 0)
+    return 0;
+
+  tp = scratch + 2*j*nn;
+
+  for (l = 0; l < j; l++)
+    rsa_mont_mul (&nm, sp[l], sp[l], key->n_rr, tp);
+
+  /* For the usual e = 65537, the exponentiation is 16 squarings and
+     a single multiplication, plus one multiplication each for
+     conversion to and from Montgomery representation. */
+  rsa_mont_powm_n (j, &nm, yp, (const mp_limb_t * const *) sp,
+		   key->e, key->en, tp);
+
+  for (l = 0; l < j; l++)
+    {
+      mpn_copyi (tp, yp[l], nn);
+      mpn_zero (tp + nn, nn);
+      rsa_mont_redc (&nm, yp[l], tp);
+
+      /* Compare as octet strings, reusing the area of s. */
+      mpn_get_base256 ((uint8_t *) sp[l], key->size, yp[l], nn);
+      res[lane[l]] = (memcmp (sp[l], em[lane[l]], key->size) == 0);
+    }
+
+  for (l = 0, all = 1; l < k; l++)
+    all &= res[l];
+
+  return all;
+}
+
+int
+_rsa_prepared_verify(const struct rsa_prepared_public_key *key,
+		     const uint8_t *em, const uint8_t *signature,
+		     mp_limb_t *scratch)
+{
+  int res;
+  return _rsa_prepared_verify_n (key, 1, &em, &signature, &res, scratch);
+}
@@ -84,6 +84,36 @@ extern "C" {
 #define rsa_decrypt_tr nettle_rsa_decrypt_tr
 #define rsa_compute_root nettle_rsa_compute_root
 #define rsa_compute_root_tr nettle_rsa_compute_root_tr
+#define rsa_blinding_init nettle_rsa_blinding_init
+#define rsa_blinding_clear nettle_rsa_blinding_clear
+#define rsa_compute_root_blinding_tr nettle_rsa_compute_root_blinding_tr
+#define rsa_pkcs1_sign_blinding_tr nettle_rsa_pkcs1_sign_blinding_tr
+#define rsa_md5_sign_digest_blinding_tr nettle_rsa_md5_sign_digest_blinding_tr
+#define rsa_sha1_sign_digest_blinding_tr nettle_rsa_sha1_sign_digest_blinding_tr
+#define rsa_sha256_sign_digest_blinding_tr nettle_rsa_sha256_sign_digest_blinding_tr
+#define rsa_sha512_sign_digest_blinding_tr nettle_rsa_sha512_sign_digest_blinding_tr
+#define rsa_decrypt_blinding_tr nettle_rsa_decrypt_blinding_tr
+#define rsa_prepared_private_key_init nettle_rsa_prepared_private_key_init
+#define rsa_prepared_blinding_init nettle_rsa_prepared_blinding_init
+#define rsa_prepared_itch nettle_rsa_prepared_itch
+#define rsa_prepared_compute_root_tr nettle_rsa_prepared_compute_root_tr
+#define rsa_prepared_pkcs1_sign_tr nettle_rsa_prepared_pkcs1_sign_tr
+#define rsa_prepared_md5_sign_digest_tr nettle_rsa_prepared_md5_sign_digest_tr
+#define rsa_prepared_sha1_sign_digest_tr nettle_rsa_prepared_sha1_sign_digest_tr
+#define rsa_prepared_sha256_sign_digest_tr nettle_rsa_prepared_sha256_sign_digest_tr
+#define rsa_prepared_sha512_sign_digest_tr nettle_rsa_prepared_sha512_sign_digest_tr
+#define rsa_prepared_decrypt_tr nettle_rsa_prepared_decrypt_tr
+#define rsa_prepared_public_key_init nettle_rsa_prepared_public_key_init
+#define rsa_prepared_public_itch nettle_rsa_prepared_public_itch
+#define rsa_prepared_pkcs1_verify nettle_rsa_prepared_pkcs1_verify
+#define rsa_prepared_md5_verify_digest nettle_rsa_prepared_md5_verify_digest
+#define rsa_prepared_sha1_verify_digest nettle_rsa_prepared_sha1_verify_digest
+#define rsa_prepared_sha256_verify_digest nettle_rsa_prepared_sha256_verify_digest
+#define rsa_prepared_sha512_verify_digest nettle_rsa_prepared_sha512_verify_digest
+#define rsa_prepared_pkcs1_verify_batch nettle_rsa_prepared_pkcs1_verify_batch
+#define rsa_prepared_sha256_verify_digest_batch nettle_rsa_prepared_sha256_verify_digest_batch
+#define rsa_pkcs1_verify_batch nettle_rsa_pkcs1_verify_batch
+#define rsa_sha256_verify_digest_batch nettle_rsa_sha256_verify_digest_batch
 #define rsa_generate_keypair nettle_rsa_generate_keypair
 #define rsa_keypair_to_sexp nettle_rsa_keypair_to_sexp
 #define rsa_keypair_from_sexp_alist nettle_rsa_keypair_from_sexp_alist
@@ -93,6 +123,8 @@ extern "C" {
 #define rsa_keypair_from_der nettle_rsa_keypair_from_der
 #define rsa_keypair_to_openpgp nettle_rsa_keypair_to_openpgp
 #define _rsa_verify _nettle_rsa_verify
+#define _rsa_prepared_verify _nettle_rsa_prepared_verify
+#define _rsa_prepared_verify_n _nettle_rsa_prepared_verify_n
 #define _rsa_check_size _nettle_rsa_check_size
 #define _rsa_blind _nettle_rsa_blind
 #define _rsa_unblind _nettle_rsa_unblind
@@ -386,6 +418,315 @@ rsa_compute_root_tr(const struct rsa_public_key *pub,
 		    void *random_ctx, nettle_random_func *random,
 		    mpz_t x, const mpz_t m);
 
+/* Cached blinding factors. Instead of generating and inverting a
+ * fresh random r for each operation, the previous r and r^{-1} are
+ * squared, and a fresh r is generated after RSA_BLINDING_UPDATES
+ * updates. A context belongs to a single key, and is modified by
+ * each operation, so threads sharing a key must use separate
+ * contexts. */
+
+#define RSA_BLINDING_UPDATES 32
+
+struct rsa_blinding_ctx
+{
+  /* r^e mod n */
+  mpz_t re;
+  /* r^{-1} mod n */
+  mpz_t ri;
+  /* Number of updates left before a fresh r is needed */
+  unsigned count;
+};
+
+void
+rsa_blinding_init (struct rsa_blinding_ctx *ctx);
+
+void
+rsa_blinding_clear (struct rsa_blinding_ctx *ctx);
+
+/* Like rsa_compute_root_tr, but using and updating the blinding
+   context. */
+int
+rsa_compute_root_blinding_tr(const struct rsa_public_key *pub,
+			     const struct rsa_private_key *key,
+			     struct rsa_blinding_ctx *blinding,
+			     void *random_ctx, nettle_random_func *random,
+			     mpz_t x, const mpz_t m);
+
+int
+rsa_pkcs1_sign_blinding_tr(const struct rsa_public_key *pub,
+			   const struct rsa_private_key *key,
+			   struct rsa_blinding_ctx *blinding,
+			   void *random_ctx, nettle_random_func *random,
+			   size_t length, const uint8_t *digest_info,
+			   mpz_t s);
+
+int
+rsa_md5_sign_digest_blinding_tr(const struct rsa_public_key *pub,
+				const struct rsa_private_key *key,
+				struct rsa_blinding_ctx *blinding,
+				void *random_ctx, nettle_random_func *random,
+				const uint8_t *digest,
+				mpz_t s);
+
+int
+rsa_sha1_sign_digest_blinding_tr(const struct rsa_public_key *pub,
+				 const struct rsa_private_key *key,
+				 struct rsa_blinding_ctx *blinding,
+				 void *random_ctx, nettle_random_func *random,
+				 const uint8_t *digest,
+				 mpz_t s);
+
+int
+rsa_sha256_sign_digest_blinding_tr(const struct rsa_public_key *pub,
+				   const struct rsa_private_key *key,
+				   struct rsa_blinding_ctx *blinding,
+				   void *random_ctx, nettle_random_func *random,
+				   const uint8_t *digest,
+				   mpz_t s);
+
+int
+rsa_sha512_sign_digest_blinding_tr(const struct rsa_public_key *pub,
+				   const struct rsa_private_key *key,
+				   struct rsa_blinding_ctx *blinding,
+				   void *random_ctx, nettle_random_func *random,
+				   const uint8_t *digest,
+				   mpz_t s);
+
+int
+rsa_decrypt_blinding_tr(const struct rsa_public_key *pub,
+			const struct rsa_private_key *key,
+			struct rsa_blinding_ctx *blinding,
+			void *random_ctx, nettle_random_func *random,
+			size_t *length, uint8_t *message,
+			const mpz_t gibberish);
+
+/* Private keys with all Montgomery constants precomputed, for
+   allocation-free private key operations. The contents are internal,
+   and fixed-size, so the struct can be allocated statically or on the
+   stack. */
+
+#define RSA_PREPARED_MAX_BITS 4096
+
+#define _RSA_PREPARED_LIMBS \
+  ((mp_size_t) (RSA_PREPARED_MAX_BITS / (8 * sizeof (mp_limb_t))))
+#define _RSA_PREPARED_HALF_LIMBS (_RSA_PREPARED_LIMBS / 2 + 1)
+
+struct rsa_prepared_private_key
+{
+  /* Size of the modulo, in octets. */
+  size_t size;
+
+  /* Sizes in limbs of n, e, p and q. */
+  mp_size_t nn, en, pn, qn;
+  unsigned n_bits;
+
+  /* -m^{-1} mod B, for each modulo. */
+  mp_limb_t ninv, pinv, qinv;
+
+  mp_limb_t n[_RSA_PREPARED_LIMBS];
+  /* B^{2 nn} mod n and B^{3 nn} mod n */
+  mp_limb_t n_rr[_RSA_PREPARED_LIMBS];
+  mp_limb_t n_rrr[_RSA_PREPARED_LIMBS];
+  /* (n+1)/2, used when inverting the blinding factor. */
+  mp_limb_t n_mp1h[_RSA_PREPARED_LIMBS];
+  mp_limb_t e[_RSA_PREPARED_LIMBS];
+
+  mp_limb_t p[_RSA_PREPARED_HALF_LIMBS];
+  mp_limb_t p_rr[_RSA_PREPARED_HALF_LIMBS];
+  mp_limb_t p_rrr[_RSA_PREPARED_HALF_LIMBS];
+  mp_limb_t a[_RSA_PREPARED_HALF_LIMBS];
+
+  mp_limb_t q[_RSA_PREPARED_HALF_LIMBS];
+  mp_limb_t q_rr[_RSA_PREPARED_HALF_LIMBS];
+  mp_limb_t q_rrr[_RSA_PREPARED_HALF_LIMBS];
+  mp_limb_t b[_RSA_PREPARED_HALF_LIMBS];
+
+  /* q^{-1} mod p */
+  mp_limb_t c[_RSA_PREPARED_HALF_LIMBS];
+};
+
+/* Cached blinding factors for a prepared key, like struct
+   rsa_blinding_ctx. Stored in Montgomery representation. */
+struct rsa_prepared_blinding_ctx
+{
+  mp_limb_t re[_RSA_PREPARED_LIMBS];
+  mp_limb_t ri[_RSA_PREPARED_LIMBS];
+  unsigned count;
+};
+
+void
+rsa_prepared_blinding_init (struct rsa_prepared_blinding_ctx *ctx);
+
+/* Returns 1 on success. Returns 0 for keys this code can't handle,
+   e.g., larger than RSA_PREPARED_MAX_BITS or with very unbalanced
+   factors; callers should then use the mpz functions. Allocates
+   temporary storage, but the prepared key doesn't reference pub or
+   key afterwards. */
+int
+rsa_prepared_private_key_init (struct rsa_prepared_private_key *prep,
+			       const struct rsa_public_key *pub,
+			       const struct rsa_private_key *key);
+
+/* Scratch space, in limbs, needed by any of the rsa_prepared_*
+   functions below. */
+mp_size_t
+rsa_prepared_itch (const struct rsa_prepared_private_key *key);
+
+/* Like rsa_compute_root_tr, but x and m are octet strings of size
+   key->size, and no memory is allocated. Returns zero on failure,
+   including when m >= n. The blinding context is optional; if NULL,
+   a fresh blinding factor is used. */
+int
+rsa_prepared_compute_root_tr (const struct rsa_prepared_private_key *key,
+			      struct rsa_prepared_blinding_ctx *blinding,
+			      void *random_ctx, nettle_random_func *random,
+			      uint8_t *x, const uint8_t *m,
+			      mp_limb_t *scratch);
+
+int
+rsa_prepared_pkcs1_sign_tr (const struct rsa_prepared_private_key *key,
+			    struct rsa_prepared_blinding_ctx *blinding,
+			    void *random_ctx, nettle_random_func *random,
+			    size_t length, const uint8_t *digest_info,
+			    uint8_t *signature,
+			    mp_limb_t *scratch);
+
+int
+rsa_prepared_md5_sign_digest_tr (const struct rsa_prepared_private_key *key,
+				 struct rsa_prepared_blinding_ctx *blinding,
+				 void *random_ctx, nettle_random_func *random,
+				 const uint8_t *digest,
+				 uint8_t *signature,
+				 mp_limb_t *scratch);
+
+int
+rsa_prepared_sha1_sign_digest_tr (const struct rsa_prepared_private_key *key,
+				  struct rsa_prepared_blinding_ctx *blinding,
+				  void *random_ctx, nettle_random_func *random,
+				  const uint8_t *digest,
+				  uint8_t *signature,
+				  mp_limb_t *scratch);
+
+int
+rsa_prepared_sha256_sign_digest_tr (const struct rsa_prepared_private_key *key,
+				    struct rsa_prepared_blinding_ctx *blinding,
+				    void *random_ctx, nettle_random_func *random,
+				    const uint8_t *digest,
+				    uint8_t *signature,
+				    mp_limb_t *scratch);
+
+int
+rsa_prepared_sha512_sign_digest_tr (const struct rsa_prepared_private_key *key,
+				    struct rsa_prepared_blinding_ctx *blinding,
+				    void *random_ctx, nettle_random_func *random,
+				    const uint8_t *digest,
+				    uint8_t *signature,
+				    mp_limb_t *scratch);
+
+/* The ciphertext is an octet string of size key->size. */
+int
+rsa_prepared_decrypt_tr (const struct rsa_prepared_private_key *key,
+			 struct rsa_prepared_blinding_ctx *blinding,
+			 void *random_ctx, nettle_random_func *random,
+			 size_t *length, uint8_t *message,
+			 const uint8_t *ciphertext,
+			 mp_limb_t *scratch);
+
+/* Public keys with the Montgomery constants for n precomputed, for
+   allocation-free signature verification. */
+struct rsa_prepared_public_key
+{
+  /* Size of the modulo, in octets. */
+  size_t size;
+
+  /* Sizes in limbs of n and e. */
+  mp_size_t nn, en;
+
+  /* -n^{-1} mod B */
+  mp_limb_t ninv;
+
+  mp_limb_t n[_RSA_PREPARED_LIMBS];
+  /* B^{2 nn} mod n */
+  mp_limb_t n_rr[_RSA_PREPARED_LIMBS];
+  mp_limb_t e[_RSA_PREPARED_LIMBS];
+};
+
+/* Returns 1 on success, and 0 for keys larger than
+   RSA_PREPARED_MAX_BITS, or with an even modulo. */
+int
+rsa_prepared_public_key_init (struct rsa_prepared_public_key *prep,
+			      const struct rsa_public_key *pub);
+
+/* Scratch space, in limbs, needed by the rsa_prepared_*_verify and
+   rsa_prepared_*_verify_batch functions. */
+mp_size_t
+rsa_prepared_public_itch (const struct rsa_prepared_public_key *key);
+
+/* The signature is an octet string of size key->size. */
+int
+rsa_prepared_pkcs1_verify (const struct rsa_prepared_public_key *key,
+			   size_t length, const uint8_t *digest_info,
+			   const uint8_t *signature,
+			   mp_limb_t *scratch);
+
+int
+rsa_prepared_md5_verify_digest (const struct rsa_prepared_public_key *key,
+				const uint8_t *digest,
+				const uint8_t *signature,
+				mp_limb_t *scratch);
+
+int
+rsa_prepared_sha1_verify_digest (const struct rsa_prepared_public_key *key,
+				 const uint8_t *digest,
+				 const uint8_t *signature,
+				 mp_limb_t *scratch);
+
+int
+rsa_prepared_sha256_verify_digest (const struct rsa_prepared_public_key *key,
+				   const uint8_t *digest,
+				   const uint8_t *signature,
+				   mp_limb_t *scratch);
+
+int
+rsa_prepared_sha512_verify_digest (const struct rsa_prepared_public_key *key,
+				   const uint8_t *digest,
+				   const uint8_t *signature,
+				   mp_limb_t *scratch);
+
+/* Verifies n signatures made with the same key, processing a few
+   signatures at a time in lock-step. Returns 1 if all signatures are
+   valid. If valid is non-NULL, valid[i] is set to the result for
+   signature i. */
+int
+rsa_prepared_pkcs1_verify_batch (const struct rsa_prepared_public_key *key,
+				 size_t n, size_t length,
+				 const uint8_t * const *digest_info,
+				 const uint8_t * const *signature,
+				 int *valid, mp_limb_t *scratch);
+
+int
+rsa_prepared_sha256_verify_digest_batch (const struct rsa_prepared_public_key *key,
+					 size_t n,
+					 const uint8_t * const *digest,
+					 const uint8_t * const *signature,
+					 int *valid, mp_limb_t *scratch);
+
+/* Like the above, but preparing the key and allocating scratch
+   space. The signatures are octet strings of size key->size. */
+int
+rsa_pkcs1_verify_batch (const struct rsa_public_key *key,
+			size_t n, size_t length,
+			const uint8_t * const *digest_info,
+			const uint8_t * const *signature,
+			int *valid);
+
+int
+rsa_sha256_verify_digest_batch (const struct rsa_public_key *key,
+				size_t n,
+				const uint8_t * const *digest,
+				const uint8_t * const *signature,
+				int *valid);
+
 /* Key generation */
 
 /* Note that the key structs must be initialized first. */
@@ -480,6 +821,22 @@ _rsa_verify(const struct rsa_public_key *key,
 	    const mpz_t m,
 	    const mpz_t s);
 
+/* Checks that signature^e = em mod n, where both are octet strings
+   of size key->size. Needs 4 nn limbs of scratch. */
+int
+_rsa_prepared_verify(const struct rsa_prepared_public_key *key,
+		     const uint8_t *em, const uint8_t *signature,
+		     mp_limb_t *scratch);
+
+/* Like _rsa_prepared_verify, for k signatures, storing each result
+   in res[k], and returning 1 if all are valid. Needs (2k + 2) nn
+   limbs of scratch. */
+int
+_rsa_prepared_verify_n(const struct rsa_prepared_public_key *key,
+		       unsigned k, const uint8_t * const *em,
+		       const uint8_t * const *signature,
+		       int *res, mp_limb_t *scratch);
+
 size_t
 _rsa_check_size(mpz_t n);
 
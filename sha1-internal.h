@@ -0,0 +1,53 @@
+/* sha1-internal.h
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_SHA1_INTERNAL_H_INCLUDED
+#define NETTLE_SHA1_INTERNAL_H_INCLUDED
+
+#include "sha1.h"
+
+/* Name mangling */
+#define _sha1_compress_8 _nettle_sha1_compress_8
+
+/* Compresses the given number of blocks for eight independent
+   messages in parallel, available only in some configurations. The
+   state is transposed, with word j of message i at state[8*j + i].
+   INPUT[i] points to the blocks of message i. */
+#if HAVE_NATIVE_sha1_compress_8
+void
+_sha1_compress_8(uint32_t *state, const uint8_t **input, size_t blocks);
+/* For fat builds */
+void
+_nettle_sha1_compress_8_c(uint32_t *state, const uint8_t **input,
+			  size_t blocks);
+#endif
+
+#endif /* NETTLE_SHA1_INTERNAL_H_INCLUDED */
@@ -41,6 +41,7 @@
 #include <string.h>
 
 #include "sha1.h"
+#include "sha1-internal.h"
 
 #include "macros.h"
 #include "nettle-write.h"
@@ -70,6 +71,13 @@ sha1_init(struct sha1_ctx *ctx)
 
 #define COMPRESS(ctx, data) (_nettle_sha1_compress((ctx)->state, data))
 
+#if HAVE_NATIVE_sha1_compress_8
+/* Number of messages processed in parallel by the _n functions, and
+   the smallest number for which it pays off. */
+# define SHA1_LANES 8
+# define SHA1_MIN_LANES 2
+#endif
+
 void
 sha1_update(struct sha1_ctx *ctx,
 	    size_t length, const uint8_t *data)
@@ -77,15 +85,12 @@ sha1_update(struct sha1_ctx *ctx,
   MD_UPDATE (ctx, length, data, COMPRESS, ctx->count++);
 }
 	  
-void
-sha1_digest(struct sha1_ctx *ctx,
-	    size_t length,
-	    uint8_t *digest)
+/* Pads the final block, leaving it to be compressed. */
+static void
+sha1_pad(struct sha1_ctx *ctx)
 {
   uint64_t bit_count;
 
-  assert(length <= SHA1_DIGEST_SIZE);
-
   MD_PAD(ctx, 8, COMPRESS);
 
   /* There are 512 = 2^9 bits in one block */
@@ -93,8 +98,153 @@ sha1_digest(struct sha1_ctx *ctx,
 
   /* append the 64 bit count */
   WRITE_UINT64(ctx->block + (SHA1_BLOCK_SIZE - 8), bit_count);
+}
+
+void
+sha1_digest(struct sha1_ctx *ctx,
+	    size_t length,
+	    uint8_t *digest)
+{
+  assert(length <= SHA1_DIGEST_SIZE);
+
+  sha1_pad(ctx);
   _nettle_sha1_compress(ctx->state, ctx->block);
 
   _nettle_write_be32(length, digest, ctx->state);
   sha1_init(ctx);
 }
+
+#if HAVE_NATIVE_sha1_compress_8
+/* For fat builds */
+void
+_nettle_sha1_compress_8_c(uint32_t *state, const uint8_t **input,
+			  size_t blocks)
+{
+  unsigned i, j;
+
+  for (i = 0; i < 8; i++)
+    {
+      uint32_t s[_SHA1_DIGEST_LENGTH];
+      size_t b;
+
+      for (j = 0; j < _SHA1_DIGEST_LENGTH; j++)
+	s[j] = state[8*j + i];
+      for (b = 0; b < blocks; b++)
+	_nettle_sha1_compress(s, input[i] + b * SHA1_BLOCK_SIZE);
+      for (j = 0; j < _SHA1_DIGEST_LENGTH; j++)
+	state[8*j + i] = s[j];
+    }
+}
+
+/* Compresses BLOCKS complete blocks from DATA[i] into CTX[i], for
+   the first N <= SHA1_LANES contexts. Unused lanes duplicate the
+   first message. */
+static void
+sha1_compress_lanes(unsigned n, struct sha1_ctx **ctx,
+		    const uint8_t **data, size_t blocks)
+{
+  uint32_t state[SHA1_LANES * _SHA1_DIGEST_LENGTH];
+  const uint8_t *input[SHA1_LANES];
+  unsigned i, j;
+
+  for (i = 0; i < SHA1_LANES; i++)
+    {
+      const struct sha1_ctx *c = ctx[i < n ? i : 0];
+      for (j = 0; j < _SHA1_DIGEST_LENGTH; j++)
+	state[SHA1_LANES*j + i] = c->state[j];
+      input[i] = data[i < n ? i : 0];
+    }
+
+  _sha1_compress_8 (state, input, blocks);
+
+  for (i = 0; i < n; i++)
+    {
+      for (j = 0; j < _SHA1_DIGEST_LENGTH; j++)
+	ctx[i]->state[j] = state[SHA1_LANES*j + i];
+      ctx[i]->count += blocks;
+    }
+}
+
+static void
+sha1_update_lanes(unsigned n, struct sha1_ctx **ctx,
+		  size_t length, const uint8_t **data)
+{
+  const uint8_t *p[SHA1_LANES];
+  size_t left[SHA1_LANES];
+  size_t blocks;
+  unsigned i;
+
+  /* Complete any partial blocks one message at a time. Then the
+     messages may have slightly different numbers of complete blocks
+     left, and those in common are processed in parallel. */
+  for (i = 0, blocks = length / SHA1_BLOCK_SIZE; i < n; i++)
+    {
+      size_t fill = 0;
+      if (ctx[i]->index > 0)
+	{
+	  fill = SHA1_BLOCK_SIZE - ctx[i]->index;
+	  if (fill > length)
+	    fill = length;
+	  sha1_update (ctx[i], fill, data[i]);
+	}
+      p[i] = data[i] + fill;
+      left[i] = length - fill;
+      if (left[i] / SHA1_BLOCK_SIZE < blocks)
+	blocks = left[i] / SHA1_BLOCK_SIZE;
+    }
+
+  if (blocks > 0)
+    sha1_compress_lanes (n, ctx, p, blocks);
+
+  for (i = 0; i < n; i++)
+    sha1_update (ctx[i], left[i] - blocks * SHA1_BLOCK_SIZE,
+		 p[i] + blocks * SHA1_BLOCK_SIZE);
+}
+#endif /* HAVE_NATIVE_sha1_compress_8 */
+
+void
+sha1_update_n(unsigned n, struct sha1_ctx **ctx,
+	      size_t length, const uint8_t **data)
+{
+#if HAVE_NATIVE_sha1_compress_8
+  while (n >= SHA1_MIN_LANES)
+    {
+      unsigned m = n < SHA1_LANES ? n : SHA1_LANES;
+      sha1_update_lanes (m, ctx, length, data);
+      n -= m; ctx += m; data += m;
+    }
+#endif
+  for (; n > 0; n--)
+    sha1_update (*ctx++, length, *data++);
+}
+
+void
+sha1_digest_n(unsigned n, struct sha1_ctx **ctx,
+	      size_t length, uint8_t **digest)
+{
+#if HAVE_NATIVE_sha1_compress_8
+  while (n >= SHA1_MIN_LANES)
+    {
+      unsigned m = n < SHA1_LANES ? n : SHA1_LANES;
+      const uint8_t *input[SHA1_LANES];
+      unsigned i;
+
+      assert(length <= SHA1_DIGEST_SIZE);
+
+      for (i = 0; i < m; i++)
+	{
+	  sha1_pad (ctx[i]);
+	  input[i] = ctx[i]->block;
+	}
+      sha1_compress_lanes (m, ctx, input, 1);
+      for (i = 0; i < m; i++)
+	{
+	  _nettle_write_be32(length, digest[i], ctx[i]->state);
+	  sha1_init (ctx[i]);
+	}
+      n -= m; ctx += m; digest += m;
+    }
+#endif
+  for (; n > 0; n--)
+    sha1_digest (*ctx++, length, *digest++);
+}
@@ -44,6 +44,8 @@ extern "C" {
 #define sha1_init nettle_sha1_init
 #define sha1_update nettle_sha1_update
 #define sha1_digest nettle_sha1_digest
+#define sha1_update_n nettle_sha1_update_n
+#define sha1_digest_n nettle_sha1_digest_n
 
 /* SHA1 */
 
@@ -76,6 +78,18 @@ sha1_digest(struct sha1_ctx *ctx,
 	    size_t length,
 	    uint8_t *digest);
 
+/* Processes N independent messages, several at a time when
+   possible. Each CTX[i] is updated with LENGTH octets from DATA[i],
+   or its digest is written to DIGEST[i]. The results are the same as
+   for the single message functions. */
+void
+sha1_update_n(unsigned n, struct sha1_ctx **ctx,
+	      size_t length, const uint8_t **data);
+
+void
+sha1_digest_n(unsigned n, struct sha1_ctx **ctx,
+	      size_t length, uint8_t **digest);
+
 /* Internal compression function. STATE points to 5 uint32_t words,
    and DATA points to 64 bytes of input data, possibly unaligned. */
 void
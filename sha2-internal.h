@@ -0,0 +1,67 @@
+/* sha2-internal.h
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_SHA2_INTERNAL_H_INCLUDED
+#define NETTLE_SHA2_INTERNAL_H_INCLUDED
+
+#include "sha2.h"
+
+/* Name mangling */
+#define _sha256_compress_8 _nettle_sha256_compress_8
+#define _sha512_compress_4 _nettle_sha512_compress_4
+
+/* Compresses the given number of blocks for eight independent
+   messages in parallel, available only in some configurations. The
+   state is transposed, with word j of message i at state[8*j + i].
+   INPUT[i] points to the blocks of message i. */
+#if HAVE_NATIVE_sha256_compress_8
+void
+_sha256_compress_8(uint32_t *state, const uint8_t **input,
+		   size_t blocks, const uint32_t *k);
+/* For fat builds */
+void
+_nettle_sha256_compress_8_c(uint32_t *state, const uint8_t **input,
+			    size_t blocks, const uint32_t *k);
+#endif
+
+/* Like _sha256_compress_8, but for four SHA512 messages, with word j
+   of message i at state[4*j + i]. */
+#if HAVE_NATIVE_sha512_compress_4
+void
+_sha512_compress_4(uint64_t *state, const uint8_t **input,
+		   size_t blocks, const uint64_t *k);
+/* For fat builds */
+void
+_nettle_sha512_compress_4_c(uint64_t *state, const uint8_t **input,
+			    size_t blocks, const uint64_t *k);
+#endif
+
+#endif /* NETTLE_SHA2_INTERNAL_H_INCLUDED */
@@ -43,14 +43,20 @@ extern "C" {
 /* Name mangling */
 #define sha224_init nettle_sha224_init
 #define sha224_digest nettle_sha224_digest
+#define sha224_digest_n nettle_sha224_digest_n
 #define sha256_init nettle_sha256_init
 #define sha256_update nettle_sha256_update
 #define sha256_digest nettle_sha256_digest
+#define sha256_update_n nettle_sha256_update_n
+#define sha256_digest_n nettle_sha256_digest_n
 #define sha384_init nettle_sha384_init
 #define sha384_digest nettle_sha384_digest
+#define sha384_digest_n nettle_sha384_digest_n
 #define sha512_init nettle_sha512_init
 #define sha512_update nettle_sha512_update
 #define sha512_digest nettle_sha512_digest
+#define sha512_update_n nettle_sha512_update_n
+#define sha512_digest_n nettle_sha512_digest_n
 #define sha512_224_init   nettle_sha512_224_init
 #define sha512_224_digest nettle_sha512_224_digest
 #define sha512_256_init   nettle_sha512_256_init
@@ -91,6 +97,18 @@ sha256_digest(struct sha256_ctx *ctx,
 	      size_t length,
 	      uint8_t *digest);
 
+/* Processes N independent messages, several at a time when
+   possible. Each CTX[i] is updated with LENGTH octets from DATA[i],
+   or its digest is written to DIGEST[i]. The results are the same as
+   for the single message functions. */
+void
+sha256_update_n(unsigned n, struct sha256_ctx **ctx,
+		size_t length, const uint8_t **data);
+
+void
+sha256_digest_n(unsigned n, struct sha256_ctx **ctx,
+		size_t length, uint8_t **digest);
+
 /* Internal compression function. STATE points to 8 uint32_t words,
    DATA points to 64 bytes of input data, possibly unaligned, and K
    points to the table of constants. */
@@ -114,6 +132,12 @@ sha224_digest(struct sha256_ctx *ctx,
 	      size_t length,
 	      uint8_t *digest);
 
+#define sha224_update_n nettle_sha256_update_n
+
+void
+sha224_digest_n(unsigned n, struct sha256_ctx **ctx,
+		size_t length, uint8_t **digest);
+
 
 /* SHA512 */
 
@@ -144,6 +168,15 @@ sha512_digest(struct sha512_ctx *ctx,
 	      size_t length,
 	      uint8_t *digest);
 
+/* Like sha256_update_n and sha256_digest_n. */
+void
+sha512_update_n(unsigned n, struct sha512_ctx **ctx,
+		size_t length, const uint8_t **data);
+
+void
+sha512_digest_n(unsigned n, struct sha512_ctx **ctx,
+		size_t length, uint8_t **digest);
+
 /* Internal compression function. STATE points to 8 uint64_t words,
    DATA points to 128 bytes of input data, possibly unaligned, and K
    points to the table of constants. */
@@ -167,6 +200,12 @@ sha384_digest(struct sha512_ctx *ctx,
 	      size_t length,
 	      uint8_t *digest);
 
+#define sha384_update_n nettle_sha512_update_n
+
+void
+sha384_digest_n(unsigned n, struct sha512_ctx **ctx,
+		size_t length, uint8_t **digest);
+
 
 /* SHA512_224 and SHA512_256, two truncated versions of SHA512 
    with different initial states. */
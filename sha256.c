@@ -43,6 +43,7 @@
 #include <string.h>
 
 #include "sha2.h"
+#include "sha2-internal.h"
 
 #include "macros.h"
 #include "nettle-write.h"
@@ -71,6 +72,13 @@ K[64] =
 
 #define COMPRESS(ctx, data) (_nettle_sha256_compress((ctx)->state, (data), K))
 
+#if HAVE_NATIVE_sha256_compress_8
+/* Number of messages processed in parallel by the _n functions, and
+   the smallest number for which it pays off. */
+# define SHA256_LANES 8
+# define SHA256_MIN_LANES 2
+#endif
+
 /* Initialize the SHA values */
 
 void
@@ -99,15 +107,12 @@ sha256_update(struct sha256_ctx *ctx,
   MD_UPDATE (ctx, length, data, COMPRESS, ctx->count++);
 }
 
+/* Pads the final block, leaving it to be compressed. */
 static void
-sha256_write_digest(struct sha256_ctx *ctx,
-		    size_t length,
-		    uint8_t *digest)
+sha256_pad(struct sha256_ctx *ctx)
 {
   uint64_t bit_count;
 
-  assert(length <= SHA256_DIGEST_SIZE);
-
   MD_PAD(ctx, 8, COMPRESS);
 
   /* There are 512 = 2^9 bits in one block */  
@@ -117,6 +122,16 @@ sha256_write_digest(struct sha256_ctx *ctx,
      big-endian format, and will be converted back by the compression
      function. It's probably not worth the effort to fix this. */
   WRITE_UINT64(ctx->block + (SHA256_BLOCK_SIZE - 8), bit_count);
+}
+
+static void
+sha256_write_digest(struct sha256_ctx *ctx,
+		    size_t length,
+		    uint8_t *digest)
+{
+  assert(length <= SHA256_DIGEST_SIZE);
+
+  sha256_pad(ctx);
   COMPRESS(ctx, ctx->block);
 
   _nettle_write_be32(length, digest, ctx->state);
@@ -160,3 +175,166 @@ sha224_digest(struct sha256_ctx *ctx,
   sha256_write_digest(ctx, length, digest);
   sha224_init(ctx);
 }
+
+#if HAVE_NATIVE_sha256_compress_8
+/* For fat builds */
+void
+_nettle_sha256_compress_8_c(uint32_t *state, const uint8_t **input,
+			    size_t blocks, const uint32_t *k)
+{
+  unsigned i, j;
+
+  for (i = 0; i < 8; i++)
+    {
+      uint32_t s[_SHA256_DIGEST_LENGTH];
+      size_t b;
+
+      for (j = 0; j < _SHA256_DIGEST_LENGTH; j++)
+	s[j] = state[8*j + i];
+      for (b = 0; b < blocks; b++)
+	_nettle_sha256_compress(s, input[i] + b * SHA256_BLOCK_SIZE, k);
+      for (j = 0; j < _SHA256_DIGEST_LENGTH; j++)
+	state[8*j + i] = s[j];
+    }
+}
+
+/* Compresses BLOCKS complete blocks from DATA[i] into CTX[i], for
+   the first N <= SHA256_LANES contexts. Unused lanes duplicate the
+   first message. */
+static void
+sha256_compress_lanes(unsigned n, struct sha256_ctx **ctx,
+		      const uint8_t **data, size_t blocks)
+{
+  uint32_t state[SHA256_LANES * _SHA256_DIGEST_LENGTH];
+  const uint8_t *input[SHA256_LANES];
+  unsigned i, j;
+
+  for (i = 0; i < SHA256_LANES; i++)
+    {
+      const struct sha256_ctx *c = ctx[i < n ? i : 0];
+      for (j = 0; j < _SHA256_DIGEST_LENGTH; j++)
+	state[SHA256_LANES*j + i] = c->state[j];
+      input[i] = data[i < n ? i : 0];
+    }
+
+  _sha256_compress_8 (state, input, blocks, K);
+
+  for (i = 0; i < n; i++)
+    {
+      for (j = 0; j < _SHA256_DIGEST_LENGTH; j++)
+	ctx[i]->state[j] = state[SHA256_LANES*j + i];
+      ctx[i]->count += blocks;
+    }
+}
+
+static void
+sha256_update_lanes(unsigned n, struct sha256_ctx **ctx,
+		    size_t length, const uint8_t **data)
+{
+  const uint8_t *p[SHA256_LANES];
+  size_t left[SHA256_LANES];
+  size_t blocks;
+  unsigned i;
+
+  /* Complete any partial blocks one message at a time. Then the
+     messages may have slightly different numbers of complete blocks
+     left, and those in common are processed in parallel. */
+  for (i = 0, blocks = length / SHA256_BLOCK_SIZE; i < n; i++)
+    {
+      size_t fill = 0;
+      if (ctx[i]->index > 0)
+	{
+	  fill = SHA256_BLOCK_SIZE - ctx[i]->index;
+	  if (fill > length)
+	    fill = length;
+	  sha256_update (ctx[i], fill, data[i]);
+	}
+      p[i] = data[i] + fill;
+      left[i] = length - fill;
+      if (left[i] / SHA256_BLOCK_SIZE < blocks)
+	blocks = left[i] / SHA256_BLOCK_SIZE;
+    }
+
+  if (blocks > 0)
+    sha256_compress_lanes (n, ctx, p, blocks);
+
+  for (i = 0; i < n; i++)
+    sha256_update (ctx[i], left[i] - blocks * SHA256_BLOCK_SIZE,
+		   p[i] + blocks * SHA256_BLOCK_SIZE);
+}
+
+static void
+sha256_write_digest_lanes(unsigned n, struct sha256_ctx **ctx,
+			  size_t length, uint8_t **digest)
+{
+  const uint8_t *input[SHA256_LANES];
+  unsigned i;
+
+  assert(length <= SHA256_DIGEST_SIZE);
+
+  for (i = 0; i < n; i++)
+    {
+      sha256_pad (ctx[i]);
+      input[i] = ctx[i]->block;
+    }
+
+  sha256_compress_lanes (n, ctx, input, 1);
+
+  for (i = 0; i < n; i++)
+    _nettle_write_be32(length, digest[i], ctx[i]->state);
+}
+#endif /* HAVE_NATIVE_sha256_compress_8 */
+
+void
+sha256_update_n(unsigned n, struct sha256_ctx **ctx,
+		size_t length, const uint8_t **data)
+{
+#if HAVE_NATIVE_sha256_compress_8
+  while (n >= SHA256_MIN_LANES)
+    {
+      unsigned m = n < SHA256_LANES ? n : SHA256_LANES;
+      sha256_update_lanes (m, ctx, length, data);
+      n -= m; ctx += m; data += m;
+    }
+#endif
+  for (; n > 0; n--)
+    sha256_update (*ctx++, length, *data++);
+}
+
+void
+sha256_digest_n(unsigned n, struct sha256_ctx **ctx,
+		size_t length, uint8_t **digest)
+{
+#if HAVE_NATIVE_sha256_compress_8
+  while (n >= SHA256_MIN_LANES)
+    {
+      unsigned m = n < SHA256_LANES ? n : SHA256_LANES;
+      unsigned i;
+      sha256_write_digest_lanes (m, ctx, length, digest);
+      for (i = 0; i < m; i++)
+	sha256_init (ctx[i]);
+      n -= m; ctx += m; digest += m;
+    }
+#endif
+  for (; n > 0; n--)
+    sha256_digest (*ctx++, length, *digest++);
+}
+
+void
+sha224_digest_n(unsigned n, struct sha256_ctx **ctx,
+		size_t length, uint8_t **digest)
+{
+#if HAVE_NATIVE_sha256_compress_8
+  while (n >= SHA256_MIN_LANES)
+    {
+      unsigned m = n < SHA256_LANES ? n : SHA256_LANES;
+      unsigned i;
+      sha256_write_digest_lanes (m, ctx, length, digest);
+      for (i = 0; i < m; i++)
+	sha224_init (ctx[i]);
+      n -= m; ctx += m; digest += m;
+    }
+#endif
+  for (; n > 0; n--)
+    sha224_digest (*ctx++, length, *digest++);
+}
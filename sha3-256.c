@@ -39,6 +39,7 @@
 #include <string.h>
 
 #include "sha3.h"
+#include "sha3-internal.h"
 
 #include "nettle-write.h"
 
@@ -66,3 +67,121 @@ sha3_256_digest(struct sha3_256_ctx *ctx,
   _nettle_write_le64 (length, digest, ctx->state.a);
   sha3_256_init (ctx);
 }
+
+void
+sha3_256_shake (struct sha3_256_ctx *ctx,
+		size_t length,
+		uint8_t *digest)
+{
+  sha3_256_shake_output (ctx, length, digest);
+  sha3_256_init (ctx);
+}
+
+void
+sha3_256_shake_output (struct sha3_256_ctx *ctx,
+		       size_t length,
+		       uint8_t *digest)
+{
+  ctx->index = _sha3_shake_output (&ctx->state, SHA3_256_BLOCK_SIZE,
+				   ctx->block, ctx->index, length, digest);
+}
+
+#if HAVE_NATIVE_sha3_permute_4
+/* The smallest number of messages for which the parallel code pays
+   off. */
+#define SHA3_256_MIN_LANES 2
+
+static void
+sha3_256_update_lanes (unsigned n, struct sha3_256_ctx **ctx,
+		       size_t length, const uint8_t **data)
+{
+  struct sha3_state *state[SHA3_LANES];
+  const uint8_t *p[SHA3_LANES];
+  size_t left[SHA3_LANES];
+  size_t blocks;
+  unsigned i;
+
+  /* As for sha256_update_n, complete partial blocks one message at a
+     time, and process the complete blocks in common in parallel. */
+  for (i = 0, blocks = length / SHA3_256_BLOCK_SIZE; i < n; i++)
+    {
+      size_t fill = 0;
+      if (ctx[i]->index > 0)
+	{
+	  fill = SHA3_256_BLOCK_SIZE - ctx[i]->index;
+	  if (fill > length)
+	    fill = length;
+	  sha3_256_update (ctx[i], fill, data[i]);
+	}
+      state[i] = &ctx[i]->state;
+      p[i] = data[i] + fill;
+      left[i] = length - fill;
+      if (left[i] / SHA3_256_BLOCK_SIZE < blocks)
+	blocks = left[i] / SHA3_256_BLOCK_SIZE;
+    }
+
+  if (blocks > 0)
+    _sha3_absorb_lanes (n, state, SHA3_256_BLOCK_SIZE, blocks, p);
+
+  for (i = 0; i < n; i++)
+    sha3_256_update (ctx[i], left[i] - blocks * SHA3_256_BLOCK_SIZE,
+		     p[i] + blocks * SHA3_256_BLOCK_SIZE);
+}
+
+static void
+sha3_256_digest_lanes (unsigned n, struct sha3_256_ctx **ctx,
+		       size_t length, uint8_t **digest)
+{
+  struct sha3_state *state[SHA3_LANES];
+  const uint8_t *input[SHA3_LANES];
+  unsigned i;
+
+  for (i = 0; i < n; i++)
+    {
+      _sha3_pad_block (SHA3_256_BLOCK_SIZE, ctx[i]->block, ctx[i]->index,
+		       SHA3_HASH_MAGIC);
+      state[i] = &ctx[i]->state;
+      input[i] = ctx[i]->block;
+    }
+
+  _sha3_absorb_lanes (n, state, SHA3_256_BLOCK_SIZE, 1, input);
+
+  for (i = 0; i < n; i++)
+    {
+      _nettle_write_le64 (length, digest[i], ctx[i]->state.a);
+      sha3_256_init (ctx[i]);
+    }
+}
+#endif /* HAVE_NATIVE_sha3_permute_4 */
+
+void
+sha3_256_update_n (unsigned n, struct sha3_256_ctx **ctx,
+		   size_t length, const uint8_t **data)
+{
+#if HAVE_NATIVE_sha3_permute_4
+  while (n >= SHA3_256_MIN_LANES)
+    {
+      unsigned m = n < SHA3_LANES ? n : SHA3_LANES;
+      sha3_256_update_lanes (m, ctx, length, data);
+      n -= m; ctx += m; data += m;
+    }
+#endif
+  for (; n > 0; n--)
+    sha3_256_update (*ctx++, length, *data++);
+}
+
+void
+sha3_256_digest_n (unsigned n, struct sha3_256_ctx **ctx,
+		   size_t length, uint8_t **digest)
+{
+#if HAVE_NATIVE_sha3_permute_4
+  while (n >= SHA3_256_MIN_LANES)
+    {
+      unsigned m = n < SHA3_LANES ? n : SHA3_LANES;
+      sha3_256_digest_lanes (m, ctx, length, digest);
+      n -= m; ctx += m; digest += m;
+    }
+#endif
+  for (; n > 0; n--)
+    sha3_256_digest (*ctx++, length, *digest++);
+}
@@ -0,0 +1,92 @@
+/* sha3-internal.h
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_SHA3_INTERNAL_H_INCLUDED
+#define NETTLE_SHA3_INTERNAL_H_INCLUDED
+
+#include "sha3.h"
+
+/* Name mangling */
+#define _sha3_pad_block _nettle_sha3_pad_block
+#define _sha3_pad_shake _nettle_sha3_pad_shake
+#define _sha3_shake_output _nettle_sha3_shake_output
+#define _sha3_permute_4 _nettle_sha3_permute_4
+#define _sha3_absorb_lanes _nettle_sha3_absorb_lanes
+
+/* Domain separation bits and first padding bit, for the hash
+   functions and for the SHAKE extendable output functions. */
+#define SHA3_HASH_MAGIC 6
+#define SHA3_SHAKE_MAGIC 0x1f
+
+/* Set in the index of a context which is producing SHAKE output.
+   The remaining bits are the number of octets of the current output
+   block, in the context's block buffer, that have been used. */
+#define SHA3_SHAKE_OUTPUT_FLAG 0x80000000U
+
+/* Pads the final block, leaving it to be absorbed. */
+void
+_sha3_pad_block (unsigned block_size, uint8_t *block, unsigned pos,
+		 uint8_t magic);
+
+void
+_sha3_pad_shake (struct sha3_state *state,
+		 unsigned block_size, uint8_t *block, unsigned pos);
+
+/* Writes LENGTH octets of SHAKE output to DST, first padding the
+   input if INDEX doesn't have the SHA3_SHAKE_OUTPUT_FLAG set.
+   Returns the new index. */
+unsigned
+_sha3_shake_output (struct sha3_state *state,
+		    unsigned block_size, uint8_t *block,
+		    unsigned index,
+		    size_t length, uint8_t *dst);
+
+/* Applies the permutation to four independent states, available
+   only in some configurations. The states are interleaved, with word
+   i of state j at state[4*i + j]. */
+#if HAVE_NATIVE_sha3_permute_4
+#define SHA3_LANES 4
+
+void
+_sha3_permute_4 (uint64_t *state);
+/* For fat builds */
+void
+_nettle_sha3_permute_4_c (uint64_t *state);
+
+/* Absorbs BLOCKS complete blocks from DATA[i] into STATE[i], for the
+   first N <= SHA3_LANES states. */
+void
+_sha3_absorb_lanes (unsigned n, struct sha3_state **state,
+		    unsigned block_size, size_t blocks,
+		    const uint8_t **data);
+#endif
+
+#endif /* NETTLE_SHA3_INTERNAL_H_INCLUDED */
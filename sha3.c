@@ -39,9 +39,11 @@
 #include <string.h>
 
 #include "sha3.h"
+#include "sha3-internal.h"
 
 #include "macros.h"
 #include "memxor.h"
+#include "nettle-write.h"
 
 static void
 sha3_absorb (struct sha3_state *state, unsigned length, const uint8_t *data)
@@ -90,14 +92,129 @@ _sha3_update (struct sha3_state *state,
 }
 
 void
-_sha3_pad (struct sha3_state *state,
-	   unsigned block_size, uint8_t *block, unsigned pos)
+_sha3_pad_block (unsigned block_size, uint8_t *block, unsigned pos,
+		 uint8_t magic)
 {
   assert (pos < block_size);
-  block[pos++] = 6;
+  block[pos++] = magic;
 
   memset (block + pos, 0, block_size - pos);
   block[block_size - 1] |= 0x80;
+}
 
+void
+_sha3_pad (struct sha3_state *state,
+	   unsigned block_size, uint8_t *block, unsigned pos)
+{
+  _sha3_pad_block (block_size, block, pos, SHA3_HASH_MAGIC);
   sha3_absorb (state, block_size, block);  
 }
+
+void
+_sha3_pad_shake (struct sha3_state *state,
+		 unsigned block_size, uint8_t *block, unsigned pos)
+{
+  _sha3_pad_block (block_size, block, pos, SHA3_SHAKE_MAGIC);
+  sha3_absorb (state, block_size, block);
+}
+
+unsigned
+_sha3_shake_output (struct sha3_state *state,
+		    unsigned block_size, uint8_t *block,
+		    unsigned index,
+		    size_t length, uint8_t *dst)
+{
+  unsigned left;
+
+  if (index & SHA3_SHAKE_OUTPUT_FLAG)
+    index &= ~SHA3_SHAKE_OUTPUT_FLAG;
+  else
+    {
+      /* First call, pad the input, and make the first output block
+	 available. */
+      _sha3_pad_shake (state, block_size, block, index);
+      _nettle_write_le64 (block_size, block, state->a);
+      index = 0;
+    }
+
+  assert (index <= block_size);
+  left = block_size - index;
+  if (length <= left)
+    {
+      memcpy (dst, block + index, length);
+      return (index + length) | SHA3_SHAKE_OUTPUT_FLAG;
+    }
+  memcpy (dst, block + index, left);
+  length -= left;
+  dst += left;
+
+  for (; length > block_size; length -= block_size, dst += block_size)
+    {
+      sha3_permute (state);
+      _nettle_write_le64 (block_size, dst, state->a);
+    }
+
+  sha3_permute (state);
+  _nettle_write_le64 (block_size, block, state->a);
+  memcpy (dst, block, length);
+  return length | SHA3_SHAKE_OUTPUT_FLAG;
+}
+
+#if HAVE_NATIVE_sha3_permute_4
+/* For fat builds */
+void
+_nettle_sha3_permute_4_c (uint64_t *state)
+{
+  unsigned i, j;
+
+  for (j = 0; j < 4; j++)
+    {
+      struct sha3_state s;
+
+      for (i = 0; i < SHA3_STATE_LENGTH; i++)
+	s.a[i] = state[4*i + j];
+      sha3_permute (&s);
+      for (i = 0; i < SHA3_STATE_LENGTH; i++)
+	state[4*i + j] = s.a[i];
+    }
+}
+
+void
+_sha3_absorb_lanes (unsigned n, struct sha3_state **state,
+		    unsigned block_size, size_t blocks,
+		    const uint8_t **data)
+{
+  uint64_t a[SHA3_LANES * SHA3_STATE_LENGTH];
+  const uint8_t *p[SHA3_LANES];
+  unsigned words = block_size / 8;
+  unsigned i, j;
+
+  assert (n <= SHA3_LANES);
+  assert ( (block_size & 7) == 0);
+
+  /* Unused lanes duplicate the first state. */
+  for (j = 0; j < SHA3_LANES; j++)
+    {
+      const struct sha3_state *s = state[j < n ? j : 0];
+      for (i = 0; i < SHA3_STATE_LENGTH; i++)
+	a[SHA3_LANES*i + j] = s->a[i];
+      p[j] = data[j < n ? j : 0];
+    }
+
+  for (; blocks > 0; blocks--)
+    {
+      for (j = 0; j < SHA3_LANES; j++)
+	{
+	  for (i = 0; i < words; i++)
+	    a[SHA3_LANES*i + j] ^= LE_READ_UINT64 (p[j] + 8*i);
+	  p[j] += block_size;
+	}
+
+      _sha3_permute_4 (a);
+    }
+
+  for (j = 0; j < n; j++)
+    for (i = 0; i < SHA3_STATE_LENGTH; i++)
+      state[j]->a[i] = a[SHA3_LANES*i + j];
+}
+#endif /* HAVE_NATIVE_sha3_permute_4 */
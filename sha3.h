@@ -44,12 +44,20 @@ extern "C" {
 #define sha3_permute nettle_sha3_permute
 #define _sha3_update _nettle_sha3_update
 #define _sha3_pad _nettle_sha3_pad
+#define sha3_128_init nettle_sha3_128_init
+#define sha3_128_update nettle_sha3_128_update
+#define sha3_128_shake nettle_sha3_128_shake
+#define sha3_128_shake_output nettle_sha3_128_shake_output
 #define sha3_224_init nettle_sha3_224_init
 #define sha3_224_update nettle_sha3_224_update
 #define sha3_224_digest nettle_sha3_224_digest
 #define sha3_256_init nettle_sha3_256_init
 #define sha3_256_update nettle_sha3_256_update
 #define sha3_256_digest nettle_sha3_256_digest
+#define sha3_256_update_n nettle_sha3_256_update_n
+#define sha3_256_digest_n nettle_sha3_256_digest_n
+#define sha3_256_shake nettle_sha3_256_shake
+#define sha3_256_shake_output nettle_sha3_256_shake_output
 #define sha3_384_init nettle_sha3_384_init
 #define sha3_384_update nettle_sha3_384_update
 #define sha3_384_digest nettle_sha3_384_digest
@@ -88,6 +96,9 @@ _sha3_pad (struct sha3_state *state,
    The "rate" is the width - capacity, or width - 2 * (digest
    size). */
 
+/* For SHAKE128, the capacity is 256 bits. */
+#define SHA3_128_BLOCK_SIZE 168
+
 #define SHA3_224_DIGEST_SIZE 28
 #define SHA3_224_BLOCK_SIZE 144
 
@@ -106,6 +117,36 @@ _sha3_pad (struct sha3_state *state,
 #define SHA3_384_DATA_SIZE SHA3_384_BLOCK_SIZE
 #define SHA3_512_DATA_SIZE SHA3_512_BLOCK_SIZE
 
+/* SHAKE128, with output of arbitrary length. */
+struct sha3_128_ctx
+{
+  struct sha3_state state;
+  unsigned index;
+  uint8_t block[SHA3_128_BLOCK_SIZE];
+};
+
+void
+sha3_128_init (struct sha3_128_ctx *ctx);
+
+void
+sha3_128_update (struct sha3_128_ctx *ctx,
+		 size_t length,
+		 const uint8_t *data);
+
+/* Produces LENGTH octets of output, and resets the context. */
+void
+sha3_128_shake (struct sha3_128_ctx *ctx,
+		size_t length,
+		uint8_t *digest);
+
+/* Produces LENGTH octets of output, continuing where the previous
+   call left off. No more data can be added until the context is
+   reset by sha3_128_init or sha3_128_shake. */
+void
+sha3_128_shake_output (struct sha3_128_ctx *ctx,
+		       size_t length,
+		       uint8_t *digest);
+
 struct sha3_224_ctx
 {
   struct sha3_state state;
@@ -146,6 +187,28 @@ sha3_256_digest(struct sha3_256_ctx *ctx,
 		size_t length,
 		uint8_t *digest);
 
+/* Processes N independent messages, several at a time when
+   possible, as for sha256_update_n and sha256_digest_n. */
+void
+sha3_256_update_n (unsigned n, struct sha3_256_ctx **ctx,
+		   size_t length, const uint8_t **data);
+
+void
+sha3_256_digest_n (unsigned n, struct sha3_256_ctx **ctx,
+		   size_t length, uint8_t **digest);
+
+/* SHAKE256, using the same context. Like sha3_128_shake and
+   sha3_128_shake_output. */
+void
+sha3_256_shake (struct sha3_256_ctx *ctx,
+		size_t length,
+		uint8_t *digest);
+
+void
+sha3_256_shake_output (struct sha3_256_ctx *ctx,
+		       size_t length,
+		       uint8_t *digest);
+
 struct sha3_384_ctx
 {
   struct sha3_state state;
@@ -44,6 +44,7 @@
 #include <string.h>
 
 #include "sha2.h"
+#include "sha2-internal.h"
 
 #include "macros.h"
 
@@ -114,6 +115,13 @@ K[80] =
 
 #define COMPRESS(ctx, data) (_nettle_sha512_compress((ctx)->state, (data), K))
 
+#if HAVE_NATIVE_sha512_compress_4
+/* Number of messages processed in parallel by the _n functions, and
+   the smallest number for which it pays off. */
+# define SHA512_LANES 4
+# define SHA512_MIN_LANES 2
+#endif
+
 void
 sha512_init(struct sha512_ctx *ctx)
 {
@@ -150,19 +158,12 @@ sha512_update(struct sha512_ctx *ctx,
   MD_UPDATE (ctx, length, data, COMPRESS, MD_INCR(ctx));
 }
 
+/* Pads the final block, leaving it to be compressed. */
 static void
-sha512_write_digest(struct sha512_ctx *ctx,
-		    size_t length,
-		    uint8_t *digest)
+sha512_pad(struct sha512_ctx *ctx)
 {
   uint64_t high, low;
 
-  unsigned i;
-  unsigned words;
-  unsigned leftover;
-
-  assert(length <= SHA512_DIGEST_SIZE);
-
   MD_PAD(ctx, 16, COMPRESS);
 
   /* There are 1024 = 2^10 bits in one block */  
@@ -174,7 +175,16 @@ sha512_write_digest(struct sha512_ctx *ctx,
      function. It's probably not worth the effort to fix this. */
   WRITE_UINT64(ctx->block + (SHA512_BLOCK_SIZE - 16), high);
   WRITE_UINT64(ctx->block + (SHA512_BLOCK_SIZE - 8), low);
-  COMPRESS(ctx, ctx->block);
+}
+
+static void
+sha512_write_state(const struct sha512_ctx *ctx,
+		   size_t length,
+		   uint8_t *digest)
+{
+  unsigned i;
+  unsigned words;
+  unsigned leftover;
 
   words = length / 8;
   leftover = length % 8;
@@ -194,6 +204,18 @@ sha512_write_digest(struct sha512_ctx *ctx,
     }
 }
 
+static void
+sha512_write_digest(struct sha512_ctx *ctx,
+		    size_t length,
+		    uint8_t *digest)
+{
+  assert(length <= SHA512_DIGEST_SIZE);
+
+  sha512_pad(ctx);
+  COMPRESS(ctx, ctx->block);
+  sha512_write_state(ctx, length, digest);
+}
+
 void
 sha512_digest(struct sha512_ctx *ctx,
 	      size_t length,
@@ -311,3 +333,167 @@ sha512_256_digest(struct sha512_256_ctx *ctx,
   sha512_write_digest(ctx, length, digest);
   sha512_256_init(ctx);
 }
+
+#if HAVE_NATIVE_sha512_compress_4
+/* For fat builds */
+void
+_nettle_sha512_compress_4_c(uint64_t *state, const uint8_t **input,
+			    size_t blocks, const uint64_t *k)
+{
+  unsigned i, j;
+
+  for (i = 0; i < 4; i++)
+    {
+      uint64_t s[_SHA512_DIGEST_LENGTH];
+      size_t b;
+
+      for (j = 0; j < _SHA512_DIGEST_LENGTH; j++)
+	s[j] = state[4*j + i];
+      for (b = 0; b < blocks; b++)
+	_nettle_sha512_compress(s, input[i] + b * SHA512_BLOCK_SIZE, k);
+      for (j = 0; j < _SHA512_DIGEST_LENGTH; j++)
+	state[4*j + i] = s[j];
+    }
+}
+
+/* Compresses BLOCKS complete blocks from DATA[i] into CTX[i], for
+   the first N <= SHA512_LANES contexts. Unused lanes duplicate the
+   first message. */
+static void
+sha512_compress_lanes(unsigned n, struct sha512_ctx **ctx,
+		      const uint8_t **data, size_t blocks)
+{
+  uint64_t state[SHA512_LANES * _SHA512_DIGEST_LENGTH];
+  const uint8_t *input[SHA512_LANES];
+  unsigned i, j;
+
+  for (i = 0; i < SHA512_LANES; i++)
+    {
+      const struct sha512_ctx *c = ctx[i < n ? i : 0];
+      for (j = 0; j < _SHA512_DIGEST_LENGTH; j++)
+	state[SHA512_LANES*j + i] = c->state[j];
+      input[i] = data[i < n ? i : 0];
+    }
+
+  _sha512_compress_4 (state, input, blocks, K);
+
+  for (i = 0; i < n; i++)
+    {
+      for (j = 0; j < _SHA512_DIGEST_LENGTH; j++)
+	ctx[i]->state[j] = state[SHA512_LANES*j + i];
+      ctx[i]->count_low += blocks;
+      ctx[i]->count_high += (ctx[i]->count_low < blocks);
+    }
+}
+
+static void
+sha512_update_lanes(unsigned n, struct sha512_ctx **ctx,
+		    size_t length, const uint8_t **data)
+{
+  const uint8_t *p[SHA512_LANES];
+  size_t left[SHA512_LANES];
+  size_t blocks;
+  unsigned i;
+
+  /* As for sha256_update_n, complete partial blocks one message at a
+     time, and process the complete blocks in common in parallel. */
+  for (i = 0, blocks = length / SHA512_BLOCK_SIZE; i < n; i++)
+    {
+      size_t fill = 0;
+      if (ctx[i]->index > 0)
+	{
+	  fill = SHA512_BLOCK_SIZE - ctx[i]->index;
+	  if (fill > length)
+	    fill = length;
+	  sha512_update (ctx[i], fill, data[i]);
+	}
+      p[i] = data[i] + fill;
+      left[i] = length - fill;
+      if (left[i] / SHA512_BLOCK_SIZE < blocks)
+	blocks = left[i] / SHA512_BLOCK_SIZE;
+    }
+
+  if (blocks > 0)
+    sha512_compress_lanes (n, ctx, p, blocks);
+
+  for (i = 0; i < n; i++)
+    sha512_update (ctx[i], left[i] - blocks * SHA512_BLOCK_SIZE,
+		   p[i] + blocks * SHA512_BLOCK_SIZE);
+}
+
+static void
+sha512_write_digest_lanes(unsigned n, struct sha512_ctx **ctx,
+			  size_t length, uint8_t **digest)
+{
+  const uint8_t *input[SHA512_LANES];
+  unsigned i;
+
+  assert(length <= SHA512_DIGEST_SIZE);
+
+  for (i = 0; i < n; i++)
+    {
+      sha512_pad (ctx[i]);
+      input[i] = ctx[i]->block;
+    }
+
+  sha512_compress_lanes (n, ctx, input, 1);
+
+  for (i = 0; i < n; i++)
+    sha512_write_state (ctx[i], length, digest[i]);
+}
+#endif /* HAVE_NATIVE_sha512_compress_4 */
+
+void
+sha512_update_n(unsigned n, struct sha512_ctx **ctx,
+		size_t length, const uint8_t **data)
+{
+#if HAVE_NATIVE_sha512_compress_4
+  while (n >= SHA512_MIN_LANES)
+    {
+      unsigned m = n < SHA512_LANES ? n : SHA512_LANES;
+      sha512_update_lanes (m, ctx, length, data);
+      n -= m; ctx += m; data += m;
+    }
+#endif
+  for (; n > 0; n--)
+    sha512_update (*ctx++, length, *data++);
+}
+
+void
+sha512_digest_n(unsigned n, struct sha512_ctx **ctx,
+		size_t length, uint8_t **digest)
+{
+#if HAVE_NATIVE_sha512_compress_4
+  while (n >= SHA512_MIN_LANES)
+    {
+      unsigned m = n < SHA512_LANES ? n : SHA512_LANES;
+      unsigned i;
+      sha512_write_digest_lanes (m, ctx, length, digest);
+      for (i = 0; i < m; i++)
+	sha512_init (ctx[i]);
+      n -= m; ctx += m; digest += m;
+    }
+#endif
+  for (; n > 0; n--)
+    sha512_digest (*ctx++, length, *digest++);
+}
+
+void
+sha384_digest_n(unsigned n, struct sha512_ctx **ctx,
+		size_t length, uint8_t **digest)
+{
+  assert(length <= SHA384_DIGEST_SIZE);
+#if HAVE_NATIVE_sha512_compress_4
+  while (n >= SHA512_MIN_LANES)
+    {
+      unsigned m = n < SHA512_LANES ? n : SHA512_LANES;
+      unsigned i;
+      sha512_write_digest_lanes (m, ctx, length, digest);
+      for (i = 0; i < m; i++)
+	sha384_init (ctx[i]);
+      n -= m; ctx += m; digest += m;
+    }
+#endif
+  for (; n > 0; n--)
+    sha384_digest (*ctx++, length, *digest++);
+}
@@ -64,6 +64,86 @@ test_cbc_bulk(void)
   ASSERT (MEMEQ(CBC_BULK_DATA, clear, cipher));
 }
 
+#define CBC_N_STREAMS 6
+#define CBC_N_DATA 0x1f0 /* 31 blocks */
+
+/* Check cbc_aes128_encrypt_n and cbc_aes256_encrypt_n against
+ * cbc_encrypt, for each number of streams. The last stream is
+ * encrypted in place. */
+static void
+test_cbc_aes_n(void)
+{
+  struct knuth_lfib_ctx random;
+  struct aes128_ctx aes128[CBC_N_STREAMS];
+  struct aes256_ctx aes256[CBC_N_STREAMS];
+  const struct aes128_ctx *ctx128[CBC_N_STREAMS];
+  const struct aes256_ctx *ctx256[CBC_N_STREAMS];
+  uint8_t clear[CBC_N_STREAMS][CBC_N_DATA];
+  uint8_t cipher[CBC_N_STREAMS][CBC_N_DATA];
+  uint8_t ref[CBC_N_STREAMS][CBC_N_DATA];
+  uint8_t iv[CBC_N_STREAMS][AES_BLOCK_SIZE];
+  uint8_t ref_iv[CBC_N_STREAMS][AES_BLOCK_SIZE];
+  uint8_t *ivp[CBC_N_STREAMS];
+  uint8_t *dst[CBC_N_STREAMS];
+  const uint8_t *src[CBC_N_STREAMS];
+  unsigned n, i;
+
+  knuth_lfib_init(&random, 4711);
+
+  for (i = 0; i < CBC_N_STREAMS; i++)
+    {
+      uint8_t key[AES256_KEY_SIZE];
+      knuth_lfib_random(&random, sizeof(key), key);
+      aes128_set_encrypt_key(&aes128[i], key);
+      aes256_set_encrypt_key(&aes256[i], key);
+      ctx128[i] = &aes128[i];
+      ctx256[i] = &aes256[i];
+      knuth_lfib_random(&random, CBC_N_DATA, clear[i]);
+    }
+
+  for (n = 1; n <= CBC_N_STREAMS; n++)
+    {
+      unsigned key_size;
+      for (key_size = 16; key_size <= 32; key_size += 16)
+	{
+	  for (i = 0; i < n; i++)
+	    {
+	      knuth_lfib_random(&random, AES_BLOCK_SIZE, iv[i]);
+	      memcpy(ref_iv[i], iv[i], AES_BLOCK_SIZE);
+	      if (key_size == 16)
+		cbc_encrypt(&aes128[i], (nettle_cipher_func *) aes128_encrypt,
+			    AES_BLOCK_SIZE, ref_iv[i],
+			    CBC_N_DATA, ref[i], clear[i]);
+	      else
+		cbc_encrypt(&aes256[i], (nettle_cipher_func *) aes256_encrypt,
+			    AES_BLOCK_SIZE, ref_iv[i],
+			    CBC_N_DATA, ref[i], clear[i]);
+	      ivp[i] = iv[i];
+	      dst[i] = cipher[i];
+	      src[i] = clear[i];
+	    }
+	  memcpy(cipher[n-1], clear[n-1], CBC_N_DATA);
+	  src[n-1] = cipher[n-1];
+
+	  if (key_size == 16)
+	    cbc_aes128_encrypt_n(n, ctx128, ivp, CBC_N_DATA, dst, src);
+	  else
+	    cbc_aes256_encrypt_n(n, ctx256, ivp, CBC_N_DATA, dst, src);
+
+	  for (i = 0; i < n; i++)
+	    {
+	      if (!MEMEQ(CBC_N_DATA, cipher[i], ref[i])
+		  || !MEMEQ(AES_BLOCK_SIZE, iv[i], ref_iv[i]))
+		{
+		  fprintf(stderr, "cbc_aes%u_encrypt_n failed, n = %u, stream %u\n",
+			  8*key_size, n, i);
+		  FAIL();
+		}
+	    }
+	}
+    }
+}
+
 void
 test_main(void)
 {
@@ -162,6 +242,7 @@ test_main(void)
 		  SHEX("000102030405060708090a0b0c0d0e0f"));
 
   test_cbc_bulk();
+  test_cbc_aes_n();
 }
 
 /*
@@ -248,6 +248,90 @@ test_cipher_ccm(const struct nettle_cipher *cipher,
   free(de_data);
 }
 
+/* Hides the identity of aes128_encrypt, so that ccm uses the
+   generic code rather than any combined aes functions. */
+static void
+ccm_test_aes128_encrypt(const void *ctx, size_t length,
+			uint8_t *dst, const uint8_t *src)
+{
+  aes128_encrypt(ctx, length, dst, src);
+}
+
+#define CCM_BULK_DATA 300
+
+/* Compares ccm with aes128 against the generic code, for many message
+   lengths, with in-place operation, and with the message split over
+   several calls. */
+static void
+test_ccm_bulk(void)
+{
+  struct knuth_lfib_ctx random;
+  struct aes128_ctx aes;
+  struct ccm_ctx ccm;
+  uint8_t key[AES128_KEY_SIZE];
+  uint8_t nonce[CCM_MAX_NONCE_SIZE];
+  uint8_t adata[35];
+  uint8_t clear[CCM_BULK_DATA];
+  uint8_t ref[CCM_BULK_DATA + CCM_DIGEST_SIZE];
+  uint8_t data[CCM_BULK_DATA + CCM_DIGEST_SIZE];
+  uint8_t digest[CCM_DIGEST_SIZE];
+  size_t length;
+
+  knuth_lfib_init(&random, 17);
+  knuth_lfib_random(&random, sizeof(key), key);
+  knuth_lfib_random(&random, sizeof(nonce), nonce);
+  knuth_lfib_random(&random, sizeof(adata), adata);
+  knuth_lfib_random(&random, sizeof(clear), clear);
+  aes128_set_encrypt_key(&aes, key);
+
+  for (length = 0; length <= CCM_BULK_DATA; length += 7)
+    {
+      size_t split = (length / 2) & -(size_t) CCM_BLOCK_SIZE;
+
+      ccm_encrypt_message(&aes, ccm_test_aes128_encrypt,
+			  13, nonce, sizeof(adata), adata, CCM_DIGEST_SIZE,
+			  length + CCM_DIGEST_SIZE, ref, clear);
+
+      memcpy(data, clear, length);
+      ccm_encrypt_message(&aes, (nettle_cipher_func *) aes128_encrypt,
+			  13, nonce, sizeof(adata), adata, CCM_DIGEST_SIZE,
+			  length + CCM_DIGEST_SIZE, data, data);
+      ASSERT(MEMEQ(length + CCM_DIGEST_SIZE, data, ref));
+
+      ASSERT(ccm_decrypt_message(&aes, (nettle_cipher_func *) aes128_encrypt,
+				 13, nonce, sizeof(adata), adata,
+				 CCM_DIGEST_SIZE, length, data, data));
+      ASSERT(MEMEQ(length, data, clear));
+
+      /* Incremental, in two pieces, with adata ending mid-block. */
+      ccm_set_nonce(&ccm, &aes, (nettle_cipher_func *) aes128_encrypt,
+		    13, nonce, sizeof(adata), length, CCM_DIGEST_SIZE);
+      ccm_update(&ccm, &aes, (nettle_cipher_func *) aes128_encrypt,
+		 sizeof(adata), adata);
+      ccm_encrypt(&ccm, &aes, (nettle_cipher_func *) aes128_encrypt,
+		  split, data, clear);
+      ccm_encrypt(&ccm, &aes, (nettle_cipher_func *) aes128_encrypt,
+		  length - split, data + split, clear + split);
+      ccm_digest(&ccm, &aes, (nettle_cipher_func *) aes128_encrypt,
+		 CCM_DIGEST_SIZE, digest);
+      ASSERT(MEMEQ(length, data, ref));
+      ASSERT(MEMEQ(CCM_DIGEST_SIZE, digest, ref + length));
+
+      ccm_set_nonce(&ccm, &aes, (nettle_cipher_func *) aes128_encrypt,
+		    13, nonce, sizeof(adata), length, CCM_DIGEST_SIZE);
+      ccm_update(&ccm, &aes, (nettle_cipher_func *) aes128_encrypt,
+		 sizeof(adata), adata);
+      ccm_decrypt(&ccm, &aes, (nettle_cipher_func *) aes128_encrypt,
+		  split, data, ref);
+      ccm_decrypt(&ccm, &aes, (nettle_cipher_func *) aes128_encrypt,
+		  length - split, data + split, ref + split);
+      ccm_digest(&ccm, &aes, (nettle_cipher_func *) aes128_encrypt,
+		 CCM_DIGEST_SIZE, digest);
+      ASSERT(MEMEQ(length, data, clear));
+      ASSERT(MEMEQ(CCM_DIGEST_SIZE, digest, ref + length));
+    }
+}
+
 void
 test_main(void)
 {
@@ -725,4 +809,6 @@ test_main(void)
 		  SHEX("90ae61cf7baebd4cade494c54a29ae70269aec71"),
 		  SHEX("6c05313e45dc8ec10bea6c670bd94f31569386a6"
 		       "8f3829e8e76ee23c04f566189e63c686"));
+
+  test_ccm_bulk();
 }
@@ -1,33 +1,162 @@
 #include "testutils.h"
 #include "nettle-internal.h"
+#include "chacha-poly1305.h"
+
+static void
+test_chacha_poly1305 (const struct tstring *key,
+		      const struct tstring *authtext,
+		      const struct tstring *cleartext,
+		      const struct tstring *ciphertext,
+		      const struct tstring *nonce,
+		      const struct tstring *digest)
+{
+  struct chacha_poly1305_ctx ctx;
+  size_t length = cleartext->length;
+  uint8_t *data;
+
+  test_aead (&nettle_chacha_poly1305, NULL,
+	     key, authtext, cleartext, ciphertext, nonce, digest);
+
+  ASSERT (digest->length == CHACHA_POLY1305_DIGEST_SIZE);
+  data = xalloc (length + CHACHA_POLY1305_DIGEST_SIZE);
+
+  chacha_poly1305_set_key (&ctx, key->data);
+  chacha_poly1305_seal (&ctx, nonce->data,
+			authtext->length, authtext->data,
+			length + CHACHA_POLY1305_DIGEST_SIZE, data,
+			cleartext->data);
+  ASSERT (MEMEQ (length, data, ciphertext->data));
+  ASSERT (MEMEQ (CHACHA_POLY1305_DIGEST_SIZE, data + length, digest->data));
+
+  /* In-place decryption */
+  ASSERT (chacha_poly1305_open (&ctx, nonce->data,
+				authtext->length, authtext->data,
+				length, data, data));
+  ASSERT (MEMEQ (length, data, cleartext->data));
+
+  memcpy (data, ciphertext->data, length);
+  memcpy (data + length, digest->data, CHACHA_POLY1305_DIGEST_SIZE);
+  data[length] ^= 1;
+  ASSERT (!chacha_poly1305_open (&ctx, nonce->data,
+				 authtext->length, authtext->data,
+				 length, data, data));
+  free (data);
+}
+
+/* A message longer than the chunks used by chacha_poly1305_encrypt
+   and chacha_poly1305_decrypt. Only the digest is compared with the
+   reference. */
+static void
+test_long_message (void)
+{
+  struct chacha_poly1305_ctx ctx;
+  const struct tstring *key
+    = SHEX("8081828384858687 88898a8b8c8d8e8f"
+	   "9091929394959697 98999a9b9c9d9e9f");
+  const struct tstring *nonce = SHEX("0700000040414243 44454647");
+  const struct tstring *authtext
+    = SHEX("05121f2c39465360 6d7a8794a1aebbc8"
+	   "d5e2effc09162330 3d4a5764717e8b98"
+	   "a5b2bfccd9e6f300");
+  const struct tstring *digest = SHEX("cb0afc4ebd811473 e9d715986f6d6590");
+  size_t length = 5000;
+  uint8_t *msg = xalloc (length);
+  uint8_t *data = xalloc (length + CHACHA_POLY1305_DIGEST_SIZE);
+  size_t i;
+
+  for (i = 0; i < length; i++)
+    msg[i] = i*37 + 11;
+
+  chacha_poly1305_set_key (&ctx, key->data);
+  chacha_poly1305_seal (&ctx, nonce->data,
+			authtext->length, authtext->data,
+			length + CHACHA_POLY1305_DIGEST_SIZE, data, msg);
+  ASSERT (MEMEQ (CHACHA_POLY1305_DIGEST_SIZE, data + length, digest->data));
+
+  ASSERT (chacha_poly1305_open (&ctx, nonce->data,
+				authtext->length, authtext->data,
+				length, data, data));
+  ASSERT (MEMEQ (length, data, msg));
+
+  free (msg);
+  free (data);
+}
 
 void
 test_main(void)
 {
   /* From draft-irtf-cfrg-chacha20-poly1305-08 */
-  test_aead (&nettle_chacha_poly1305, NULL,
-	     SHEX("8081828384858687 88898a8b8c8d8e8f"
-		  "9091929394959697 98999a9b9c9d9e9f"),
-	     SHEX("50515253c0c1c2c3 c4c5c6c7"),
-	     SHEX("4c61646965732061 6e642047656e746c"
-		  "656d656e206f6620 74686520636c6173"
-		  "73206f6620273939 3a20496620492063"
-		  "6f756c64206f6666 657220796f75206f"
-		  "6e6c79206f6e6520 74697020666f7220"
-		  "7468652066757475 72652c2073756e73"
-		  "637265656e20776f 756c642062652069"
-		  "742e"),
-	     SHEX("d31a8d34648e60db7b86afbc53ef7ec2"
-		  "a4aded51296e08fea9e2b5a736ee62d6"
-		  "3dbea45e8ca9671282fafb69da92728b"
-		  "1a71de0a9e060b2905d6a5b67ecd3b36"
-		  "92ddbd7f2d778b8c9803aee328091b58"
-		  "fab324e4fad675945585808b4831d7bc"
-		  "3ff4def08e4b7a9de576d26586cec64b"
-		  "6116"),
-	     /* The draft splits the nonce into a "common part" and an
-		iv, and it seams the "common part" is the first 4
-		bytes. */
-	     SHEX("0700000040414243 44454647"),
-	     SHEX("1ae10b594f09e26a 7e902ecbd0600691"));
+  test_chacha_poly1305 (SHEX("8081828384858687 88898a8b8c8d8e8f"
+			     "9091929394959697 98999a9b9c9d9e9f"),
+			SHEX("50515253c0c1c2c3 c4c5c6c7"),
+			SHEX("4c61646965732061 6e642047656e746c"
+			     "656d656e206f6620 74686520636c6173"
+			     "73206f6620273939 3a20496620492063"
+			     "6f756c64206f6666 657220796f75206f"
+			     "6e6c79206f6e6520 74697020666f7220"
+			     "7468652066757475 72652c2073756e73"
+			     "637265656e20776f 756c642062652069"
+			     "742e"),
+			SHEX("d31a8d34648e60db7b86afbc53ef7ec2"
+			     "a4aded51296e08fea9e2b5a736ee62d6"
+			     "3dbea45e8ca9671282fafb69da92728b"
+			     "1a71de0a9e060b2905d6a5b67ecd3b36"
+			     "92ddbd7f2d778b8c9803aee328091b58"
+			     "fab324e4fad675945585808b4831d7bc"
+			     "3ff4def08e4b7a9de576d26586cec64b"
+			     "6116"),
+			/* The draft splits the nonce into a "common part" and an
+			   iv, and it seams the "common part" is the first 4
+			   bytes. */
+			SHEX("0700000040414243 44454647"),
+			SHEX("1ae10b594f09e26a 7e902ecbd0600691"));
+
+  /* Long enough to use the multi-block poly1305 code. */
+  test_chacha_poly1305 (SHEX("8081828384858687 88898a8b8c8d8e8f"
+			     "9091929394959697 98999a9b9c9d9e9f"),
+			SHEX("05121f2c39465360 6d7a8794a1aebbc8"
+			     "d5e2effc09162330 3d4a5764717e8b98"
+			     "a5b2bfccd9e6f300"),
+			SHEX("0b30557a9fc4e90e 33587da2c7ec1136"
+			     "5b80a5caef14395e 83a8cdf2173c6186"
+			     "abd0f51a3f6489ae d3f81d42678cb1d6"
+			     "fb20456a8fb4d9fe 23486d92b7dc0126"
+			     "4b7095badf04294e 7398bde2072c5176"
+			     "9bc0e50a2f54799e c3e80d32577ca1c6"
+			     "eb10355a7fa4c9ee 13385d82a7ccf116"
+			     "3b6085aacff4193e 6388add2f71c4166"
+			     "8bb0d5fa1f44698e b3d8fd22476c91b6"
+			     "db00254a6f94b9de 03284d7297bce106"
+			     "2b50759abfe4092e 53789dc2e70c3156"
+			     "7ba0c5ea0f34597e a3c8ed12375c81a6"
+			     "cbf0153a5f84a9ce f3183d6287acd1f6"
+			     "1b40658aafd4f91e 43688db2d7fc2146"
+			     "6b90b5daff24496e 93b8dd02274c7196"
+			     "bbe0052a4f7499be e3082d52779cc1e6"
+			     "0b30557a9fc4e90e 33587da2c7ec1136"
+			     "5b80a5caef14395e 83a8cdf2173c6186"
+			     "abd0f51a3f6489ae d3f81d42"),
+			SHEX("944bbc279e39a9b4 26baf259f16d1b98"
+			     "9a402df5e6155780 5e221d7542be6223"
+			     "e54e3e2293ead785 6b22af4d9d57e33e"
+			     "8e24f70431ddb4b1 43ece85da6641a7f"
+			     "b7c151e59d1dc7e2 9ff26321494a380e"
+			     "151ba4ceb3f7787f e408a1996c381809"
+			     "b7968ecf9fcfc41c 8322ebc743671734"
+			     "2e5889a901c175e9 c5fece292af3be02"
+			     "fe44aaac66daa44d ecb4db7d162fe195"
+			     "1b89310c744c5984 f63f98dcae1a1bb2"
+			     "ac1d076a665e30e5 2c20f9391cd7482e"
+			     "2d019bf132279074 c9628b91e0550710"
+			     "4882df29a6978ba2 7d8f06015fe847e5"
+			     "9e51dfd2044a2a5d bc907d6467a8c354"
+			     "7faead95f9f93c9d b8079f54c14c88cc"
+			     "a5e8592c25aebc56 aa93d9522edf068e"
+			     "ea9e0849fceb7c8b 7031b5c6c5303aac"
+			     "e23676caec8de2b9 10f52a5ea4c65e93"
+			     "9bb8d0149371ab51 63ac6b40"),
+			SHEX("0700000040414243 44454647"),
+			SHEX("0ab800cfde90c4da ff0dde182fc39619"));
+
+  test_long_message ();
 }
@@ -116,6 +116,38 @@ test_chacha(const struct tstring *key, const struct tstring *nonce,
     }
 }
 
+/* Check that the 64-bit block counter is incremented consistently,
+   also when several blocks are generated at a time. */
+static void
+test_chacha_counter(void)
+{
+  static const uint8_t key[CHACHA_KEY_SIZE] = { 1 };
+  static const uint8_t nonce[CHACHA_NONCE_SIZE] = { 2 };
+  struct chacha_ctx ctx, ref;
+  uint8_t data[20 * CHACHA_BLOCK_SIZE];
+  uint8_t expected[20 * CHACHA_BLOCK_SIZE];
+  unsigned i;
+
+  chacha_set_key (&ref, key);
+  chacha_set_nonce (&ref, nonce);
+  ref.state[12] = 0xfffffffd;
+  ref.state[13] = 7;
+  ctx = ref;
+
+  memset (expected, 0, sizeof(expected));
+  for (i = 0; i < 20; i++)
+    {
+      uint8_t *p = expected + i * CHACHA_BLOCK_SIZE;
+      chacha_crypt (&ref, CHACHA_BLOCK_SIZE, p, p);
+    }
+  memset (data, 0, sizeof(data));
+  chacha_crypt (&ctx, sizeof(data), data, data);
+
+  ASSERT (MEMEQ (sizeof(data), data, expected));
+  ASSERT (ctx.state[12] == ref.state[12]);
+  ASSERT (ctx.state[13] == ref.state[13]);
+}
+
 void
 test_main(void)
 {
@@ -643,4 +675,62 @@ test_main(void)
 		   "d2826446079faa09 14c2d705d98b02a2"
 		   "b5129cd1de164eb9 cbd083e8a2503c4e"),
 	      20);
+
+  /* Ten blocks, exercising functions generating several blocks at a
+     time. Checked with openssl. */
+  test_chacha(SHEX("0001020304050607 08090a0b0c0d0e0f"
+		   "1011121314151617 18191a1b1c1d1e1f"),
+	      SHEX("0001020304050607"),
+	      SHEX("f798a189f195e669 82105ffb640bb775"
+		   "7f579da31602fc93 ec01ac56f85ac3c1"
+		   "34a4547b733b4641 3042c94400491769"
+		   "05d3be59ea1c53f1 5916155c2be8241a"
+
+		   "38008b9a26bc3594 1e2444177c8ade66"
+		   "89de95264986d958 89fb60e84629c9bd"
+		   "9a5acb1cc118be56 3eb9b3a4a472f82e"
+		   "09a7e778492b562e f7130e88dfe031c7"
+
+		   "9db9d4f7c7a89915 1b9a475032b63fc3"
+		   "85245fe054e3dd5a 97a5f576fe064025"
+		   "d3ce042c566ab2c5 07b138db853e3d69"
+		   "59660996546cc9c4 a6eafdc777c040d7"
+
+		   "0eaf46f76dad3979 e5c5360c3317166a"
+		   "1c894c94a371876a 94df7628fe4eaaf2"
+		   "ccb27d5aaae0ad7a d0f9d4b6ad3b5409"
+		   "8746d4524d38407a 6deb3ab78fab78c9"
+
+		   "4213668bbbd394c5 de93b853178addd6"
+		   "b97f9fa1ec3e56c0 0c9ddff0a44a2042"
+		   "41175a4cab0f961b a53ede9bdf960b94"
+		   "f9829b1f34147264 29b362c5b538e391"
+
+		   "520f489b7ed8d20a e3fd49e9e259e443"
+		   "97514d618c96c484 6be3c680bdc11c71"
+		   "dcbbe29ccf80d62a 0938fa549391e6ea"
+		   "57ecbe2606790ec1 5d2224ae307c1442"
+
+		   "26b7c4e8c2f97d2a 1d67852d29beba11"
+		   "0edd445197012062 a393a9c92803ad3b"
+		   "4f31d7bc6033ccf7 932cfed3f019044d"
+		   "25905916777286f8 2f9a4cc1ffe430ff"
+
+		   "d1dcfc27deed327b 9f9630d2fa969fb6"
+		   "f0603cd19dd9a951 9e673bcfcd901412"
+		   "5291a44669ef7285 e74ed3729b677f80"
+		   "1c3cdf058c509631 68b496043716c730"
+
+		   "7cd9e0cdd137fccb 0f05b47cdbb95c5f"
+		   "54831622c3652a32 b2531fe326bcd6e2"
+		   "bbf56a194fa196fb d1a54952110f51c7"
+		   "3433865f7664b836 685e3664b3d8444a"
+
+		   "f89a242805e18c97 5f1146324996fde1"
+		   "7007cf3e6e8f4e76 4022533edbfe07d4"
+		   "733e48bb372d75b0 ef48ec983eb78532"
+		   "161cc529e5abb898 37dfcca6261dbb37"),
+	      20);
+
+  test_chacha_counter();
 }
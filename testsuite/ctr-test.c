@@ -58,6 +58,65 @@ test_main(void)
 		       "2b0930daa23de94ce87017ba2d84988d"
 		       "dfc9c58db67aada613c2dd08457941a6"),
 		  SHEX("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"));
+
+  /* Longer messages, with the counter crossing a 64-bit word
+     boundary, and wrapping around. Checked with openssl. */
+  test_cipher_ctr(&nettle_aes128,
+		  SHEX("2b7e151628aed2a6abf7158809cf4f3c"),
+		  SHEX("000102030405060708090a0b0c0d0e0f"
+		       "101112131415161718191a1b1c1d1e1f"
+		       "202122232425262728292a2b2c2d2e2f"
+		       "303132333435363738393a3b3c3d3e3f"
+		       "404142434445464748494a4b4c4d4e4f"
+		       "505152535455565758595a5b5c5d5e5f"
+		       "606162636465666768696a6b6c6d6e6f"
+		       "707172737475767778797a7b7c7d7e7f"
+		       "808182838485868788898a8b8c8d8e8f"
+		       "909192939495969798999a9b9c9d9e9f"
+		       "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+		       "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+		       "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+		       "d0d1d2d3d4"),
+		  SHEX("a638cfccee37f5b38d6d84b19c0ba15a"
+		       "9e9c2464a8446417a8f6508e291ac759"
+		       "4b15c70618281defc024ce78479d9cf6"
+		       "b3b23caa11959604e5a6f4584d353246"
+		       "7d062b3400213e0537f3a28b597f453c"
+		       "217fc3405e5b908ff424e8cc5cbc78c6"
+		       "af9a72ffb096d51581850d83910db5f6"
+		       "b77d7a34f9c8b0905ca2ef0e9162df75"
+		       "d9b7b98dabf49db7ff5d399f37f73649"
+		       "e76d869da64eeed63452b93bfa4c903b"
+		       "bdd02439ff703a8c4374fbad6dcbc138"
+		       "96f48dc028f7b8a9f19091208d36bde6"
+		       "f7238ded017519fd628b72f2e611eba7"
+		       "875a27d7c9"),
+		  SHEX("f0f1f2f3f4f5f6f7fffffffffffffffa"));
+
+  test_cipher_ctr(&nettle_aes256,
+		  SHEX("603deb1015ca71be2b73aef0857d7781"
+		       "1f352c073b6108d72d9810a30914dff4"),
+		  SHEX("05121f2c394653606d7a8794a1aebbc8"
+		       "d5e2effc091623303d4a5764717e8b98"
+		       "a5b2bfccd9e6f3000d1a2734414e5b68"
+		       "75828f9ca9b6c3d0ddeaf704111e2b38"
+		       "45525f6c798693a0adbac7d4e1eefb08"
+		       "15222f3c495663707d8a97a4b1becbd8"
+		       "e5f2ff0c192633404d5a6774818e9ba8"
+		       "b5c2cfdce9f603101d2a3744515e6b78"
+		       "85929facb9c6d3e0edfa0714212e3b48"
+		       "55626f7c8996a3b0bdcad7e4f1fe0b18"),
+		  SHEX("b1c8b88b8984d7ff1be41499a4a4e787"
+		       "9a7f58be1c4ce632ffe47f664a4dbd7c"
+		       "9e8e96ed11bcd7de97dc21fa2c533ba4"
+		       "90ea791d3d79b506caa7bbc4520e836c"
+		       "d447413172fc8cbb6d6d6b044fd0aaec"
+		       "022c0ced3a0ab1a5046cad2cca7703cb"
+		       "adffc3e1bf103625d823d262156c2386"
+		       "b459c1942dcf5a524495aa5faf20676c"
+		       "add5a3d9a02339a6b436faeedbea2314"
+		       "dc7a6597254804e0838fbe588d62f1ea"),
+		  SHEX("fffffffffffffffffffffffffffffffd"));
 }
 
 /*
@@ -0,0 +1,169 @@
+#include "testutils.h"
+
+/* Checks that r is the point s G, converting both to affine
+   coordinates. Uses p as temporary storage. */
+static void
+check_mul_g (const struct ecc_curve *ecc, const mp_limb_t *s,
+	     mp_limb_t *r, mp_limb_t *p, mp_limb_t *scratch)
+{
+  mp_size_t size = ecc_size (ecc);
+  ecc->h_to_a (ecc, 0, r, r, scratch);
+
+  ecc->mul_g (ecc, p, s, scratch);
+  ecc->h_to_a (ecc, 0, p, p, scratch);
+
+  if (mpn_cmp (r, p, 2*size))
+    {
+      fprintf (stderr,
+	       "Different results from ecc_mul_add_ga and ecc->mul_g.\n"
+	       " bits = %u\n",
+	       ecc->p.bit_size);
+      fprintf (stderr, " s = ");
+      mpn_out_str (stderr, 16, s, size);
+
+      fprintf (stderr, "\nr = ");
+      mpn_out_str (stderr, 16, r, size);
+      fprintf (stderr, ",\n    ");
+      mpn_out_str (stderr, 16, r + size, size);
+
+      fprintf (stderr, "\np = ");
+      mpn_out_str (stderr, 16, p, size);
+      fprintf (stderr, ",\n    ");
+      mpn_out_str (stderr, 16, p + size, size);
+      fprintf (stderr, "\n");
+      abort ();
+    }
+}
+
+/* Returns zero if the sum is the point at infinity, or for Edwards
+   curves, the neutral element. */
+static int
+mul_add_ga (const struct ecc_curve *ecc, mp_limb_t *r,
+	    const mp_limb_t *n, const mp_limb_t *m, const mp_limb_t *p,
+	    mp_limb_t *scratch)
+{
+  mp_size_t size = ecc_size (ecc);
+  if (!ecc_edwards_p (ecc))
+    return ecc_mul_add_ga (ecc, r, n, m, p, scratch);
+
+  ecc_mul_add_ga_eh (ecc, r, n, m, p, scratch);
+  ecc->h_to_a (ecc, 0, scratch, r, scratch + 2*size);
+  return !(mpn_zero_p (scratch, size)
+	   && scratch[size] == 1 && mpn_zero_p (scratch + size + 1, size - 1));
+}
+
+/* Sets xp to a random number, reduced modulo q. */
+static void
+random_scalar (const struct ecc_curve *ecc, mp_limb_t *xp,
+	       gmp_randstate_t rands, mpz_t z, const mpz_t q, unsigned j)
+{
+  mp_size_t size = ecc_size (ecc);
+  if (j & 1)
+    mpz_rrandomb (z, rands, size * GMP_NUMB_BITS);
+  else
+    mpz_urandomb (z, rands, size * GMP_NUMB_BITS);
+
+  mpz_fdiv_r (z, z, q);
+  mpz_limbs_copy (xp, z, size);
+}
+
+void
+test_main (void)
+{
+  gmp_randstate_t rands;
+  mpz_t z, q, t;
+  unsigned i;
+
+  gmp_randinit_default (rands);
+  mpz_init (z);
+  mpz_init (q);
+  mpz_init (t);
+  
+  for (i = 0; ecc_curves[i]; i++)
+    {
+      const struct ecc_curve *ecc = ecc_curves[i];
+      mp_size_t size = ecc_size (ecc);
+      mp_limb_t *p = xalloc_limbs (ecc_size_j (ecc));
+      mp_limb_t *r = xalloc_limbs (ecc_size_j (ecc));
+      mp_limb_t *n = xalloc_limbs (size);
+      mp_limb_t *m = xalloc_limbs (size);
+      mp_limb_t *k = xalloc_limbs (size);
+      mp_limb_t *s = xalloc_limbs (size);
+      mp_limb_t *scratch = xalloc_limbs (ECC_MUL_ADD_GA_ITCH (size)
+					 + ecc->mul_itch);
+      unsigned j;
+
+      mpz_set_n (q, ecc->q.m, size);
+      mpn_zero (n, size);
+      mpn_zero (m, size);
+
+      /* 1 G + 1 G = 2 G, hitting the doubling case. */
+      n[0] = m[0] = 1;
+      if (!mul_add_ga (ecc, r, n, m, ecc->g, scratch))
+	die ("curve %d: ecc_mul_add_ga with n = m = 1 failed.\n",
+	     ecc->p.bit_size);
+      mpn_zero (s, size);
+      s[0] = 2;
+      check_mul_g (ecc, s, r, p, scratch);
+
+      /* 0 G + 1 G = G */
+      n[0] = 0;
+      if (!mul_add_ga (ecc, r, n, m, ecc->g, scratch))
+	die ("curve %d: ecc_mul_add_ga with n = 0 failed.\n",
+	     ecc->p.bit_size);
+      s[0] = 1;
+      check_mul_g (ecc, s, r, p, scratch);
+
+      /* (q - 1) G + 1 G = 0 */
+      mpn_sub_1 (n, ecc->q.m, size, 1);
+      if (mul_add_ga (ecc, r, n, m, ecc->g, scratch))
+	die ("curve %d: ecc_mul_add_ga with n = q - 1 failed.\n",
+	     ecc->p.bit_size);
+
+      /* (q - 5) G + 5 G = 0 */
+      mpn_sub_1 (n, ecc->q.m, size, 5);
+      m[0] = 5;
+      if (mul_add_ga (ecc, r, n, m, ecc->g, scratch))
+	die ("curve %d: ecc_mul_add_ga with n = q - 5 failed.\n",
+	     ecc->p.bit_size);
+
+      for (j = 0; j < 100; j++)
+	{
+	  /* P = k G, and n G + m P = (n + m k) G */
+	  random_scalar (ecc, n, rands, z, q, j);
+	  random_scalar (ecc, m, rands, z, q, j >> 1);
+	  random_scalar (ecc, k, rands, z, q, j >> 2);
+	  if (mpn_zero_p (k, size))
+	    continue;
+
+	  ecc->mul_g (ecc, p, k, scratch);
+	  ecc->h_to_a (ecc, 0, p, p, scratch);
+
+	  mpz_set_n (z, m, size);
+	  mpz_set_n (t, k, size);
+	  mpz_mul (z, z, t);
+	  mpz_set_n (t, n, size);
+	  mpz_add (z, z, t);
+	  mpz_fdiv_r (z, z, q);
+	  if (mpz_sgn (z) == 0)
+	    continue;
+	  mpz_limbs_copy (s, z, size);
+
+	  if (!mul_add_ga (ecc, r, n, m, p, scratch))
+	    die ("curve %d: ecc_mul_add_ga unexpectedly returned zero.\n",
+		 ecc->p.bit_size);
+	  check_mul_g (ecc, s, r, p, scratch);
+	}
+      free (n);
+      free (m);
+      free (k);
+      free (s);
+      free (p);
+      free (r);
+      free (scratch);
+    }
+  mpz_clear (z);
+  mpz_clear (q);
+  mpz_clear (t);
+  gmp_randclear (rands);
+}
@@ -1,5 +1,60 @@
 #include "testutils.h"
 
+#define BATCH_SIZE 6
+
+/* Batch of valid and invalid variants of the signature. */
+static void
+test_ecdsa_batch (const struct ecc_point *pub, const struct tstring *h,
+		  const struct dsa_signature *signature)
+{
+  const struct ecc_curve *ecc = pub->ecc;
+  struct ecc_point pubs[BATCH_SIZE];
+  struct dsa_signature signatures[BATCH_SIZE];
+  const uint8_t *digests[BATCH_SIZE];
+  size_t lengths[BATCH_SIZE];
+  uint8_t *bad_digest;
+  int valid[BATCH_SIZE];
+  unsigned i;
+
+  bad_digest = xalloc (h->length);
+  memcpy (bad_digest, h->data, h->length);
+  bad_digest[h->length / 2] ^= 0x10;
+
+  for (i = 0; i < BATCH_SIZE; i++)
+    {
+      pubs[i] = *pub;
+      dsa_signature_init (&signatures[i]);
+      mpz_set (signatures[i].r, signature->r);
+      mpz_set (signatures[i].s, signature->s);
+      digests[i] = h->data;
+      lengths[i] = h->length;
+    }
+  mpz_combit (signatures[1].r, ecc->p.bit_size / 3);
+  mpz_combit (signatures[2].s, 4*ecc->p.bit_size / 5);
+  digests[3] = bad_digest;
+  mpz_set_ui (signatures[4].s, 0);
+
+  if (!ecdsa_verify_batch (1, pubs, lengths, digests, signatures, valid)
+      || !valid[0])
+    die ("ecdsa_verify_batch failed with valid signature.\n");
+
+  if (ecdsa_verify_batch (BATCH_SIZE, pubs, lengths, digests, signatures,
+			  valid))
+    die ("ecdsa_verify_batch unexpectedly succeeded.\n");
+
+  for (i = 0; i < BATCH_SIZE; i++)
+    if (valid[i] != (i == 0 || i == 5))
+      die ("ecdsa_verify_batch gave bad result for signature %u.\n", i);
+
+  if (ecdsa_verify_batch (BATCH_SIZE, pubs, lengths, digests, signatures,
+			  NULL))
+    die ("ecdsa_verify_batch unexpectedly succeeded.\n");
+
+  for (i = 0; i < BATCH_SIZE; i++)
+    dsa_signature_clear (&signatures[i]);
+  free (bad_digest);
+}
+
 static void
 test_ecdsa (const struct ecc_curve *ecc,
 	    /* Public key */
@@ -72,6 +127,8 @@ test_ecdsa (const struct ecc_curve *ecc,
       goto fail;
     }
 
+  test_ecdsa_batch (&pub, h, &signature);
+
   ecc_point_clear (&pub);
   dsa_signature_clear (&signature);
   mpz_clear (x);
@@ -146,6 +203,54 @@ test_main (void)
 	      "FA509E70 AAC851AE 01AAC68D 62F86647"
 	      "2660"); /* s */
 
+  /* Signatures where u2 = r / s, as computed by ecc_modq_mul, is
+     in the range [q, 2q), and at least 2^{bit_size} with 64-bit
+     limbs. Needs reduction before the call to ecc_mul_add_ga. */
+  test_ecdsa (&nettle_secp_224r1,
+	      "7DF4F507 977862BD 6289E780 8271BA39"
+	      "F3EC13E6 0DB7FA05 4BF6AC46", /* x */
+
+	      "9850E9C4 66A0E3C3 6B829504 51BA96D8"
+	      "8631CECC 5B8D980A 400EE789", /* y */
+
+	      SHEX("F2F4EBE9 81A6B66D 6CB98CFC B1598317"
+		   "907BFE17 2DA45F0C A21DF27B"), /* h */
+
+	      "E59E31DB 50A15D80 49057D41 7996B9BE"
+	      "AABC66CA 2D5A909B 6AF2B8D5", /* r */
+	      "B6A33E58 7F927346 2A6B4324 22EF54D1"
+	      "62667BBD 4D576A3A 3400F209"); /* s */
+
+  test_ecdsa (&nettle_secp_521r1,
+	      "0061EB3B 2D6DE614 707B83D7 CC7AD32A"
+	      "911000C4 1730A2BE 67A9CDAB 77A07CD3"
+	      "943A8A11 D1CE0A7E 3E61B86A 5580B43A"
+	      "84E4D492 521B080E 253E96C9 D10C711E"
+	      "575F", /* x */
+
+	      "01F07AD4 27332577 DE40B149 04FA319D"
+	      "6BE16B3B 567DAF5E 3E4AE9FF 476D001C"
+	      "DB720155 7CE91970 1BF9CD10 69BEAB75"
+	      "9DD66C67 EF1B0AFA AA34581D F7D7A57C"
+	      "5D78", /* y */
+
+	      SHEX("8BC83DFF 0B96D22F 86510EF9 3D8091A2"
+		   "B3C79A9C ECA0C075 4828FD5E F0F80BDF"
+		   "48E7EB7A 0F0B9CE8 F60CD4FA A8F2E414"
+		   "9589ACC0 3E1481D7 7E49BBF7 5E68A8E7"
+		   "4F00"), /* h */
+
+	      "01514713 7929EF4C 67FF014D 0544C5AE"
+	      "21B5935D ADC4D4A9 4EED7195 560D5C0B"
+	      "5C459F3C 7F3DF3AC 1281CC31 F6720DA7"
+	      "F6516F1A FB99C3B7 57C99169 9C9D8AB7"
+	      "E80B", /* r */
+	      "01F23A6C A0A4F367 1475A518 D70886BC"
+	      "73D65C8D F6F0E4A9 45FD34AE 087FB325"
+	      "F8F0F636 2A30B9AF 6554395F 6D6DFF4B"
+	      "BE190001 5CF37ECE 9C8434EF 3275E78D"
+	      "3ED1"); /* s */
+
   test_ecdsa (&_nettle_curve25519,
 	      /* Public key corresponding to the key in ecdsa-sign-test */
 	      "59f8f317fd5f4e82 c02f8d4dec665fe1"
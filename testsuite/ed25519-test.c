@@ -36,6 +36,7 @@
 #include "eddsa.h"
 
 #include "base16.h"
+#include "knuth-lfib.h"
 
 static void
 decode_hex (size_t length, uint8_t *dst, const char *src)
@@ -153,6 +154,161 @@ getline(char **lineptr, size_t *n, FILE *f)
 }
 #endif
 
+#define BATCH_SIZE 200
+#define BATCH_KEYS 7
+
+/* Signs BATCH_SIZE messages with a few different keys, with more
+   signatures than fit in a single multi-scalar multiplication. */
+static void
+test_batch (void)
+{
+  struct knuth_lfib_ctx rctx;
+  uint8_t sk[BATCH_KEYS][ED25519_KEY_SIZE];
+  uint8_t pk[BATCH_KEYS][ED25519_KEY_SIZE];
+  uint8_t msg[BATCH_SIZE][20];
+  uint8_t s[BATCH_SIZE][ED25519_SIGNATURE_SIZE];
+  const uint8_t *pub[BATCH_SIZE];
+  const uint8_t *m[BATCH_SIZE];
+  const uint8_t *sig[BATCH_SIZE];
+  size_t length[BATCH_SIZE];
+  int valid[BATCH_SIZE];
+  unsigned i;
+
+  knuth_lfib_init (&rctx, 17);
+  for (i = 0; i < BATCH_KEYS; i++)
+    {
+      knuth_lfib_random (&rctx, ED25519_KEY_SIZE, sk[i]);
+      ed25519_sha512_public_key (pk[i], sk[i]);
+    }
+  for (i = 0; i < BATCH_SIZE; i++)
+    {
+      unsigned k = (i & 1) ? i % BATCH_KEYS : 0;
+      length[i] = i % sizeof (msg[i]);
+      knuth_lfib_random (&rctx, length[i], msg[i]);
+      ed25519_sha512_sign (pk[k], sk[k], length[i], msg[i], s[i]);
+      pub[i] = pk[k];
+      m[i] = msg[i];
+      sig[i] = s[i];
+    }
+
+  ASSERT (ed25519_sha512_verify_batch (0, pub, length, m, sig, &rctx,
+				       (nettle_random_func *) knuth_lfib_random,
+				       NULL));
+  ASSERT (ed25519_sha512_verify_batch (1, pub, length, m, sig, &rctx,
+				       (nettle_random_func *) knuth_lfib_random,
+				       NULL));
+  ASSERT (ed25519_sha512_verify_batch (BATCH_SIZE, pub, length, m, sig,
+				       &rctx,
+				       (nettle_random_func *) knuth_lfib_random,
+				       valid));
+  for (i = 0; i < BATCH_SIZE; i++)
+    ASSERT (valid[i]);
+
+  s[3][ED25519_SIGNATURE_SIZE/3] ^= 0x40;
+  s[150][2*ED25519_SIGNATURE_SIZE/3] ^= 0x40;
+  ASSERT (!ed25519_sha512_verify_batch (BATCH_SIZE, pub, length, m, sig,
+					&rctx,
+					(nettle_random_func *) knuth_lfib_random,
+					NULL));
+  ASSERT (!ed25519_sha512_verify_batch (BATCH_SIZE, pub, length, m, sig,
+					&rctx,
+					(nettle_random_func *) knuth_lfib_random,
+					valid));
+  for (i = 0; i < BATCH_SIZE; i++)
+    ASSERT (valid[i] == (i != 3 && i != 150));
+
+  /* Wrong key */
+  s[3][ED25519_SIGNATURE_SIZE/3] ^= 0x40;
+  s[150][2*ED25519_SIGNATURE_SIZE/3] ^= 0x40;
+  pub[42] = pk[1];
+  ASSERT (!ed25519_sha512_verify_batch (BATCH_SIZE, pub, length, m, sig,
+					&rctx,
+					(nettle_random_func *) knuth_lfib_random,
+					valid));
+  for (i = 0; i < BATCH_SIZE; i++)
+    ASSERT (valid[i] == (i != 42));
+}
+
+/* Sets dst to the encoding of P + (0, -1) = (-x, -y), where P = (x,
+   y) is encoded in src, with x, y != 0. The point (0, -1) has order
+   2. */
+static void
+add_order_2 (uint8_t *dst, const uint8_t *src)
+{
+  const unsigned last = ED25519_KEY_SIZE - 1;
+  int borrow, d;
+  unsigned i;
+
+  /* -y = p - y, with p = 2^255 - 19 */
+  for (i = borrow = 0; i < ED25519_KEY_SIZE; i++)
+    {
+      d = (i == 0 ? 0xed : i == last ? 0x7f : 0xff)
+	- (i == last ? src[i] & 0x7f : src[i]) - borrow;
+      borrow = d < 0;
+      dst[i] = d;
+    }
+  /* The top bit is the sign of x */
+  dst[last] |= ~src[last] & 0x80;
+}
+
+/* A signature for a public key with a small-order component, which
+   ed25519_sha512_verify rejects, but the cofactored batch equation
+   accepts. The per-signature result must not depend on whether or
+   not the rest of the batch is valid. */
+static void
+test_batch_small_order (void)
+{
+  struct knuth_lfib_ctx rctx;
+  uint8_t sk[ED25519_KEY_SIZE];
+  uint8_t pk[ED25519_KEY_SIZE];
+  uint8_t bad_pk[ED25519_KEY_SIZE];
+  uint8_t msg[3];
+  uint8_t s[3][ED25519_SIGNATURE_SIZE];
+  const uint8_t *pub[3];
+  const uint8_t *m[3];
+  const uint8_t *sig[3];
+  size_t length[3];
+  int valid[3];
+  unsigned i;
+
+  knuth_lfib_init (&rctx, 4711);
+  knuth_lfib_random (&rctx, ED25519_KEY_SIZE, sk);
+  ed25519_sha512_public_key (pk, sk);
+  add_order_2 (bad_pk, pk);
+
+  for (i = 0; i < 3; i++)
+    {
+      pub[i] = pk;
+      m[i] = msg + i;
+      sig[i] = s[i];
+      length[i] = 1;
+      msg[i] = i;
+      ed25519_sha512_sign (pk, sk, 1, m[i], s[i]);
+    }
+
+  /* Rejected by the single verify when h is odd. */
+  pub[1] = bad_pk;
+  for (i = 0; i < 64; i++)
+    {
+      msg[1] = 10 + i;
+      ed25519_sha512_sign (bad_pk, sk, 1, m[1], s[1]);
+      if (!ed25519_sha512_verify (bad_pk, 1, m[1], s[1]))
+	break;
+    }
+  ASSERT (i < 64);
+
+  ASSERT (ed25519_sha512_verify_batch (3, pub, length, m, sig, &rctx,
+				       (nettle_random_func *) knuth_lfib_random,
+				       valid));
+  ASSERT (valid[0] && valid[1] && valid[2]);
+
+  s[2][ED25519_SIGNATURE_SIZE - 5] ^= 1;
+  ASSERT (!ed25519_sha512_verify_batch (3, pub, length, m, sig, &rctx,
+					(nettle_random_func *) knuth_lfib_random,
+					valid));
+  ASSERT (valid[0] && valid[1] && !valid[2]);
+}
+
 void
 test_main(void)
 {
@@ -180,4 +336,6 @@ test_main(void)
       test_one ("c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025:fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025:af82:6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40aaf82:");
       test_one ("0d4a05b07352a5436e180356da0ae6efa0345ff7fb1572575772e8005ed978e9e61a185bcef2613a6c7cb79763ce945d3b245d76114dd440bcf5f2dc1aa57057:e61a185bcef2613a6c7cb79763ce945d3b245d76114dd440bcf5f2dc1aa57057:cbc77b:d9868d52c2bebce5f3fa5a79891970f309cb6591e3e1702a70276fa97c24b3a8e58606c38c9758529da50ee31b8219cba45271c689afa60b0ea26c99db19b00ccbc77b:");
     }
+  test_batch ();
+  test_batch_small_order ();
 }
@@ -0,0 +1,276 @@
+#include "testutils.h"
+
+#include "gcm-siv.h"
+#include "sha2.h"
+
+typedef void
+gcm_siv_encrypt_message_func(void *ctx, const uint8_t *nonce,
+			     size_t alength, const uint8_t *adata,
+			     size_t clength, uint8_t *dst, const uint8_t *src);
+
+typedef int
+gcm_siv_decrypt_message_func(void *ctx, const uint8_t *nonce,
+			     size_t alength, const uint8_t *adata,
+			     size_t mlength, uint8_t *dst, const uint8_t *src);
+
+/* The GCM-SIV functions don't fit the streaming nettle_aead
+   interface, so collect them here. */
+struct gcm_siv_alg
+{
+  const char *name;
+  size_t context_size;
+  size_t key_size;
+  nettle_set_key_func *set_key;
+  nettle_set_key_func *set_nonce;
+  nettle_hash_update_func *update;
+  nettle_crypt_func *encrypt;
+  nettle_hash_digest_func *digest;
+  gcm_siv_encrypt_message_func *encrypt_message;
+  gcm_siv_decrypt_message_func *decrypt_message;
+};
+
+static const struct gcm_siv_alg gcm_siv_aes128 =
+  { "gcm_siv_aes128", sizeof(struct gcm_siv_aes128_ctx),
+    AES128_KEY_SIZE,
+    (nettle_set_key_func *) gcm_siv_aes128_set_key,
+    (nettle_set_key_func *) gcm_siv_aes128_set_nonce,
+    (nettle_hash_update_func *) gcm_siv_aes128_update,
+    (nettle_crypt_func *) gcm_siv_aes128_encrypt,
+    (nettle_hash_digest_func *) gcm_siv_aes128_digest,
+    (gcm_siv_encrypt_message_func *) gcm_siv_aes128_encrypt_message,
+    (gcm_siv_decrypt_message_func *) gcm_siv_aes128_decrypt_message,
+  };
+
+static const struct gcm_siv_alg gcm_siv_aes256 =
+  { "gcm_siv_aes256", sizeof(struct gcm_siv_aes256_ctx),
+    AES256_KEY_SIZE,
+    (nettle_set_key_func *) gcm_siv_aes256_set_key,
+    (nettle_set_key_func *) gcm_siv_aes256_set_nonce,
+    (nettle_hash_update_func *) gcm_siv_aes256_update,
+    (nettle_crypt_func *) gcm_siv_aes256_encrypt,
+    (nettle_hash_digest_func *) gcm_siv_aes256_digest,
+    (gcm_siv_encrypt_message_func *) gcm_siv_aes256_encrypt_message,
+    (gcm_siv_decrypt_message_func *) gcm_siv_aes256_decrypt_message,
+  };
+
+static void
+check_gcm_siv(const struct gcm_siv_alg *alg,
+	      const struct tstring *key, const struct tstring *nonce,
+	      const struct tstring *adata,
+	      const struct tstring *msg, const struct tstring *cipher)
+{
+  void *ctx = xalloc(alg->context_size);
+  uint8_t *data = xalloc(cipher->length);
+  size_t split;
+
+  ASSERT(key->length == alg->key_size);
+  ASSERT(nonce->length == GCM_SIV_NONCE_SIZE);
+  ASSERT(cipher->length == msg->length + GCM_SIV_DIGEST_SIZE);
+
+  alg->set_key(ctx, key->data);
+
+  alg->encrypt_message(ctx, nonce->data, adata->length, adata->data,
+		       cipher->length, data, msg->data);
+  if (!MEMEQ(cipher->length, data, cipher->data))
+    {
+      fprintf(stderr, "%s encrypt_message failed:\nOutput: ", alg->name);
+      print_hex(cipher->length, data);
+      fprintf(stderr, "\nExpected:");
+      tstring_print_hex(cipher);
+      fprintf(stderr, "\n");
+      FAIL();
+    }
+
+  /* In place */
+  memcpy(data, msg->data, msg->length);
+  alg->encrypt_message(ctx, nonce->data, adata->length, adata->data,
+		       cipher->length, data, data);
+  ASSERT(MEMEQ(cipher->length, data, cipher->data));
+
+  ASSERT(alg->decrypt_message(ctx, nonce->data, adata->length, adata->data,
+			      msg->length, data, data));
+  ASSERT(MEMEQ(msg->length, data, msg->data));
+
+  /* Modified tag */
+  memcpy(data, cipher->data, cipher->length);
+  data[cipher->length - 1] ^= 1;
+  ASSERT(!alg->decrypt_message(ctx, nonce->data, adata->length, adata->data,
+			       msg->length, data, data));
+
+  if (adata->length > 0)
+    {
+      /* Modified associated data */
+      uint8_t *a = xalloc(adata->length);
+      memcpy(a, adata->data, adata->length);
+      a[0] ^= 0x80;
+      memcpy(data, cipher->data, cipher->length);
+      ASSERT(!alg->decrypt_message(ctx, nonce->data, adata->length, a,
+				   msg->length, data, data));
+      free(a);
+    }
+
+  /* Using the separate functions, with the associated data split
+     into two calls. */
+  split = adata->length & -(size_t) GCM_SIV_BLOCK_SIZE;
+  alg->set_nonce(ctx, nonce->data);
+  alg->update(ctx, split, adata->data);
+  alg->update(ctx, adata->length - split, adata->data + split);
+  alg->encrypt(ctx, msg->length, data, msg->data);
+  alg->digest(ctx, GCM_SIV_DIGEST_SIZE, data + msg->length);
+  ASSERT(MEMEQ(cipher->length, data, cipher->data));
+
+  free(ctx);
+  free(data);
+}
+
+static void
+test_gcm_siv_aes(const struct tstring *key, const struct tstring *nonce,
+		 const struct tstring *adata,
+		 const struct tstring *msg, const struct tstring *cipher)
+{
+  if (key->length == AES128_KEY_SIZE)
+    check_gcm_siv(&gcm_siv_aes128, key, nonce, adata, msg, cipher);
+  else
+    check_gcm_siv(&gcm_siv_aes256, key, nonce, adata, msg, cipher);
+}
+
+/* Long messages, spanning several buffers of the implementation, are
+   checked using the sha256 digest of the ciphertext and tag. The
+   plaintext is the sequence 7i + 3, and the associated data is the
+   37 octet sequence 5i + 1. */
+static void
+test_gcm_siv_aes_long(const struct tstring *key, const struct tstring *nonce,
+		      size_t length, const struct tstring *digest)
+{
+  const struct gcm_siv_alg *alg;
+  struct sha256_ctx hash;
+  uint8_t adata[37];
+  uint8_t *msg = xalloc(length);
+  uint8_t *data = xalloc(length + GCM_SIV_DIGEST_SIZE);
+  uint8_t d[SHA256_DIGEST_SIZE];
+  void *ctx;
+  size_t i;
+
+  alg = (key->length == AES128_KEY_SIZE) ? &gcm_siv_aes128 : &gcm_siv_aes256;
+
+  for (i = 0; i < sizeof(adata); i++)
+    adata[i] = 5*i + 1;
+  for (i = 0; i < length; i++)
+    msg[i] = 7*i + 3;
+
+  ctx = xalloc(alg->context_size);
+  alg->set_key(ctx, key->data);
+  alg->encrypt_message(ctx, nonce->data, sizeof(adata), adata,
+		       length + GCM_SIV_DIGEST_SIZE, data, msg);
+
+  sha256_init(&hash);
+  sha256_update(&hash, length + GCM_SIV_DIGEST_SIZE, data);
+  sha256_digest(&hash, sizeof(d), d);
+  ASSERT(MEMEQ(sizeof(d), d, digest->data));
+
+  ASSERT(alg->decrypt_message(ctx, nonce->data, sizeof(adata), adata,
+			      length, data, data));
+  ASSERT(MEMEQ(length, data, msg));
+
+  free(ctx);
+  free(msg);
+  free(data);
+}
+
+void
+test_main(void)
+{
+  /* From RFC 8452, appendix C */
+  test_gcm_siv_aes(SHEX("01000000000000000000000000000000"),
+		   SHEX("030000000000000000000000"),
+		   SHEX(""), SHEX(""),
+		   SHEX("dc20e2d83f25705bb49e439eca56de25"));
+  test_gcm_siv_aes(SHEX("01000000000000000000000000000000"),
+		   SHEX("030000000000000000000000"),
+		   SHEX(""), SHEX("0100000000000000"),
+		   SHEX("b5d839330ac7b786578782fff6013b81"
+			"5b287c22493a364c"));
+  test_gcm_siv_aes(SHEX("01000000000000000000000000000000"
+			"00000000000000000000000000000000"),
+		   SHEX("030000000000000000000000"),
+		   SHEX(""), SHEX(""),
+		   SHEX("07f5f4169bbf55a8400cd47ea6fd400f"));
+  test_gcm_siv_aes(SHEX("01000000000000000000000000000000"
+			"00000000000000000000000000000000"),
+		   SHEX("030000000000000000000000"),
+		   SHEX(""), SHEX("0100000000000000"),
+		   SHEX("c2ef328e5c71c83b843122130f7364b7"
+			"61e0b97427e3df28"));
+
+  /* Generated by an independent implementation, with partial and
+     multiple blocks of associated data and message. */
+  test_gcm_siv_aes(SHEX("000102030405060708090a0b0c0d0e0f"),
+		   SHEX("101112131415161718191a1b"),
+		   SHEX("40"),
+		   SHEX("808182838485868788898a8b"),
+		   SHEX("3210b10e49f5e066d6b7f7aefeda4bb0"
+			"eabe96164f35ebe728211624"));
+  test_gcm_siv_aes(SHEX("000102030405060708090a0b0c0d0e0f"),
+		   SHEX("101112131415161718191a1b"),
+		   SHEX("404142434445464748494a4b4c4d4e4f"),
+		   SHEX("808182838485868788898a8b8c8d8e8f"),
+		   SHEX("2bfc173322f4a37ce496c6ba138bfd15"
+			"e8b2b83d08815e7eedf27516b017a8fe"));
+  test_gcm_siv_aes(SHEX("000102030405060708090a0b0c0d0e0f"),
+		   SHEX("101112131415161718191a1b"),
+		   SHEX("404142434445464748494a4b4c4d4e4f"
+			"50515253"),
+		   SHEX("808182838485868788898a8b8c8d8e8f"
+			"909192939495969798999a9b9c9d9e9f"
+			"a0a1a2a3a4a5a6a7a8a9aaabacadae"),
+		   SHEX("58152a08a19ed15e94af9dd74c1fab88"
+			"93e1ac70fa6280d280b78c85bd423fa5"
+			"68e9d57936a6625e57d35271a7611c"
+			"6f2850f702d45c0bfb3d0adca6042e9f"));
+  test_gcm_siv_aes(SHEX("000102030405060708090a0b0c0d0e0f"
+			"101112131415161718191a1b1c1d1e1f"),
+		   SHEX("101112131415161718191a1b"),
+		   SHEX(""), SHEX(""),
+		   SHEX("6126b614e19e2eca7fb80223db0aa3b3"));
+  test_gcm_siv_aes(SHEX("000102030405060708090a0b0c0d0e0f"
+			"101112131415161718191a1b1c1d1e1f"),
+		   SHEX("101112131415161718191a1b"),
+		   SHEX("404142434445464748494a4b"),
+		   SHEX("8081828384858687"),
+		   SHEX("b7e68cb1c8175620852329f075acab49"
+			"fcfa445e3c0d84db"));
+  test_gcm_siv_aes(SHEX("000102030405060708090a0b0c0d0e0f"
+			"101112131415161718191a1b1c1d1e1f"),
+		   SHEX("101112131415161718191a1b"),
+		   SHEX("404142434445464748494a4b4c4d4e4f"
+			"505152535455565758595a5b5c5d5e5f"
+			"60"),
+		   SHEX("808182838485868788898a8b8c8d8e8f"
+			"909192939495969798999a9b9c9d9e9f"
+			"a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+			"b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"),
+		   SHEX("c86d9b80b43c2fef2e7594999f65d52d"
+			"70a962dff58f3660ecd2c2b179e50499"
+			"8eaa648b3d8a209077f612cd932e7eef"
+			"7c848529ad347718ad31b6e5f3781909"
+			"c703310a897b72de27310fa11be86e9d"));
+
+  test_gcm_siv_aes_long(SHEX("000102030405060708090a0b0c0d0e0f"),
+			SHEX("101112131415161718191a1b"), 600,
+			SHEX("8c68a3e20ca626705ba0e96d8f1b9adc"
+			     "54bc974ff8d3a5dfda86f5b91b821b7a"));
+  test_gcm_siv_aes_long(SHEX("000102030405060708090a0b0c0d0e0f"),
+			SHEX("101112131415161718191a1b"), 1000,
+			SHEX("3c454592ae237f7d0323cf5afbed166c"
+			     "e51619e68f1e32b43ed74911f725fa51"));
+  test_gcm_siv_aes_long(SHEX("000102030405060708090a0b0c0d0e0f"
+			     "101112131415161718191a1b1c1d1e1f"),
+			SHEX("101112131415161718191a1b"), 600,
+			SHEX("e78602461a9b73aa8a0e503b8578a022"
+			     "8c54ce058dc2c7f79998ca27b98f2e01"));
+  test_gcm_siv_aes_long(SHEX("000102030405060708090a0b0c0d0e0f"
+			     "101112131415161718191a1b1c1d1e1f"),
+			SHEX("101112131415161718191a1b"), 1000,
+			SHEX("5b5bdd951f8344e5adb600dc80443f95"
+			     "41cdf9017cee65f778a59fc7a022698e"));
+}
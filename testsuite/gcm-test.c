@@ -514,6 +514,61 @@ test_main(void)
 		 "16aedbf5a0de6a57 a637b39b"),	/* iv */
 	    SHEX("5791883f822013f8bd136fc36fb9946b"));	/* tag */
 
+  /* Longer messages, to exercise implementations processing several
+     blocks at a time. Generated with nettle, checked with openssl. */
+  test_aead(&nettle_gcm_aes128, NULL,
+	    SHEX("000102030405060708090a0b0c0d0e0f"),	/* key */
+	    SHEX("f0efeeedecebeae9e8e7e6e5e4e3e2e1e0dfdedd"),	/* auth data */
+	    SHEX("00070e151c232a31383f464d545b626970777e858c939aa1a8afb6bdc4cbd2d9"
+		 "e0e7eef5fc030a11181f262d343b424950575e656c737a81888f969da4abb2b9"
+		 "c0c7ced5dce3eaf1f8ff060d141b222930373e454c535a61686f767d848b9299"
+		 "a0a7aeb5bcc3cad1d8dfe6edf4fb020910171e252c333a41484f565d646b7279"
+		 "80878e959ca3aab1b8bfc6cdd4dbe2e9f0f7fe050c131a21282f363d444b5259"
+		 "60676e757c838a91989fa6adb4bbc2c9d0d7dee5ecf3fa01080f161d242b3239"
+		 "40474e555c636a71787f868d949ba2a9b0b7bec5ccd3dae1e8eff6fd040b1219"
+		 "20272e353c434a51585f666d747b828990979ea5acb3bac1c8cfd6dde4ebf2f9"
+		 "00070e151c232a31383f464d545b626970777e858c939aa1a8afb6bdc4cbd2d9"
+		 "e0e7eef5fc030a11181f262d"),	/* plaintext */
+	    SHEX("aa8136ae62aa193bb247f34d1249d20923995d8d0f84a70e8dbfc72686465d71"
+		 "7a44abc4f3e9e67c67c1c4e99be04b99ec03122c5ff2ec6c0ab9185741ceb6c4"
+		 "31f67d07b7957b3328ec89bf4d3267a97c8e646b33b2d1c079745f452ef39ed9"
+		 "a64cd0a98da0146ddabe5698a11a99a6218f4aaf044257949bc958f4a877bf09"
+		 "02662d6de8c47e93140b755a4cf649ac6e986eb573bc4198c92451e53fe371fd"
+		 "b589bea3cae092e5199019e4e7b297c93093b05b8371a44d8a3ef391f451fa8f"
+		 "3a394fdf12726a79e232acfabe17766c46985434e7e7cbecac54a973aba05d0d"
+		 "38184978e23caa69a75a7345071fd84b62378c90c31efcfbdcf24de093dd242c"
+		 "7443765dacc7ed5b6267590d909c735ba71a2a50fd570894e76339dac53fcc8c"
+		 "0a8e8ee125aae43e60bd386d"),	/* ciphertext */
+	    SHEX("a0a1a2a3a4a5a6a7a8a9aaab"),	/* iv */
+	    SHEX("d23aaffbf67a277ce04d43279b3294a7"));	/* tag */
+
+  test_aead(&nettle_gcm_aes256, NULL,
+	    SHEX("000102030405060708090a0b0c0d0e0f"
+		 "101112131415161718191a1b1c1d1e1f"),	/* key */
+	    SHEX("f0efeeedecebeae9e8e7e6e5e4e3e2e1e0dfdedd"),	/* auth data */
+	    SHEX("00070e151c232a31383f464d545b626970777e858c939aa1a8afb6bdc4cbd2d9"
+		 "e0e7eef5fc030a11181f262d343b424950575e656c737a81888f969da4abb2b9"
+		 "c0c7ced5dce3eaf1f8ff060d141b222930373e454c535a61686f767d848b9299"
+		 "a0a7aeb5bcc3cad1d8dfe6edf4fb020910171e252c333a41484f565d646b7279"
+		 "80878e959ca3aab1b8bfc6cdd4dbe2e9f0f7fe050c131a21282f363d444b5259"
+		 "60676e757c838a91989fa6adb4bbc2c9d0d7dee5ecf3fa01080f161d242b3239"
+		 "40474e555c636a71787f868d949ba2a9b0b7bec5ccd3dae1e8eff6fd040b1219"
+		 "20272e353c434a51585f666d747b828990979ea5acb3bac1c8cfd6dde4ebf2f9"
+		 "00070e151c232a31383f464d545b626970777e858c939aa1a8afb6bdc4cbd2d9"
+		 "e0e7eef5fc030a11181f262d"),	/* plaintext */
+	    SHEX("e61f723859e8288e5a5ac19e5321a2b700db27951e24d8cd34a1903bbb60a7d8"
+		 "3291a90a5321592c478322e53d41c1b0174c182d0ea360ffc9d19dc300db3709"
+		 "747b4bbaec460e110c1df9159bd5ee93fd3c95e18992c31b861a48e73511df0d"
+		 "2f23851ebf6d454a4604e0bd7173ef2134477f8bf206a17d678088f9d03e8034"
+		 "45963eea4fe12aa68fe63846c691733f782e536eb2c3e0add5e28bc8eb8c6672"
+		 "a67f71c4cae9ca871a958d8fdb697428a7f1237dee95543f8a8d602478a92d6e"
+		 "7471029c3cb2d19c8b22c642ddbf901ce25e5a2df3b00259052eae1859cdc87e"
+		 "48761c14852e936e98e324323670c2f69b2a5c9a25e1ca46a3627bb781d8da6b"
+		 "1738c792f3ef88d15e9c11c833600eba486674d53729598b50c8a067267b56f4"
+		 "7bafa857dc0177dcfd726801"),	/* ciphertext */
+	    SHEX("a0a1a2a3a4a5a6a7a8a9aaab"),	/* iv */
+	    SHEX("35b435b2bba989e9760dee7c66b12125"));	/* tag */
+
   /* Test gcm_hash, with varying message size, keys and iv all zero.
      Not compared to any other implementation. */
   test_gcm_hash (SDATA("a"),
@@ -552,5 +607,22 @@ test_main(void)
 		 SHEX("65f8245330febf15 6fd95e324304c258"));
   test_gcm_hash (SDATA("abcdefghijklmnopqr"),
 		 SHEX("d07259e85d4fc998 5a662eed41c8ed1d"));
+
+  /* Longer messages, to exercise implementations processing several
+     blocks at a time. */
+  test_gcm_hash (SDATA("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+		       "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+		       "abcd"),
+		 SHEX("b9d46ab6937d7e51 35d31835373a1891"));
+  test_gcm_hash (SDATA("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+		       "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+		       "abcdefghijklmnopqrstuvwxyzABCDEFG"),
+		 SHEX("25b7686e1cca877b cd7d2070508d01bc"));
+  test_gcm_hash (SDATA("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+		       "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+		       "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+		       "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+		       "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"),
+		 SHEX("c70c541e84f7430f 6adecdea41c78c73"));
 }
 
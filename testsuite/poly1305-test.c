@@ -83,4 +83,16 @@ test_main(void)
          "5c1bf9"), 63,
     SHEX("5154ad0d2cb26e01274fc51148491f1b"));
 
+  /* Long enough to use the multi-block code, with partial blocks
+     carried between calls. */
+  test_poly1305
+   (SHEX("6acb5f61a7176dd320c5c1eb2edcdc74"
+         "48443d0bb0d21109c89a100b5ce2c208"),
+    SHEX("ae212a55399729595dea458bc621ff0e"),
+    SHEX("0b30557a9fc4e90e33587da2c7ec11365b80a5caef14395e83a8cdf2173c"
+         "6186abd0f51a3f6489aed3f81d42678cb1d6fb20456a8fb4d9fe23486d92"
+         "b7dc01264b7095badf04294e7398bde2072c51769bc0e50a2f54799ec3e8"
+         "0d32577ca1c6eb10355a7fa4c9ee13385d82a7ccf1163b6085aacff4193e"
+         "6388add2f71c41668bb0d5fa1f44698eb3d8fd22476c91b6db00254a6f94"), 1000,
+    SHEX("fa2695d8f511c57859863081bdbe0ca1"));
 }
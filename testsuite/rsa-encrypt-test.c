@@ -8,6 +8,8 @@ test_main(void)
 {
   struct rsa_public_key pub;
   struct rsa_private_key key;
+  struct rsa_blinding_ctx blinding;
+  struct rsa_prepared_private_key prep;
   struct knuth_lfib_ctx lfib;
 
   /* FIXME: How is this spelled? */
@@ -17,12 +19,15 @@ test_main(void)
   uint8_t *decrypted;
   size_t decrypted_length;
   uint8_t after;
+  uint8_t *ciphertext;
+  mp_limb_t *scratch;
 
   mpz_t gibberish;
 
   rsa_private_key_init(&key);
   rsa_public_key_init(&pub);
   mpz_init(gibberish);
+  rsa_blinding_init(&blinding);
 
   knuth_lfib_init(&lfib, 17);
   
@@ -76,6 +81,41 @@ test_main(void)
   ASSERT(MEMEQ(msg_length, msg, decrypted));
   ASSERT(decrypted[msg_length] == after);
 
+  knuth_lfib_random (&lfib, msg_length + 1, decrypted);
+  after = decrypted[msg_length];
+
+  decrypted_length = msg_length;
+  ASSERT(rsa_decrypt_blinding_tr(&pub, &key, &blinding,
+				 &lfib, (nettle_random_func *) knuth_lfib_random,
+				 &decrypted_length, decrypted, gibberish));
+  ASSERT(decrypted_length == msg_length);
+  ASSERT(MEMEQ(msg_length, msg, decrypted));
+  ASSERT(decrypted[msg_length] == after);
+
+  /* Prepared key */
+  ASSERT(rsa_prepared_private_key_init(&prep, &pub, &key));
+  scratch = xalloc(rsa_prepared_itch(&prep) * sizeof(mp_limb_t));
+  ciphertext = xalloc(key.size);
+  nettle_mpz_get_str_256(key.size, ciphertext, gibberish);
+
+  knuth_lfib_random (&lfib, msg_length + 1, decrypted);
+  after = decrypted[msg_length];
+
+  decrypted_length = msg_length - 1;
+  ASSERT(!rsa_prepared_decrypt_tr(&prep, NULL,
+				  &lfib, (nettle_random_func *) knuth_lfib_random,
+				  &decrypted_length, decrypted, ciphertext,
+				  scratch));
+
+  decrypted_length = msg_length;
+  ASSERT(rsa_prepared_decrypt_tr(&prep, NULL,
+				 &lfib, (nettle_random_func *) knuth_lfib_random,
+				 &decrypted_length, decrypted, ciphertext,
+				 scratch));
+  ASSERT(decrypted_length == msg_length);
+  ASSERT(MEMEQ(msg_length, msg, decrypted));
+  ASSERT(decrypted[msg_length] == after);
+
   /* Test invalid key. */
   mpz_add_ui (key.q, key.q, 2);
   decrypted_length = key.size;
@@ -83,9 +123,19 @@ test_main(void)
 			 &lfib, (nettle_random_func *) knuth_lfib_random,
 			 &decrypted_length, decrypted, gibberish));
 
+  ASSERT(rsa_prepared_private_key_init(&prep, &pub, &key));
+  decrypted_length = key.size;
+  ASSERT(!rsa_prepared_decrypt_tr(&prep, NULL,
+				  &lfib, (nettle_random_func *) knuth_lfib_random,
+				  &decrypted_length, decrypted, ciphertext,
+				  scratch));
+
   rsa_private_key_clear(&key);
   rsa_public_key_clear(&pub);
   mpz_clear(gibberish);
+  rsa_blinding_clear(&blinding);
   free(decrypted);
+  free(ciphertext);
+  free(scratch);
 }
   
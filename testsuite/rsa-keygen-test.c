@@ -35,12 +35,12 @@ test_main(void)
   test_rsa_key(&pub, &key);
 
   mpz_set_str(expected,
-	      "31ee088024b66f28" "e182fa07e60f7864" "636eea21cf74c804"
-	      "02a9c29ebd00933d" "8fae3ddf029d18e0" "1b5498c70a4b68fd"
-	      "d3135748424e8caf" "43ee86068f250c92" "8da001d09f68c433"
-	      "96f2c2a42eaed7e5" "8934a052faa38b2c" "f2ac04cc91bd0d15"
-	      "4f60b16dc9045b08" "2ea1372717fd7f9c" "1e9cc383b7d5b909"
-	      "72e3126df060ef79" , 16);
+	      "c960a91754132e74" "cea3691b5d5d1bb4" "b4a227a38d5b0538"
+	      "836ee09f9767015d" "25b5ee8654af4417" "e29c89c2cfb67bc1"
+	      "ece0c22c6dd1c7e9" "81287c8a1df46c3b" "283fccb3e10999ae"
+	      "f7506b327ff35488" "3bdc9ff1bc2a0351" "5434e1ffdcc10a88"
+	      "deb3f81925371886" "a229ec2d32b250dd" "1a2f1f415749e706"
+	      "d39ec09bf24f31cf" , 16);
 
   test_rsa_md5(&pub, &key, expected);
 
@@ -57,17 +57,17 @@ test_main(void)
   test_rsa_key(&pub, &key);
 
   mpz_set_str(expected,
-	      "892ef7cda3b0b501" "85de20b93340316e" "b35ac9c193f1f5a3"
-	      "9e6c1c327b9c36b8" "d4f1d41653b48fbd" "0c49e48bbdc46ced"
-	      "13b3f6426e8a1780" "55b9077ba59ce748" "a325563c3b4bdf78"
-	      "acdcdd556f5de3cf" "70257c3b334ba360" "5625ebda869c8058"
-	      "b95b40c1e75eb91b" "776e83c0224757c6" "b61266cb1739df1a"
-	      "c7fcc09194c575b5" "af4f3eb8e3aa3900" "22b72fb6e950c355"
-	      "88743bab32c3a214" "ea5865e2f5c41d67" "12e745496890fc9d"
-	      "7944a759f39d7b57" "e365d8d3f6ac2dd4" "052b6a2e58a6af82"
-	      "b0d67e7fe09045d9" "bc965e260cf3c9a9" "3bfaa09bdd076dc2"
-	      "c0ab48ce5b67105c" "cad90dcfc11cd713" "e64478d2d7ea42dd"
-	      "fd040793c487588d" "6218" , 16);
+	      "939950c16ef90d44" "f92a03da6af46f76" "d4993f3b2020dc8d"
+	      "bc844814384df7db" "d76e687417ce5b7b" "e2b1b6e8bce8221d"
+	      "ef15d6497518649d" "9fd5e4694e8a4a63" "2a61a6e49467f3a3"
+	      "0d93eea854e25eb5" "79f3c179a125f987" "ef8590d647b16e1d"
+	      "2d6e28aca65dfd6d" "a24910143cb5ec45" "bdcd7be5c70f35d0"
+	      "0515957736f7a43b" "349adde1a19168be" "7d48c1d2ccf8a66e"
+	      "84b8053eefe33be3" "fb5abf7afd3deaaa" "aeabbf2eb346f7b8"
+	      "bb3678f94217b3c7" "0b7b009c2d0285cf" "aebb4640bce4c01b"
+	      "d6fb56acb4b82ae1" "5686efde648da10e" "f4db0df77273af87"
+	      "4ffb809605281d13" "17fc5d230d41e3a9" "be4dacdc5e9d7178"
+	      "b60b67045b47d850" "01d" , 16);
 
   test_rsa_sha1(&pub, &key, expected);
   
@@ -13,8 +13,19 @@ test_rsa_sign_tr(struct rsa_public_key *pub,
 {
   mpz_t signature;
   struct knuth_lfib_ctx lfib;
+  struct rsa_blinding_ctx blinding;
+  struct rsa_prepared_private_key prep;
+  struct rsa_prepared_blinding_ctx prep_blinding;
+  struct rsa_prepared_public_key prep_pub;
+  mp_limb_t *scratch;
+  mp_limb_t *pub_scratch;
+  uint8_t *s1;
+  uint8_t *s2;
+  unsigned i;
 
   knuth_lfib_init(&lfib, 1111);
+  rsa_blinding_init(&blinding);
+  rsa_prepared_blinding_init(&prep_blinding);
 
   mpz_init(signature);
   mpz_set_ui (signature, 17);
@@ -25,6 +36,16 @@ test_rsa_sign_tr(struct rsa_public_key *pub,
 		    &lfib, (nettle_random_func *) knuth_lfib_random,
 		    di_length, di, signature));
 
+  ASSERT(rsa_prepared_private_key_init(&prep, pub, key));
+  scratch = xalloc(rsa_prepared_itch(&prep) * sizeof(mp_limb_t));
+  s1 = xalloc(key->size);
+  s2 = xalloc(key->size);
+  memset(s1, 17, key->size);
+  ASSERT(!rsa_prepared_pkcs1_sign_tr(&prep, NULL,
+				     &lfib, (nettle_random_func *) knuth_lfib_random,
+				     di_length, di, s1, scratch));
+  ASSERT(s1[0] == 17 && s1[key->size - 1] == 17);
+
   mpz_sub_ui(key->p, key->p, 2);
 
   ASSERT(!mpz_cmp_ui(signature, 17));
@@ -45,6 +66,91 @@ test_rsa_sign_tr(struct rsa_public_key *pub,
 
   ASSERT (mpz_cmp(signature, expected) == 0);
 
+  /* Cached blinding, with a fresh blinding factor, and then
+     squared ones */
+  for (i = 0; i < 3; i++)
+    {
+      mpz_set_ui (signature, 17);
+      ASSERT(rsa_pkcs1_sign_blinding_tr(pub, key, &blinding,
+					&lfib, (nettle_random_func *) knuth_lfib_random,
+					di_length, di, signature));
+      ASSERT (mpz_cmp(signature, expected) == 0);
+    }
+  /* A bad blinding factor must be detected, and discarded. */
+  mpz_add_ui (blinding.re, blinding.re, 1);
+  ASSERT(!rsa_pkcs1_sign_blinding_tr(pub, key, &blinding,
+				     &lfib, (nettle_random_func *) knuth_lfib_random,
+				     di_length, di, signature));
+  ASSERT(rsa_pkcs1_sign_blinding_tr(pub, key, &blinding,
+				    &lfib, (nettle_random_func *) knuth_lfib_random,
+				    di_length, di, signature));
+  ASSERT (mpz_cmp(signature, expected) == 0);
+
+  /* Try the prepared key */
+  ASSERT(rsa_prepared_private_key_init(&prep, pub, key));
+  nettle_mpz_get_str_256(key->size, s2, expected);
+  ASSERT(rsa_prepared_pkcs1_sign_tr(&prep, NULL,
+				    &lfib, (nettle_random_func *) knuth_lfib_random,
+				    di_length, di, s1, scratch));
+  ASSERT (MEMEQ(key->size, s1, s2));
+
+  for (i = 0; i < 3; i++)
+    {
+      memset(s1, 17, key->size);
+      ASSERT(rsa_prepared_pkcs1_sign_tr(&prep, &prep_blinding,
+					&lfib, (nettle_random_func *) knuth_lfib_random,
+					di_length, di, s1, scratch));
+      ASSERT (MEMEQ(key->size, s1, s2));
+    }
+  prep_blinding.ri[0] ^= 1;
+  ASSERT(!rsa_prepared_pkcs1_sign_tr(&prep, &prep_blinding,
+				     &lfib, (nettle_random_func *) knuth_lfib_random,
+				     di_length, di, s1, scratch));
+  ASSERT(rsa_prepared_pkcs1_sign_tr(&prep, &prep_blinding,
+				    &lfib, (nettle_random_func *) knuth_lfib_random,
+				    di_length, di, s1, scratch));
+  ASSERT (MEMEQ(key->size, s1, s2));
+
+  /* And the m < n check */
+  memset(s2, 0xff, key->size);
+  ASSERT (!rsa_prepared_compute_root_tr(&prep, NULL,
+					&lfib, (nettle_random_func *) knuth_lfib_random,
+					s1, s2, scratch));
+
+  /* Prepared verify, s1 still holding the expected signature */
+  ASSERT(rsa_prepared_public_key_init(&prep_pub, pub));
+  pub_scratch = xalloc(rsa_prepared_public_itch(&prep_pub) * sizeof(mp_limb_t));
+  ASSERT (rsa_prepared_pkcs1_verify(&prep_pub, di_length, di, s1, pub_scratch));
+  ASSERT (!rsa_prepared_pkcs1_verify(&prep_pub, 16, (void*)"The magick words",
+				     s1, pub_scratch));
+  s1[key->size / 2] ^= 0x10;
+  ASSERT (!rsa_prepared_pkcs1_verify(&prep_pub, di_length, di, s1, pub_scratch));
+
+  /* Batch verify, s1 now bad and s2 good */
+  nettle_mpz_get_str_256(key->size, s2, expected);
+  {
+    const uint8_t *dis[5];
+    const uint8_t *ss[5];
+    uint8_t bad_di[64];
+    int res[5];
+
+    ASSERT (di_length <= sizeof(bad_di));
+    memcpy (bad_di, di, di_length);
+    bad_di[0] ^= 1;
+    for (i = 0; i < 5; i++)
+      {
+	dis[i] = di;
+	ss[i] = (i & 1) ? s1 : s2;
+      }
+    dis[4] = bad_di;
+    ASSERT (!rsa_prepared_pkcs1_verify_batch(&prep_pub, 5, di_length, dis, ss,
+					     res, pub_scratch));
+    ASSERT (res[0] && !res[1] && res[2] && !res[3] && !res[4]);
+    ASSERT (rsa_pkcs1_verify_batch(pub, 1, di_length, dis, ss, res));
+    ASSERT (res[0]);
+  }
+  free(pub_scratch);
+
   /* Try bad data */
   ASSERT (!rsa_pkcs1_verify(pub, 16, (void*)"The magick words", signature));
 
@@ -56,6 +162,10 @@ test_rsa_sign_tr(struct rsa_public_key *pub,
   ASSERT (!rsa_pkcs1_verify(pub, di_length, di, signature));
 
   mpz_clear(signature);
+  rsa_blinding_clear(&blinding);
+  free(scratch);
+  free(s1);
+  free(s2);
 }
 
 
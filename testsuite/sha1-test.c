@@ -1,8 +1,17 @@
 #include "testutils.h"
 
+#define TEST_N_MAX 17
+
+static const struct test_hash_n sha1_n =
+  { &nettle_sha1,
+    (test_hash_update_n_func *) sha1_update_n,
+    (test_hash_digest_n_func *) sha1_digest_n };
+
 void
 test_main(void)
 {
+  unsigned n;
+
   test_hash(&nettle_sha1, SDATA(""),
 	    SHEX("DA39A3EE5E6B4B0D 3255BFEF95601890 AFD80709")); 
 
@@ -31,6 +40,17 @@ test_main(void)
   /* Additional test vector, from Daniel Kahn Gillmor */
   test_hash(&nettle_sha1, SDATA("38"),
 	    SHEX("5b384ce32d8cdef02bc3a139d4cac0a22bb029e8"));
+
+  for (n = 1; n <= TEST_N_MAX; n += 4)
+    {
+      test_hash_n (&sha1_n, n, 0);
+      test_hash_n (&sha1_n, n, 1);
+      test_hash_n (&sha1_n, n, 55);
+      test_hash_n (&sha1_n, n, 64);
+      test_hash_n (&sha1_n, n, 100);
+      test_hash_n (&sha1_n, n, 1000);
+    }
+  test_hash_n (&sha1_n, 8, 128);
 }
 
 /* These are intermediate values for the single sha1_compress call
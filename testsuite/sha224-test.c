@@ -1,8 +1,17 @@
 #include "testutils.h"
 
+#define TEST_N_MAX 17
+
+static const struct test_hash_n sha224_n =
+  { &nettle_sha224,
+    (test_hash_update_n_func *) sha224_update_n,
+    (test_hash_digest_n_func *) sha224_digest_n };
+
 void
 test_main(void)
 {
+  unsigned n;
+
   /* From FIPS180-2 addendum
      (http://csrc.nist.gov/publications/fips/fips180-2/fips180-2withchangenotice.pdf) */
   test_hash(&nettle_sha224, SDATA("abc"),
@@ -42,4 +51,15 @@ test_main(void)
 		  "5678901234567890"),
 	    SHEX("b50aecbe4e9bb0b5 7bc5f3ae760a8e01"
 		 "db24f203fb3cdcd1 3148046e"));
+
+  for (n = 1; n <= TEST_N_MAX; n += 4)
+    {
+      test_hash_n (&sha224_n, n, 0);
+      test_hash_n (&sha224_n, n, 1);
+      test_hash_n (&sha224_n, n, 55);
+      test_hash_n (&sha224_n, n, 64);
+      test_hash_n (&sha224_n, n, 100);
+      test_hash_n (&sha224_n, n, 1000);
+    }
+  test_hash_n (&sha224_n, 8, 128);
 }
@@ -1,8 +1,17 @@
 #include "testutils.h"
 
+#define TEST_N_MAX 17
+
+static const struct test_hash_n sha256_n =
+  { &nettle_sha256,
+    (test_hash_update_n_func *) sha256_update_n,
+    (test_hash_digest_n_func *) sha256_digest_n };
+
 void
 test_main(void)
 {
+  unsigned n;
+
   /* From FIPS180-2 */
   test_hash(&nettle_sha256, SDATA("abc"),
 	    SHEX("ba7816bf8f01cfea 414140de5dae2223"
@@ -49,6 +58,17 @@ test_main(void)
 		  "5678901234567890"),
 	    SHEX("f371bc4a311f2b00 9eef952dd83ca80e"
 		 "2b60026c8e935592 d0f9c308453c813e"));
+
+  for (n = 1; n <= TEST_N_MAX; n += 4)
+    {
+      test_hash_n (&sha256_n, n, 0);
+      test_hash_n (&sha256_n, n, 1);
+      test_hash_n (&sha256_n, n, 55);
+      test_hash_n (&sha256_n, n, 64);
+      test_hash_n (&sha256_n, n, 100);
+      test_hash_n (&sha256_n, n, 1000);
+    }
+  test_hash_n (&sha256_n, 8, 128);
 }
 
 /* These are intermediate values for the single sha1_compress call
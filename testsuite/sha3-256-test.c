@@ -1,8 +1,19 @@
 #include "testutils.h"
 
+#include "sha3.h"
+
+#define TEST_N_MAX 9
+
+static const struct test_hash_n sha3_256_n =
+  { &nettle_sha3_256,
+    (test_hash_update_n_func *) sha3_256_update_n,
+    (test_hash_digest_n_func *) sha3_256_digest_n };
+
 void
 test_main(void)
 {
+  unsigned n;
+
   /* Extracted from ShortMsgKAT_256.txt using sha3.awk. */
   test_hash(&nettle_sha3_256, /* 0 octets */
 	    SHEX(""),
@@ -772,4 +783,15 @@ test_main(void)
   test_hash(&nettle_sha3_256, /* 255 octets */
 	    SHEX("3A3A819C48EFDE2AD914FBF00E18AB6BC4F14513AB27D0C178A188B61431E7F5623CB66B23346775D386B50E982C493ADBBFC54B9A3CD383382336A1A0B2150A15358F336D03AE18F666C7573D55C4FD181C29E6CCFDE63EA35F0ADF5885CFC0A3D84A2B2E4DD24496DB789E663170CEF74798AA1BBCD4574EA0BBA40489D764B2F83AADC66B148B4A0CD95246C127D5871C4F11418690A5DDF01246A0C80A43C70088B6183639DCFDA4125BD113A8F49EE23ED306FAAC576C3FB0C1E256671D817FC2534A52F5B439F72E424DE376F4C565CCA82307DD9EF76DA5B7C4EB7E085172E328807C02D011FFBF33785378D79DC266F6A5BE6BB0E4A92ECEEBAEB1"),
 	    SHEX("C11F3522A8FB7B3532D80B6D40023A92B489ADDAD93BF5D64B23F35E9663521C"));
+
+  for (n = 1; n <= TEST_N_MAX; n += 2)
+    {
+      test_hash_n (&sha3_256_n, n, 0);
+      test_hash_n (&sha3_256_n, n, 1);
+      test_hash_n (&sha3_256_n, n, 135);
+      test_hash_n (&sha3_256_n, n, 136);
+      test_hash_n (&sha3_256_n, n, 300);
+      test_hash_n (&sha3_256_n, n, 1000);
+    }
+  test_hash_n (&sha3_256_n, 4, 272);
 }
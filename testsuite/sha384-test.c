@@ -1,8 +1,17 @@
 #include "testutils.h"
 
+#define TEST_N_MAX 9
+
+static const struct test_hash_n sha384_n =
+  { &nettle_sha384,
+    (test_hash_update_n_func *) sha384_update_n,
+    (test_hash_digest_n_func *) sha384_digest_n };
+
 void
 test_main(void)
 {
+  unsigned n;
+
   test_hash(&nettle_sha384, SDATA("abc"),
 	    SHEX("cb00753f45a35e8b b5a03d699ac65007"
 		 "272c32ab0eded163 1a8b605a43ff5bed"
@@ -51,4 +60,15 @@ test_main(void)
 	    SHEX("b12932b0627d1c06 0942f54477641556"
 		 "55bd4da0c9afa6dd 9b9ef53129af1b8f"
 		 "b0195996d2de9ca0 df9d821ffee67026"));
+
+  for (n = 1; n <= TEST_N_MAX; n += 2)
+    {
+      test_hash_n (&sha384_n, n, 0);
+      test_hash_n (&sha384_n, n, 1);
+      test_hash_n (&sha384_n, n, 111);
+      test_hash_n (&sha384_n, n, 128);
+      test_hash_n (&sha384_n, n, 200);
+      test_hash_n (&sha384_n, n, 1000);
+    }
+  test_hash_n (&sha384_n, 4, 256);
 }
@@ -1,8 +1,17 @@
 #include "testutils.h"
 
+#define TEST_N_MAX 9
+
+static const struct test_hash_n sha512_n =
+  { &nettle_sha512,
+    (test_hash_update_n_func *) sha512_update_n,
+    (test_hash_digest_n_func *) sha512_digest_n };
+
 void
 test_main(void)
 {
+  unsigned n;
+
   test_hash(&nettle_sha512, SDATA("abc"),
 	    SHEX("ddaf35a193617aba cc417349ae204131"
 		 "12e6fa4e89a97ea2 0a9eeee64b55d39a"
@@ -108,6 +117,17 @@ test_main(void)
 		 "135bb61de24ec0d1 914042246e0aec3a"
 		 "2354e093d76f3048 b456764346900cb1"
 		 "30d2a4fd5dd16abb 5e30bcb850dee843"));
+
+  for (n = 1; n <= TEST_N_MAX; n += 2)
+    {
+      test_hash_n (&sha512_n, n, 0);
+      test_hash_n (&sha512_n, n, 1);
+      test_hash_n (&sha512_n, n, 111);
+      test_hash_n (&sha512_n, n, 128);
+      test_hash_n (&sha512_n, n, 200);
+      test_hash_n (&sha512_n, n, 1000);
+    }
+  test_hash_n (&sha512_n, 4, 256);
 }
 
 /* For first test case.
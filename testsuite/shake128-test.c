@@ -0,0 +1,71 @@
+#include "testutils.h"
+
+#include "sha3.h"
+
+/* Checks the output of sha3_128_shake, and of sha3_128_shake_output
+   called with several different sizes. */
+static void
+test_shake128 (const struct tstring *msg, const struct tstring *expected)
+{
+  static const unsigned step[] = { 1, 7, 16, 17, SHA3_128_BLOCK_SIZE, 300 };
+  struct sha3_128_ctx ctx;
+  uint8_t *buffer;
+  size_t done;
+  unsigned i;
+
+  buffer = xalloc (expected->length);
+
+  sha3_128_init (&ctx);
+  sha3_128_update (&ctx, msg->length, msg->data);
+  sha3_128_shake (&ctx, expected->length, buffer);
+  ASSERT (MEMEQ (expected->length, buffer, expected->data));
+
+  /* The context is reset */
+  sha3_128_update (&ctx, msg->length, msg->data);
+  for (done = 0, i = 0; done < expected->length; i++)
+    {
+      size_t size = step[i % (sizeof(step) / sizeof(step[0]))];
+      if (size > expected->length - done)
+	size = expected->length - done;
+      sha3_128_shake_output (&ctx, size, buffer + done);
+      done += size;
+    }
+  if (!MEMEQ (expected->length, buffer, expected->data))
+    {
+      fprintf (stderr, "sha3_128_shake_output failed, msg: ");
+      tstring_print_hex (msg);
+      fprintf (stderr, "output: ");
+      print_hex (expected->length, buffer);
+      fprintf (stderr, "expected: ");
+      tstring_print_hex (expected);
+      FAIL ();
+    }
+  free (buffer);
+}
+
+void
+test_main(void)
+{
+  test_shake128 (SDATA(""),
+		 SHEX("7F9C2BA4E88F827D616045507605853ED73B8093F6EFBC88EB1A6EACFA66EF26"));
+  test_shake128 (SDATA("abc"),
+		 SHEX("5881092DD818BF5CF8A3DDB793FBCBA74097D5C526A6D35F97B83351940F2CC8"));
+  /* 200 octets 0xa3, with output longer than one block */
+  test_shake128 (SHEX("A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3"
+		      "A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3"
+		      "A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3"
+		      "A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3"
+		      "A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3"
+		      "A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3"
+		      "A3A3A3A3A3A3A3A3"),
+		 SHEX("131AB8D2B594946B9C81333F9BB6E0CE75C3B93104FA3469D3917457385DA037"
+		      "CF232EF7164A6D1EB448C8908186AD852D3F85A5CF28DA1AB6FE343817197846"
+		      "7F1C05D58C7EF38C284C41F6C2221A76F12AB1C04082660250802294FB871802"
+		      "13FDEF5B0ECB7DF50CA1F8555BE14D32E10F6EDCDE892C09424B29F597AFC270"
+		      "C904556BFCB47A7D40778D390923642B3CBD0579E60908D5A000C1D08B98EF93"
+		      "3F806445BF87F8B009BA9E94F7266122ED7AC24E5E266C42A82FA1BBEFB7B8DB"
+		      "0066E16A85E0493F07DF4809AEC084A593748AC3DDE5A6D7AAE1E8B6E5352B2D"
+		      "71EFBB47D4CAEED5E6D633805D2D323E6FD81B4684B93A2677D45E7421C2C6AE"
+		      "A259B855A698FD7D13477A1FE53E5A4A6197DBEC5CE95F505B520BCD9570C4A8"
+		      "265A7E01F89C0C002C59BFEC"));
+}
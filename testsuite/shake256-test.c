@@ -0,0 +1,73 @@
+#include "testutils.h"
+
+#include "sha3.h"
+
+/* Checks the output of sha3_256_shake, and of sha3_256_shake_output
+   called with several different sizes. */
+static void
+test_shake256 (const struct tstring *msg, const struct tstring *expected)
+{
+  static const unsigned step[] = { 1, 7, 16, 17, SHA3_256_BLOCK_SIZE, 300 };
+  struct sha3_256_ctx ctx;
+  uint8_t *buffer;
+  size_t done;
+  unsigned i;
+
+  buffer = xalloc (expected->length);
+
+  sha3_256_init (&ctx);
+  sha3_256_update (&ctx, msg->length, msg->data);
+  sha3_256_shake (&ctx, expected->length, buffer);
+  ASSERT (MEMEQ (expected->length, buffer, expected->data));
+
+  /* The context is reset */
+  sha3_256_update (&ctx, msg->length, msg->data);
+  for (done = 0, i = 0; done < expected->length; i++)
+    {
+      size_t size = step[i % (sizeof(step) / sizeof(step[0]))];
+      if (size > expected->length - done)
+	size = expected->length - done;
+      sha3_256_shake_output (&ctx, size, buffer + done);
+      done += size;
+    }
+  if (!MEMEQ (expected->length, buffer, expected->data))
+    {
+      fprintf (stderr, "sha3_256_shake_output failed, msg: ");
+      tstring_print_hex (msg);
+      fprintf (stderr, "output: ");
+      print_hex (expected->length, buffer);
+      fprintf (stderr, "expected: ");
+      tstring_print_hex (expected);
+      FAIL ();
+    }
+  free (buffer);
+}
+
+void
+test_main(void)
+{
+  test_shake256 (SDATA(""),
+		 SHEX("46B9DD2B0BA88D13233B3FEB743EEB243FCD52EA62B81B82B50C27646ED5762F"
+		      "D75DC4DDD8C0F200CB05019D67B592F6FC821C49479AB48640292EACB3B7C4BE"));
+  test_shake256 (SDATA("abc"),
+		 SHEX("483366601360A8771C6863080CC4114D8DB44530F8F1E1EE4F94EA37E78B5739"
+		      "D5A15BEF186A5386C75744C0527E1FAA9F8726E462A12A4FEB06BD8801E751E4"));
+  /* 200 octets 0xa3, with output longer than one block */
+  test_shake256 (SHEX("A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3"
+		      "A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3"
+		      "A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3"
+		      "A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3"
+		      "A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3"
+		      "A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3A3"
+		      "A3A3A3A3A3A3A3A3"),
+		 SHEX("CD8A920ED141AA0407A22D59288652E9D9F1A7EE0C1E7C1CA699424DA84A904D"
+		      "2D700CAAE7396ECE96604440577DA4F3AA22AEB8857F961C4CD8E06F0AE6610B"
+		      "1048A7F64E1074CD629E85AD7566048EFC4FB500B486A3309A8F26724C0ED628"
+		      "001A1099422468DE726F1061D99EB9E93604D5AA7467D4B1BD6484582A384317"
+		      "D7F47D750B8F5499512BB85A226C4243556E696F6BD072C5AA2D9B69730244B5"
+		      "6853D16970AD817E213E470618178001C9FB56C54FEFA5FEE67D2DA524BB3B0B"
+		      "61EF0E9114A92CDBB6CCCB98615CFE76E3510DD88D1CC28FF99287512F24BFAF"
+		      "A1A76877B6F37198E3A641C68A7C42D45FA7ACC10DAE5F3CEFB7B735F12D4E58"
+		      "9F7A456E78C0F5E4C4471FFFA5E4FA0514AE974D8C2648513B5DB494CEA84715"
+		      "6D277AD0E141C24C7839064C"));
+}
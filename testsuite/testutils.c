@@ -524,6 +524,80 @@ test_hash(const struct nettle_hash *hash,
   free(input);
 }
 
+/* Hashes n messages of different lengths with the _n functions, and
+   compares to the single message functions. Each message starts with
+   a short prefix hashed one at a time, so that the contexts have
+   different amounts of buffered data. */
+void
+test_hash_n(const struct test_hash_n *hash_n, unsigned n, size_t length)
+{
+  const struct nettle_hash *hash = hash_n->hash;
+  size_t size = length + hash->block_size + 3;
+  uint8_t *ctx = xalloc(n * hash->context_size);
+  void **cp = xalloc(n * sizeof(*cp));
+  const uint8_t **dp = xalloc(n * sizeof(*dp));
+  uint8_t **digest = xalloc(n * sizeof(*digest));
+  uint8_t *data = xalloc(n * size);
+  uint8_t *out = xalloc(n * hash->digest_size);
+  uint8_t *expected = xalloc(hash->digest_size);
+  uint8_t *empty = xalloc(hash->digest_size);
+  void *ref = xalloc(hash->context_size);
+  unsigned i;
+
+  for (i = 0; i < n * size; i++)
+    data[i] = i * 17 + (i >> 8);
+
+  for (i = 0; i < n; i++)
+    {
+      size_t prefix = (29 * i) % hash->block_size;
+      cp[i] = ctx + i * hash->context_size;
+      hash->init(cp[i]);
+      hash->update(cp[i], prefix, data + i * size);
+      dp[i] = data + i * size + prefix;
+      digest[i] = out + i * hash->digest_size;
+    }
+
+  hash_n->update_n(n, cp, length, dp);
+  for (i = 0; i < n; i++)
+    dp[i] += length;
+  hash_n->update_n(n, cp, 3, dp);
+  hash_n->digest_n(n, cp, hash->digest_size, digest);
+
+  hash->init(ref);
+  hash->digest(ref, hash->digest_size, empty);
+
+  for (i = 0; i < n; i++)
+    {
+      hash->update(ref, (29 * i) % hash->block_size + length + 3,
+		   data + i * size);
+      hash->digest(ref, hash->digest_size, expected);
+
+      if (!MEMEQ(hash->digest_size, digest[i], expected))
+	{
+	  fprintf(stderr, "%s _n functions failed: "
+		  "n = %u, length = %u, i = %u\n",
+		  hash->name, n, (unsigned) length, i);
+	  fprintf(stderr, "digest: ");
+	  print_hex(hash->digest_size, digest[i]);
+	  fprintf(stderr, "expected: ");
+	  print_hex(hash->digest_size, expected);
+	  FAIL();
+	}
+      /* The contexts are reset by the digest. */
+      hash->digest(cp[i], hash->digest_size, expected);
+      ASSERT(MEMEQ(hash->digest_size, expected, empty));
+    }
+  free(ctx);
+  free(cp);
+  free(dp);
+  free(digest);
+  free(data);
+  free(out);
+  free(expected);
+  free(empty);
+  free(ref);
+}
+
 void
 test_hash_large(const struct nettle_hash *hash,
 		size_t count, size_t length,
@@ -651,7 +725,104 @@ xalloc_limbs (mp_size_t n)
   return xalloc (n * sizeof (mp_limb_t));
 }
 
-/* Expects local variables pub, key, rstate, digest, signature */
+typedef int
+rsa_prepared_sign_func (const struct rsa_prepared_private_key *key,
+			struct rsa_prepared_blinding_ctx *blinding,
+			void *random_ctx, nettle_random_func *random,
+			const uint8_t *digest,
+			uint8_t *signature,
+			mp_limb_t *scratch);
+
+static void
+test_rsa_prepared_sign (const struct rsa_public_key *pub,
+			const struct rsa_private_key *key,
+			rsa_prepared_sign_func *sign,
+			const uint8_t *digest, const mpz_t expected)
+{
+  struct rsa_prepared_private_key prep;
+  struct rsa_prepared_blinding_ctx blinding;
+  struct knuth_lfib_ctx rstate;
+  mp_limb_t *scratch;
+  uint8_t *signature;
+  uint8_t *ref;
+  unsigned i;
+
+  knuth_lfib_init (&rstate, 16);
+
+  ASSERT (rsa_prepared_private_key_init (&prep, pub, key));
+  ASSERT (prep.size == key->size);
+
+  scratch = xalloc_limbs (rsa_prepared_itch (&prep));
+  signature = xalloc (key->size);
+  ref = xalloc (key->size);
+
+  nettle_mpz_get_str_256 (key->size, ref, expected);
+  ASSERT (sign (&prep, NULL,
+		&rstate, (nettle_random_func *) knuth_lfib_random,
+		digest, signature, scratch));
+  ASSERT (MEMEQ (key->size, signature, ref));
+
+  rsa_prepared_blinding_init (&blinding);
+  for (i = 0; i < 3; i++)
+    {
+      ASSERT (sign (&prep, &blinding,
+		    &rstate, (nettle_random_func *) knuth_lfib_random,
+		    digest, signature, scratch));
+      ASSERT (MEMEQ (key->size, signature, ref));
+    }
+
+  free (scratch);
+  free (signature);
+  free (ref);
+}
+
+typedef int
+rsa_prepared_verify_func (const struct rsa_prepared_public_key *key,
+			  const uint8_t *digest,
+			  const uint8_t *signature,
+			  mp_limb_t *scratch);
+
+static void
+test_rsa_prepared_verify (const struct rsa_public_key *pub,
+			  rsa_prepared_verify_func *verify,
+			  size_t digest_size, const uint8_t *digest,
+			  const mpz_t expected)
+{
+  struct rsa_prepared_public_key prep;
+  uint8_t bad_digest[SHA512_DIGEST_SIZE];
+  mp_limb_t *scratch;
+  uint8_t *signature;
+
+  ASSERT (digest_size <= sizeof (bad_digest));
+  ASSERT (rsa_prepared_public_key_init (&prep, pub));
+  ASSERT (prep.size == pub->size);
+
+  scratch = xalloc_limbs (rsa_prepared_public_itch (&prep));
+  signature = xalloc (pub->size);
+
+  nettle_mpz_get_str_256 (pub->size, signature, expected);
+  ASSERT (verify (&prep, digest, signature, scratch));
+
+  /* Try bad data */
+  memcpy (bad_digest, digest, digest_size);
+  bad_digest[digest_size - 1] ^= 1;
+  ASSERT (!verify (&prep, bad_digest, signature, scratch));
+
+  /* Try bad signatures */
+  signature[pub->size - 3] ^= 2;
+  ASSERT (!verify (&prep, digest, signature, scratch));
+
+  memset (signature, 0, pub->size);
+  ASSERT (!verify (&prep, digest, signature, scratch));
+
+  nettle_mpz_get_str_256 (pub->size, signature, pub->n);
+  ASSERT (!verify (&prep, digest, signature, scratch));
+
+  free (scratch);
+  free (signature);
+}
+
+/* Expects local variables pub, key, rstate, blinding, digest, signature */
 #define SIGN(hash, msg, expected) do { \
   hash##_update(&hash, LDATA(msg));					\
   ASSERT(rsa_##hash##_sign(key, &hash, signature));			\
@@ -678,6 +849,22 @@ xalloc_limbs (mp_size_t n)
 				     (nettle_random_func *)knuth_lfib_random, \
 				     digest, signature));		\
   ASSERT(mpz_cmp (signature, expected) == 0);				\
+									\
+  ASSERT(rsa_##hash##_sign_digest_blinding_tr(pub, key, &blinding,	\
+					      &rstate,			\
+					      (nettle_random_func *)knuth_lfib_random, \
+					      digest, signature));	\
+  ASSERT(mpz_cmp (signature, expected) == 0);				\
+  ASSERT(rsa_##hash##_sign_digest_blinding_tr(pub, key, &blinding,	\
+					      &rstate,			\
+					      (nettle_random_func *)knuth_lfib_random, \
+					      digest, signature));	\
+  ASSERT(mpz_cmp (signature, expected) == 0);				\
+									\
+  test_rsa_prepared_sign(pub, key, rsa_prepared_##hash##_sign_digest_tr, \
+			 digest, expected);				\
+  test_rsa_prepared_verify(pub, rsa_prepared_##hash##_verify_digest,	\
+			   sizeof(digest), digest, expected);		\
 } while(0)
 
 #define VERIFY(key, hash, msg, signature) (	\
@@ -783,12 +970,14 @@ test_rsa_md5(struct rsa_public_key *pub,
 {
   struct md5_ctx md5;
   struct knuth_lfib_ctx rstate;
+  struct rsa_blinding_ctx blinding;
   uint8_t digest[MD5_DIGEST_SIZE];
   mpz_t signature;
 
   md5_init(&md5);
   mpz_init(signature);
   knuth_lfib_init (&rstate, 15);
+  rsa_blinding_init (&blinding);
 
   SIGN(md5, "The magic words are squeamish ossifrage", expected);
 
@@ -806,6 +995,7 @@ test_rsa_md5(struct rsa_public_key *pub,
 		  "The magic words are squeamish ossifrage", signature));
 
   mpz_clear(signature);
+  rsa_blinding_clear (&blinding);
 }
 
 void
@@ -815,12 +1005,14 @@ test_rsa_sha1(struct rsa_public_key *pub,
 {
   struct sha1_ctx sha1;
   struct knuth_lfib_ctx rstate;
+  struct rsa_blinding_ctx blinding;
   uint8_t digest[SHA1_DIGEST_SIZE];
   mpz_t signature;
 
   sha1_init(&sha1);
   mpz_init(signature);
   knuth_lfib_init (&rstate, 16);
+  rsa_blinding_init (&blinding);
 
   SIGN(sha1, "The magic words are squeamish ossifrage", expected);
 
@@ -838,6 +1030,7 @@ test_rsa_sha1(struct rsa_public_key *pub,
 		  "The magic words are squeamish ossifrage", signature));
 
   mpz_clear(signature);
+  rsa_blinding_clear (&blinding);
 }
 
 void
@@ -847,15 +1040,51 @@ test_rsa_sha256(struct rsa_public_key *pub,
 {
   struct sha256_ctx sha256;
   struct knuth_lfib_ctx rstate;
+  struct rsa_blinding_ctx blinding;
   uint8_t digest[SHA256_DIGEST_SIZE];
+  uint8_t bad_digest[SHA256_DIGEST_SIZE];
+  const uint8_t *digests[6];
+  const uint8_t *signatures[6];
+  uint8_t *good;
+  uint8_t *bad;
+  int res[6];
   mpz_t signature;
 
   sha256_init(&sha256);
   mpz_init(signature);
   knuth_lfib_init (&rstate, 17);
+  rsa_blinding_init (&blinding);
 
   SIGN(sha256, "The magic words are squeamish ossifrage", expected);
 
+  /* Batch verify, with a mix of good and bad signatures, spanning
+     more than one lock-step batch. */
+  good = xalloc (pub->size);
+  bad = xalloc (pub->size);
+  nettle_mpz_get_str_256 (pub->size, good, expected);
+  memcpy (bad, good, pub->size);
+  bad[pub->size / 2] ^= 4;
+  memcpy (bad_digest, digest, sizeof(digest));
+  bad_digest[0] ^= 1;
+
+  digests[0] = digest; signatures[0] = good;
+  digests[1] = bad_digest; signatures[1] = good;
+  digests[2] = digest; signatures[2] = bad;
+  digests[3] = digest; signatures[3] = good;
+  digests[4] = digest; signatures[4] = good;
+  digests[5] = digest; signatures[5] = bad;
+
+  ASSERT (!rsa_sha256_verify_digest_batch (pub, 6, digests, signatures, res));
+  ASSERT (res[0] && !res[1] && !res[2] && res[3] && res[4] && !res[5]);
+
+  ASSERT (rsa_sha256_verify_digest_batch (pub, 1, digests + 3,
+					  signatures + 3, res));
+  ASSERT (res[0]);
+  ASSERT (rsa_sha256_verify_digest_batch (pub, 0, digests, signatures, res));
+
+  free (good);
+  free (bad);
+
   /* Try bad data */
   ASSERT (!VERIFY(pub, sha256,
 		  "The magick words are squeamish ossifrage", signature));
@@ -870,6 +1099,7 @@ test_rsa_sha256(struct rsa_public_key *pub,
 		  "The magic words are squeamish ossifrage", signature));
 
   mpz_clear(signature);
+  rsa_blinding_clear (&blinding);
 }
 
 void
@@ -879,12 +1109,14 @@ test_rsa_sha512(struct rsa_public_key *pub,
 {
   struct sha512_ctx sha512;
   struct knuth_lfib_ctx rstate;
+  struct rsa_blinding_ctx blinding;
   uint8_t digest[SHA512_DIGEST_SIZE];
   mpz_t signature;
 
   sha512_init(&sha512);
   mpz_init(signature);
   knuth_lfib_init (&rstate, 18);
+  rsa_blinding_init (&blinding);
 
   SIGN(sha512, "The magic words are squeamish ossifrage", expected);
 
@@ -902,6 +1134,7 @@ test_rsa_sha512(struct rsa_public_key *pub,
 		  "The magic words are squeamish ossifrage", signature));
 
   mpz_clear(signature);
+  rsa_blinding_clear (&blinding);
 }
 
 #undef SIGN
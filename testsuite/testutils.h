@@ -156,6 +156,25 @@ test_hash_large(const struct nettle_hash *hash,
 		uint8_t c,
 		const struct tstring *digest);
 
+/* For the functions processing several messages in parallel, like
+   sha256_update_n and sha256_digest_n. */
+typedef void
+test_hash_update_n_func(unsigned n, void **ctx,
+			size_t length, const uint8_t **data);
+typedef void
+test_hash_digest_n_func(unsigned n, void **ctx,
+			size_t length, uint8_t **digest);
+
+struct test_hash_n
+{
+  const struct nettle_hash *hash;
+  test_hash_update_n_func *update_n;
+  test_hash_digest_n_func *digest_n;
+};
+
+void
+test_hash_n(const struct test_hash_n *hash_n, unsigned n, size_t length);
+
 void
 test_armor(const struct nettle_armor *armor,
            size_t data_length,
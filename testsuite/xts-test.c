@@ -0,0 +1,201 @@
+#include "testutils.h"
+
+#include "aes.h"
+#include "sha2.h"
+#include "xts.h"
+
+typedef void
+xts_crypt_func(const void *ctx, const uint8_t *tweak, size_t length,
+	       uint8_t *dst, const uint8_t *src);
+
+static void
+check_xts(const char *name, const void *ctx, xts_crypt_func *crypt,
+	  const struct tstring *tweak,
+	  const struct tstring *in, const struct tstring *out)
+{
+  uint8_t *data = xalloc(in->length);
+
+  crypt(ctx, tweak->data, in->length, data, in->data);
+  if (!MEMEQ(out->length, data, out->data))
+    {
+      fprintf(stderr, "%s failed:\nInput:", name);
+      tstring_print_hex(in);
+      fprintf(stderr, "\nOutput: ");
+      print_hex(out->length, data);
+      fprintf(stderr, "\nExpected:");
+      tstring_print_hex(out);
+      fprintf(stderr, "\n");
+      FAIL();
+    }
+
+  /* In place */
+  memcpy(data, in->data, in->length);
+  crypt(ctx, tweak->data, in->length, data, data);
+  if (!MEMEQ(out->length, data, out->data))
+    {
+      fprintf(stderr, "%s in place failed.\n", name);
+      FAIL();
+    }
+  free(data);
+}
+
+static void
+test_xts_aes(const struct tstring *key, const struct tstring *tweak,
+	     const struct tstring *msg, const struct tstring *cipher)
+{
+  ASSERT(tweak->length == XTS_BLOCK_SIZE);
+  ASSERT(msg->length == cipher->length);
+
+  if (key->length == XTS_AES128_KEY_SIZE)
+    {
+      struct xts_aes128_key ctx;
+      xts_aes128_set_encrypt_key(&ctx, key->data);
+      check_xts("xts_aes128_encrypt_message", &ctx,
+		(xts_crypt_func *) xts_aes128_encrypt_message,
+		tweak, msg, cipher);
+      xts_aes128_set_decrypt_key(&ctx, key->data);
+      check_xts("xts_aes128_decrypt_message", &ctx,
+		(xts_crypt_func *) xts_aes128_decrypt_message,
+		tweak, cipher, msg);
+    }
+  else
+    {
+      struct xts_aes256_key ctx;
+      ASSERT(key->length == XTS_AES256_KEY_SIZE);
+      xts_aes256_set_encrypt_key(&ctx, key->data);
+      check_xts("xts_aes256_encrypt_message", &ctx,
+		(xts_crypt_func *) xts_aes256_encrypt_message,
+		tweak, msg, cipher);
+      xts_aes256_set_decrypt_key(&ctx, key->data);
+      check_xts("xts_aes256_decrypt_message", &ctx,
+		(xts_crypt_func *) xts_aes256_decrypt_message,
+		tweak, cipher, msg);
+    }
+}
+
+/* Long messages, spanning several buffers of the implementation, are
+   checked using the sha256 digest of the ciphertext. The plaintext
+   is the sequence 7i + 3. */
+static void
+test_xts_aes_long(const struct tstring *key, const struct tstring *tweak,
+		  size_t length, const struct tstring *digest)
+{
+  struct tstring *msg = tstring_alloc(length);
+  struct tstring *cipher = tstring_alloc(length);
+  struct sha256_ctx hash;
+  uint8_t buffer[SHA256_DIGEST_SIZE];
+  size_t i;
+
+  for (i = 0; i < length; i++)
+    msg->data[i] = (7*i + 3) & 0xff;
+
+  if (key->length == XTS_AES128_KEY_SIZE)
+    {
+      struct xts_aes128_key ctx;
+      xts_aes128_set_encrypt_key(&ctx, key->data);
+      xts_aes128_encrypt_message(&ctx, tweak->data, length,
+				 cipher->data, msg->data);
+    }
+  else
+    {
+      struct xts_aes256_key ctx;
+      xts_aes256_set_encrypt_key(&ctx, key->data);
+      xts_aes256_encrypt_message(&ctx, tweak->data, length,
+				 cipher->data, msg->data);
+    }
+
+  sha256_init(&hash);
+  sha256_update(&hash, length, cipher->data);
+  sha256_digest(&hash, sizeof(buffer), buffer);
+  ASSERT(MEMEQ(digest->length, buffer, digest->data));
+
+  test_xts_aes(key, tweak, msg, cipher);
+}
+
+void
+test_main(void)
+{
+  /* From IEEE Std 1619-2007, vector 1 */
+  test_xts_aes(SHEX("00000000000000000000000000000000"
+		    "00000000000000000000000000000000"),
+	       SHEX("00000000000000000000000000000000"),
+	       SHEX("00000000000000000000000000000000"
+		    "00000000000000000000000000000000"),
+	       SHEX("917cf69ebd68b2ec9b9fe9a3eadda692"
+		    "cd43d2f59598ed858c02c2652fbf922e"));
+
+  /* Generated with OpenSSL */
+  test_xts_aes(SHEX("0b30557a9fc4e90e33587da2c7ec1136"
+		    "5b80a5caef14395e83a8cdf2173c6186"),
+	       SHEX("20304050600000000000000000000000"),
+	       SHEX("030a11181f262d343b424950575e656c"
+		    "737a81888f969da4abb2b9c0c7ced5dc"),
+	       SHEX("8f8c0ad05ac55e7c70fa5a49537d0a86"
+		    "228f1d4961b03dd99429c7d761f773db"));
+
+  /* Ciphertext stealing */
+  test_xts_aes(SHEX("0b30557a9fc4e90e33587da2c7ec1136"
+		    "5b80a5caef14395e83a8cdf2173c6186"),
+	       SHEX("11213141510000000000000000000000"),
+	       SHEX("030a11181f262d343b424950575e656c"
+		    "73"),
+	       SHEX("11f0683e5e5f3ae32f997bba8fb74246"
+		    "0c"));
+
+  test_xts_aes(SHEX("0b30557a9fc4e90e33587da2c7ec1136"
+		    "5b80a5caef14395e83a8cdf2173c6186"),
+	       SHEX("1f2f3f4f5f0000000000000000000000"),
+	       SHEX("030a11181f262d343b424950575e656c"
+		    "737a81888f969da4abb2b9c0c7ced5"),
+	       SHEX("e3618eeb5e52936e886b29727431d483"
+		    "d4a25fbb05ac4baf3e41ec68d15388"));
+
+  test_xts_aes(SHEX("0b30557a9fc4e90e33587da2c7ec1136"
+		    "5b80a5caef14395e83a8cdf2173c6186"
+		    "abd0f51a3f6489aed3f81d42678cb1d6"
+		    "fb20456a8fb4d9fe23486d92b7dc0126"),
+	       SHEX("40506070800000000000000000000000"),
+	       SHEX("030a11181f262d343b424950575e656c"
+		    "737a81888f969da4abb2b9c0c7ced5dc"
+		    "e3eaf1f8ff060d141b222930373e454c"
+		    "535a61686f767d848b9299a0a7aeb5bc"),
+	       SHEX("f40a5c9bb72da1e053afd16ef28ae74d"
+		    "0b07571728fcfc5241e2ae1148e96bbe"
+		    "f61b5175671ca90c5d7f7fe3f315d261"
+		    "e365c72dbc17c76f1b54ff36a1c30952"));
+
+  test_xts_aes(SHEX("0b30557a9fc4e90e33587da2c7ec1136"
+		    "5b80a5caef14395e83a8cdf2173c6186"
+		    "abd0f51a3f6489aed3f81d42678cb1d6"
+		    "fb20456a8fb4d9fe23486d92b7dc0126"),
+	       SHEX("2d3d4d5d6d0000000000000000000000"),
+	       SHEX("030a11181f262d343b424950575e656c"
+		    "737a81888f969da4abb2b9c0c7ced5dc"
+		    "e3eaf1f8ff060d141b22293037"),
+	       SHEX("26529b0ef354907aa67119034707f596"
+		    "28cfc25649f23e47b86fc3c794011711"
+		    "1a03dfae6cfaf2505ad1a95bed"));
+
+  test_xts_aes_long(SHEX("0b30557a9fc4e90e33587da2c7ec1136"
+			 "5b80a5caef14395e83a8cdf2173c6186"),
+		    SHEX("00102030400000000000000000000000"),
+		    4096,
+		    SHEX("401b70b05b0c78014d3762c43535fb01"
+			 "94a1ad976309a0cae1820e0941e608e7"));
+
+  test_xts_aes_long(SHEX("0b30557a9fc4e90e33587da2c7ec1136"
+			 "5b80a5caef14395e83a8cdf2173c6186"),
+		    SHEX("58687888980000000000000000000000"),
+		    600,
+		    SHEX("629f8874f775deda9ec70356d7ede26b"
+			 "7e04e346b465834ff482112d8f2aec6a"));
+
+  test_xts_aes_long(SHEX("0b30557a9fc4e90e33587da2c7ec1136"
+			 "5b80a5caef14395e83a8cdf2173c6186"
+			 "abd0f51a3f6489aed3f81d42678cb1d6"
+			 "fb20456a8fb4d9fe23486d92b7dc0126"),
+		    SHEX("05152535450000000000000000000000"),
+		    4101,
+		    SHEX("a9df56a4939f831a11c4ac874f759219"
+			 "4961ff25c70d143ab1fff18349bad498"));
+}
@@ -0,0 +1,177 @@
+C x86_64/aesni/aes-cbc-decrypt.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+
+C CBC decryption using the aesdec instructions. Eight blocks are
+C decrypted in parallel, and xored with the preceding ciphertext
+C blocks in registers. All ciphertext of a group is loaded before
+C any output is stored, so dst == src is allowed.
+
+C Input argument
+define(<ROUNDS>, <%rdi>)
+define(<KEYS>,	<%rsi>)
+define(<IV>,	<%rdx>)
+define(<LENGTH>,<%rcx>)
+define(<DST>,	<%r8>)
+define(<SRC>,	<%r9>)
+
+C Subkey pointer
+define(<KEY>,	<%rax>)
+C Pointer to the last subkey
+define(<LAST>,	<%rdi>)
+
+define(<K>,	<%xmm8>)
+define(<X>,	<%xmm9>)
+define(<T>,	<%xmm10>)
+
+C OP8(op, src)
+C Applies the instruction op, with the given source operand, to all
+C eight blocks.
+define(<OP8>, <
+	$1	$2, %xmm0
+	$1	$2, %xmm1
+	$1	$2, %xmm2
+	$1	$2, %xmm3
+	$1	$2, %xmm4
+	$1	$2, %xmm5
+	$1	$2, %xmm6
+	$1	$2, %xmm7
+>)
+
+C XOR_PREV(xmm, offset)
+C Xors the ciphertext block preceding the one at offset.
+define(<XOR_PREV>, <
+	movups	eval($2 - 16)(SRC), T
+	pxor	T, $1
+>)
+
+	.file "aes-cbc-decrypt.asm"
+
+	C _aes_cbc_decrypt(unsigned rounds, const uint32_t *keys,
+	C		   uint8_t *iv, size_t length,
+	C		   uint8_t *dst, const uint8_t *src)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_aes_cbc_decrypt)
+	W64_ENTRY(6, 11)
+	shl	$4, XREG(ROUNDS)
+	add	KEYS, LAST
+
+	movups	(IV), X
+
+	sub	$128, LENGTH
+	jc	.Lblock8_done
+
+	ALIGN(16)
+.Lblock8_loop:
+	movups	(SRC), %xmm0
+	movups	16(SRC), %xmm1
+	movups	32(SRC), %xmm2
+	movups	48(SRC), %xmm3
+	movups	64(SRC), %xmm4
+	movups	80(SRC), %xmm5
+	movups	96(SRC), %xmm6
+	movups	112(SRC), %xmm7
+
+	movups	(KEYS), K
+	OP8(pxor, K)
+	lea	16(KEYS), KEY
+
+.Lround8_loop:
+	movups	(KEY), K
+	OP8(aesdec, K)
+	add	$16, KEY
+	cmp	KEY, LAST
+	jne	.Lround8_loop
+
+	movups	(KEY), K
+	OP8(aesdeclast, K)
+
+	pxor	X, %xmm0
+	XOR_PREV(%xmm1, 16)
+	XOR_PREV(%xmm2, 32)
+	XOR_PREV(%xmm3, 48)
+	XOR_PREV(%xmm4, 64)
+	XOR_PREV(%xmm5, 80)
+	XOR_PREV(%xmm6, 96)
+	XOR_PREV(%xmm7, 112)
+	movups	112(SRC), X
+
+	movups	%xmm0, (DST)
+	movups	%xmm1, 16(DST)
+	movups	%xmm2, 32(DST)
+	movups	%xmm3, 48(DST)
+	movups	%xmm4, 64(DST)
+	movups	%xmm5, 80(DST)
+	movups	%xmm6, 96(DST)
+	movups	%xmm7, 112(DST)
+
+	add	$128, SRC
+	add	$128, DST
+	sub	$128, LENGTH
+	jnc	.Lblock8_loop
+
+.Lblock8_done:
+	add	$128, LENGTH
+	jz	.Lend
+
+.Lblock_loop:
+	movups	(SRC), %xmm0
+	movaps	%xmm0, T
+	movups	(KEYS), K
+	pxor	K, %xmm0
+	lea	16(KEYS), KEY
+
+.Lround_loop:
+	movups	(KEY), K
+	aesdec	K, %xmm0
+	add	$16, KEY
+	cmp	KEY, LAST
+	jne	.Lround_loop
+
+	movups	(KEY), K
+	aesdeclast	K, %xmm0
+	pxor	X, %xmm0
+	movaps	T, X
+	movups	%xmm0, (DST)
+
+	add	$16, SRC
+	add	$16, DST
+	sub	$16, LENGTH
+	jnz	.Lblock_loop
+
+.Lend:
+	movups	X, (IV)
+
+	W64_EXIT(6, 11)
+	ret
+EPILOGUE(_nettle_aes_cbc_decrypt)
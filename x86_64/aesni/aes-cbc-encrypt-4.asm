@@ -0,0 +1,175 @@
+C x86_64/aesni/aes-cbc-encrypt-4.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+
+C CBC encryption of four independent streams, each with its own key
+C and iv, using the aesenc instructions. Each stream is serial, but
+C interleaving the rounds of the four streams keeps the aes unit
+C busy. The chaining values stay in registers, and are written back
+C to the iv arrays at the end. For each block, the input of all
+C streams is loaded before any output is stored, so a stream may use
+C dst == src, and unused lanes may duplicate another stream.
+
+C Input argument
+define(<ROUNDS>, <%rdi>)
+define(<KEYS>,	<%rsi>)
+define(<IV>,	<%rdx>)
+define(<LENGTH>,<%rcx>)
+define(<DST>,	<%r8>)
+define(<SRC>,	<%r9>)
+
+C Offset of the last subkey
+define(<LAST>,	<%rdi>)
+C Offset of the current subkey, reusing the KEYS register
+define(<OFF>,	<%rsi>)
+C Offset of the current block
+define(<POS>,	<%rax>)
+define(<TMP>,	<%r10>)
+C Subkeys for each stream
+define(<K0>,	<%r11>)
+define(<K1>,	<%rbx>)
+define(<K2>,	<%rbp>)
+define(<K3>,	<%r12>)
+
+define(<X0>,	<%xmm0>)
+define(<X1>,	<%xmm1>)
+define(<X2>,	<%xmm2>)
+define(<X3>,	<%xmm3>)
+define(<Y0>,	<%xmm4>)
+define(<Y1>,	<%xmm5>)
+define(<Y2>,	<%xmm6>)
+define(<Y3>,	<%xmm7>)
+define(<T>,	<%xmm8>)
+
+C LOAD_XOR(i, xmm)
+define(<LOAD_XOR>, <
+	mov	eval(8*$1)(SRC), TMP
+	movups	(TMP, POS), T
+	pxor	T, $2
+>)
+
+C STORE(i, xmm)
+define(<STORE>, <
+	mov	eval(8*$1)(DST), TMP
+	movups	$2, (TMP, POS)
+>)
+
+C ROUND4(op)
+define(<ROUND4>, <
+	movups	(K0, OFF), Y0
+	movups	(K1, OFF), Y1
+	movups	(K2, OFF), Y2
+	movups	(K3, OFF), Y3
+	$1	Y0, X0
+	$1	Y1, X1
+	$1	Y2, X2
+	$1	Y3, X3
+>)
+
+	.file "aes-cbc-encrypt-4.asm"
+
+	C _aes_cbc_encrypt_4(unsigned rounds, const uint32_t **keys,
+	C		     uint8_t **iv, size_t length,
+	C		     uint8_t **dst, const uint8_t **src)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_aes_cbc_encrypt_4)
+	W64_ENTRY(6, 9)
+	test	LENGTH, LENGTH
+	jz	.Lend
+
+	push	%rbx
+	push	%rbp
+	push	%r12
+
+	shl	$4, XREG(ROUNDS)
+	mov	(KEYS), K0
+	mov	8(KEYS), K1
+	mov	16(KEYS), K2
+	mov	24(KEYS), K3
+
+	mov	(IV), TMP
+	movups	(TMP), X0
+	mov	8(IV), TMP
+	movups	(TMP), X1
+	mov	16(IV), TMP
+	movups	(TMP), X2
+	mov	24(IV), TMP
+	movups	(TMP), X3
+
+	xor	POS, POS
+
+	ALIGN(16)
+.Lblock_loop:
+	LOAD_XOR(0, X0)
+	LOAD_XOR(1, X1)
+	LOAD_XOR(2, X2)
+	LOAD_XOR(3, X3)
+
+	xor	OFF, OFF
+	ROUND4(pxor)
+	mov	$16, OFF
+
+.Lround_loop:
+	ROUND4(aesenc)
+	add	$16, OFF
+	cmp	OFF, LAST
+	jne	.Lround_loop
+
+	ROUND4(aesenclast)
+
+	STORE(0, X0)
+	STORE(1, X1)
+	STORE(2, X2)
+	STORE(3, X3)
+
+	add	$16, POS
+	cmp	POS, LENGTH
+	jne	.Lblock_loop
+
+	mov	(IV), TMP
+	movups	X0, (TMP)
+	mov	8(IV), TMP
+	movups	X1, (TMP)
+	mov	16(IV), TMP
+	movups	X2, (TMP)
+	mov	24(IV), TMP
+	movups	X3, (TMP)
+
+	pop	%r12
+	pop	%rbp
+	pop	%rbx
+
+.Lend:
+	W64_EXIT(6, 9)
+	ret
+EPILOGUE(_nettle_aes_cbc_encrypt_4)
@@ -0,0 +1,183 @@
+C x86_64/aesni/aes-ctr-crypt.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+C Counter mode using the aesenc instructions. Eight counter blocks
+C are encrypted in parallel, and the keystream is xored with the
+C source directly from registers. The 128-bit big-endian counter is
+C kept byte swapped in a pair of general purpose registers.
+
+C Input argument
+define(<ROUNDS>, <%rdi>)
+define(<KEYS>,	<%rsi>)
+define(<CTR>,	<%rdx>)
+define(<LENGTH>,<%rcx>)
+define(<DST>,	<%r8>)
+define(<SRC>,	<%r9>)
+
+define(<HI>,	<%r10>)
+define(<LO>,	<%r11>)
+C Used for both counter block setup and as the subkey pointer
+define(<KEY>,	<%rax>)
+C Pointer to the last subkey
+define(<LAST>,	<%rdi>)
+
+define(<K>,	<%xmm8>)
+define(<D>,	<%xmm9>)
+
+C COUNTER(xmm)
+C Writes the current counter value to xmm, and increments it.
+define(<COUNTER>, <
+	mov	HI, KEY
+	bswap	KEY
+	movq	KEY, $1
+	mov	LO, KEY
+	bswap	KEY
+	pinsrq	<$>1, KEY, $1
+	add	<$>1, LO
+	adc	<$>0, HI
+>)
+
+C OP8(op, src)
+C Applies the instruction op, with the given source operand, to all
+C eight blocks.
+define(<OP8>, <
+	$1	$2, %xmm0
+	$1	$2, %xmm1
+	$1	$2, %xmm2
+	$1	$2, %xmm3
+	$1	$2, %xmm4
+	$1	$2, %xmm5
+	$1	$2, %xmm6
+	$1	$2, %xmm7
+>)
+
+C XOR_STORE(xmm, offset)
+define(<XOR_STORE>, <
+	movups	$2(SRC), D
+	pxor	D, $1
+	movups	$1, $2(DST)
+>)
+
+	.file "aes-ctr-crypt.asm"
+
+	C _aes_ctr_crypt(unsigned rounds, const uint32_t *keys,
+	C		 uint8_t *ctr, size_t length,
+	C		 uint8_t *dst, const uint8_t *src)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_aes_ctr_crypt)
+	W64_ENTRY(6, 10)
+	shl	$4, XREG(ROUNDS)
+	add	KEYS, LAST
+
+	mov	(CTR), HI
+	mov	8(CTR), LO
+	bswap	HI
+	bswap	LO
+
+	sub	$128, LENGTH
+	jc	.Lblock8_done
+
+	ALIGN(16)
+.Lblock8_loop:
+	COUNTER(%xmm0)
+	COUNTER(%xmm1)
+	COUNTER(%xmm2)
+	COUNTER(%xmm3)
+	COUNTER(%xmm4)
+	COUNTER(%xmm5)
+	COUNTER(%xmm6)
+	COUNTER(%xmm7)
+
+	movups	(KEYS), K
+	OP8(pxor, K)
+	lea	16(KEYS), KEY
+
+.Lround8_loop:
+	movups	(KEY), K
+	OP8(aesenc, K)
+	add	$16, KEY
+	cmp	KEY, LAST
+	jne	.Lround8_loop
+
+	movups	(KEY), K
+	OP8(aesenclast, K)
+
+	XOR_STORE(%xmm0, 0)
+	XOR_STORE(%xmm1, 16)
+	XOR_STORE(%xmm2, 32)
+	XOR_STORE(%xmm3, 48)
+	XOR_STORE(%xmm4, 64)
+	XOR_STORE(%xmm5, 80)
+	XOR_STORE(%xmm6, 96)
+	XOR_STORE(%xmm7, 112)
+
+	add	$128, SRC
+	add	$128, DST
+	sub	$128, LENGTH
+	jnc	.Lblock8_loop
+
+.Lblock8_done:
+	add	$128, LENGTH
+	jz	.Lend
+
+.Lblock_loop:
+	COUNTER(%xmm0)
+	movups	(KEYS), K
+	pxor	K, %xmm0
+	lea	16(KEYS), KEY
+
+.Lround_loop:
+	movups	(KEY), K
+	aesenc	K, %xmm0
+	add	$16, KEY
+	cmp	KEY, LAST
+	jne	.Lround_loop
+
+	movups	(KEY), K
+	aesenclast	K, %xmm0
+	XOR_STORE(%xmm0, 0)
+
+	add	$16, SRC
+	add	$16, DST
+	sub	$16, LENGTH
+	jnz	.Lblock_loop
+
+.Lend:
+	bswap	HI
+	bswap	LO
+	mov	HI, (CTR)
+	mov	LO, 8(CTR)
+
+	W64_EXIT(6, 10)
+	ret
+EPILOGUE(_nettle_aes_ctr_crypt)
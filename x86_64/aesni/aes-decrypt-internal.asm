@@ -31,6 +31,9 @@ ifelse(<
    not, see http://www.gnu.org/licenses/.
 >)
 
+C Eight blocks are processed in parallel, to hide the latency of the
+C aesdec instruction. Remaining blocks are done one at a time.
+
 C Input argument
 define(<ROUNDS>, <%rdi>)
 define(<KEYS>,	<%rsi>)
@@ -39,15 +42,26 @@ define(<LENGTH>,<%rcx>)
 define(<DST>,	<%r8>)
 define(<SRC>,	<%r9>)
 
-C Round counter
-define(<CNT>, <%rdx>)
 C Subkey pointer
 define(<KEY>, <%rax>)
-
-dnl aesdec %xmm1, %xmm0
-define(<AESDEC>, <.byte 0x66, 0x0f, 0x38, 0xde, 0xc1>)
-dnl aesdeclast %xmm1, %xmm0
-define(<AESDECLAST>, <.byte 0x66, 0x0f, 0x38, 0xdf, 0xc1>)
+C Pointer to the last subkey
+define(<LAST>,	<%rdi>)
+
+define(<K>,	<%xmm8>)
+
+C OP8(op, src)
+C Applies the instruction op, with the given source operand, to all
+C eight blocks.
+define(<OP8>, <
+	$1	$2, %xmm0
+	$1	$2, %xmm1
+	$1	$2, %xmm2
+	$1	$2, %xmm3
+	$1	$2, %xmm4
+	$1	$2, %xmm5
+	$1	$2, %xmm6
+	$1	$2, %xmm7
+>)
 
 	.file "aes-decrypt-internal.asm"
 
@@ -58,35 +72,73 @@ define(<AESDECLAST>, <.byte 0x66, 0x0f, 0x38, 0xdf, 0xc1>)
 	.text
 	ALIGN(16)
 PROLOGUE(_nettle_aes_decrypt)
-	W64_ENTRY(6, 2)
+	W64_ENTRY(6, 9)
+	shl	$4, XREG(ROUNDS)
+	add	KEYS, LAST
+
+	sub	$128, LENGTH
+	jc	.Lblock8_done
+
+	ALIGN(16)
+.Lblock8_loop:
+	movups	(SRC), %xmm0
+	movups	16(SRC), %xmm1
+	movups	32(SRC), %xmm2
+	movups	48(SRC), %xmm3
+	movups	64(SRC), %xmm4
+	movups	80(SRC), %xmm5
+	movups	96(SRC), %xmm6
+	movups	112(SRC), %xmm7
+
+	movups	(KEYS), K
+	OP8(pxor, K)
+	lea	16(KEYS), KEY
+
+.Lround8_loop:
+	movups	(KEY), K
+	OP8(aesdec, K)
+	add	$16, KEY
+	cmp	KEY, LAST
+	jne	.Lround8_loop
+
+	movups	(KEY), K
+	OP8(aesdeclast, K)
+
+	movups	%xmm0, (DST)
+	movups	%xmm1, 16(DST)
+	movups	%xmm2, 32(DST)
+	movups	%xmm3, 48(DST)
+	movups	%xmm4, 64(DST)
+	movups	%xmm5, 80(DST)
+	movups	%xmm6, 96(DST)
+	movups	%xmm7, 112(DST)
+
+	add	$128, SRC
+	add	$128, DST
+	sub	$128, LENGTH
+	jnc	.Lblock8_loop
+
+.Lblock8_done:
+	add	$128, LENGTH
+	C The length is a multiple of the block size
 	shr	$4, LENGTH
-	test	LENGTH, LENGTH
 	jz	.Lend
 
-	decl	XREG(ROUNDS)
-
 .Lblock_loop:
-	mov	ROUNDS, CNT
-	mov	KEYS, KEY
 	movups	(SRC), %xmm0
-	C FIXME: Better alignment of subkeys, so we can use movaps.
-	movups	(KEY), %xmm1
-	pxor	%xmm1, %xmm0
-
-	C FIXME: Could use some unrolling. Also all subkeys fit in
-	C registers, so they could be loaded once (on W64 we would
-	C need to save and restore some xmm registers, though).
+	movups	(KEYS), K
+	pxor	K, %xmm0
+	lea	16(KEYS), KEY
 
 .Lround_loop:
+	movups	(KEY), K
+	aesdec	K, %xmm0
 	add	$16, KEY
+	cmp	KEY, LAST
+	jne	.Lround_loop
 
-	movups	(KEY), %xmm1
-	AESDEC	C %xmm1, %xmm0
-	decl	XREG(CNT)
-	jnz	.Lround_loop
-
-	movups	16(KEY), %xmm1
-	AESDECLAST	C %xmm1, %xmm0
+	movups	(KEY), K
+	aesdeclast	K, %xmm0
 
 	movups	%xmm0, (DST)
 	add	$16, SRC
@@ -95,6 +147,6 @@ PROLOGUE(_nettle_aes_decrypt)
 	jnz	.Lblock_loop
 
 .Lend:
-	W64_EXIT(6, 2)
+	W64_EXIT(6, 9)
 	ret
 EPILOGUE(_nettle_aes_decrypt)
@@ -31,6 +31,11 @@ ifelse(<
    not, see http://www.gnu.org/licenses/.
 >)
 
+C Eight blocks are processed in parallel, to hide the latency of the
+C aesenc instruction. Remaining blocks are done two at a time, and a
+C final odd block by itself. Two blocks per call is the common case
+C for modes which pair a MAC block with a key stream block, like EAX.
+
 C Input argument
 define(<ROUNDS>, <%rdi>)
 define(<KEYS>,	<%rsi>)
@@ -39,16 +44,27 @@ define(<LENGTH>,<%rcx>)
 define(<DST>,	<%r8>)
 define(<SRC>,	<%r9>)
 
-C Round counter
-define(<CNT>, <%rdx>)
 C Subkey pointer
 define(<KEY>, <%rax>)
+C Pointer to the last subkey
+define(<LAST>,	<%rdi>)
+
+define(<K>,	<%xmm8>)
+
+C OP8(op, src)
+C Applies the instruction op, with the given source operand, to all
+C eight blocks.
+define(<OP8>, <
+	$1	$2, %xmm0
+	$1	$2, %xmm1
+	$1	$2, %xmm2
+	$1	$2, %xmm3
+	$1	$2, %xmm4
+	$1	$2, %xmm5
+	$1	$2, %xmm6
+	$1	$2, %xmm7
+>)
 
-dnl aesenc %xmm1, %xmm0
-define(<AESENC>, <.byte 0x66, 0x0f, 0x38, 0xdc, 0xc1>)
-dnl aesenclast %xmm1, %xmm0
-define(<AESENCLAST>, <.byte 0x66, 0x0f, 0x38, 0xdd, 0xc1>)
-	
 	.file "aes-encrypt-internal.asm"
 
 	C _aes_encrypt(unsigned rounds, const uint32_t *keys,
@@ -58,35 +74,106 @@ define(<AESENCLAST>, <.byte 0x66, 0x0f, 0x38, 0xdd, 0xc1>)
 	.text
 	ALIGN(16)
 PROLOGUE(_nettle_aes_encrypt)
-	W64_ENTRY(6, 2)
+	W64_ENTRY(6, 9)
+	shl	$4, XREG(ROUNDS)
+	add	KEYS, LAST
+
+	sub	$128, LENGTH
+	jc	.Lblock8_done
+
+	ALIGN(16)
+.Lblock8_loop:
+	movups	(SRC), %xmm0
+	movups	16(SRC), %xmm1
+	movups	32(SRC), %xmm2
+	movups	48(SRC), %xmm3
+	movups	64(SRC), %xmm4
+	movups	80(SRC), %xmm5
+	movups	96(SRC), %xmm6
+	movups	112(SRC), %xmm7
+
+	movups	(KEYS), K
+	OP8(pxor, K)
+	lea	16(KEYS), KEY
+
+.Lround8_loop:
+	movups	(KEY), K
+	OP8(aesenc, K)
+	add	$16, KEY
+	cmp	KEY, LAST
+	jne	.Lround8_loop
+
+	movups	(KEY), K
+	OP8(aesenclast, K)
+
+	movups	%xmm0, (DST)
+	movups	%xmm1, 16(DST)
+	movups	%xmm2, 32(DST)
+	movups	%xmm3, 48(DST)
+	movups	%xmm4, 64(DST)
+	movups	%xmm5, 80(DST)
+	movups	%xmm6, 96(DST)
+	movups	%xmm7, 112(DST)
+
+	add	$128, SRC
+	add	$128, DST
+	sub	$128, LENGTH
+	jnc	.Lblock8_loop
+
+.Lblock8_done:
+	add	$128, LENGTH
+	sub	$32, LENGTH
+	jc	.Lblock2_done
+
+	ALIGN(16)
+.Lblock2_loop:
+	movups	(SRC), %xmm0
+	movups	16(SRC), %xmm1
+	movups	(KEYS), K
+	pxor	K, %xmm0
+	pxor	K, %xmm1
+	lea	16(KEYS), KEY
+
+.Lround2_loop:
+	movups	(KEY), K
+	aesenc	K, %xmm0
+	aesenc	K, %xmm1
+	add	$16, KEY
+	cmp	KEY, LAST
+	jne	.Lround2_loop
+
+	movups	(KEY), K
+	aesenclast	K, %xmm0
+	aesenclast	K, %xmm1
+
+	movups	%xmm0, (DST)
+	movups	%xmm1, 16(DST)
+	add	$32, SRC
+	add	$32, DST
+	sub	$32, LENGTH
+	jnc	.Lblock2_loop
+
+.Lblock2_done:
+	add	$32, LENGTH
+	C The length is a multiple of the block size
 	shr	$4, LENGTH
-	test	LENGTH, LENGTH
 	jz	.Lend
 
-	decl	XREG(ROUNDS)
-
 .Lblock_loop:
-	mov	ROUNDS, CNT
-	mov	KEYS, KEY
 	movups	(SRC), %xmm0
-	C FIXME: Better alignment of subkeys, so we can use movaps.
-	movups	(KEY), %xmm1
-	pxor	%xmm1, %xmm0
-
-	C FIXME: Could use some unrolling. Also all subkeys fit in
-	C registers, so they could be loaded once (on W64 we would
-	C need to save and restore some xmm registers, though).
+	movups	(KEYS), K
+	pxor	K, %xmm0
+	lea	16(KEYS), KEY
 
 .Lround_loop:
+	movups	(KEY), K
+	aesenc	K, %xmm0
 	add	$16, KEY
+	cmp	KEY, LAST
+	jne	.Lround_loop
 
-	movups	(KEY), %xmm1
-	AESENC	C %xmm1, %xmm0
-	decl	XREG(CNT)
-	jnz	.Lround_loop
-
-	movups	16(KEY), %xmm1
-	AESENCLAST	C %xmm1, %xmm0
+	movups	(KEY), K
+	aesenclast	K, %xmm0
 
 	movups	%xmm0, (DST)
 	add	$16, SRC
@@ -95,6 +182,6 @@ PROLOGUE(_nettle_aes_encrypt)
 	jnz	.Lblock_loop
 
 .Lend:
-	W64_EXIT(6, 2)
+	W64_EXIT(6, 9)
 	ret
 EPILOGUE(_nettle_aes_encrypt)
@@ -0,0 +1,237 @@
+C x86_64/aesni/ccm-aes-crypt.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+
+C Combined CCM and AES, using the aesenc instructions. The CBC-MAC is
+C inherently serial, so each CBC-MAC block is encrypted together with
+C one counter block, interleaving the rounds, to keep two blocks in
+C flight. For decryption, the keystream is computed one block ahead,
+C since the CBC-MAC input is the decrypted data. The 128-bit
+C big-endian counter is kept byte swapped in a pair of general
+C purpose registers, as in aes-ctr-crypt.asm.
+
+C Input argument
+define(<CTX>,	<%rdi>)
+define(<ROUNDS>, <%rsi>)
+define(<KEYS>,	<%rdx>)
+define(<LENGTH>,<%rcx>)
+define(<DST>,	<%r8>)
+define(<SRC>,	<%r9>)
+
+C Pointer to the last subkey
+define(<LAST>,	<%rsi>)
+define(<HI>,	<%r10>)
+define(<LO>,	<%r11>)
+C Offset of the current block, also the return value
+define(<POS>,	<%rax>)
+C Used for both counter block setup and as the subkey pointer
+define(<KEY>,	<%rbx>)
+
+define(<TAG>,	<%xmm0>)
+define(<S>,	<%xmm1>)
+define(<K>,	<%xmm2>)
+define(<X>,	<%xmm3>)
+
+C Offsets in struct ccm_ctx
+define(<CCM_CTR>, <0>)
+define(<CCM_TAG>, <16>)
+
+C COUNTER(xmm)
+C Writes the current counter value to xmm, and increments it.
+define(<COUNTER>, <
+	mov	HI, KEY
+	bswap	KEY
+	movq	KEY, $1
+	mov	LO, KEY
+	bswap	KEY
+	pinsrq	<$>1, KEY, $1
+	add	<$>1, LO
+	adc	<$>0, HI
+>)
+
+C SETUP(label)
+C Loads the tag and the counter. Leaves LENGTH rounded down to a
+C multiple of the block size, and jumps to label if it is zero.
+define(<SETUP>, <
+	xor	POS, POS
+	and	<$>-16, LENGTH
+	jz	$1
+	push	%rbx
+	shl	<$>4, XREG(ROUNDS)
+	add	KEYS, LAST
+
+	movups	eval(CCM_TAG)(CTX), TAG
+	mov	eval(CCM_CTR)(CTX), HI
+	mov	eval(CCM_CTR + 8)(CTX), LO
+	bswap	HI
+	bswap	LO
+>)
+
+C FINISH
+C Stores the tag and the counter.
+define(<FINISH>, <
+	movups	TAG, eval(CCM_TAG)(CTX)
+	bswap	HI
+	bswap	LO
+	mov	HI, eval(CCM_CTR)(CTX)
+	mov	LO, eval(CCM_CTR + 8)(CTX)
+	pop	%rbx
+>)
+
+	.file "ccm-aes-crypt.asm"
+
+	C size_t
+	C _ccm_aes_encrypt(struct ccm_ctx *ctx, unsigned rounds,
+	C		   const uint32_t *keys, size_t length,
+	C		   uint8_t *dst, const uint8_t *src)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_ccm_aes_encrypt)
+	W64_ENTRY(6, 4)
+	SETUP(.Lenc_end)
+
+	ALIGN(16)
+.Lenc_block_loop:
+	movups	(SRC, POS), X
+	pxor	X, TAG
+	COUNTER(S)
+
+	movups	(KEYS), K
+	pxor	K, TAG
+	pxor	K, S
+	lea	16(KEYS), KEY
+
+.Lenc_round_loop:
+	movups	(KEY), K
+	aesenc	K, TAG
+	aesenc	K, S
+	add	$16, KEY
+	cmp	KEY, LAST
+	jne	.Lenc_round_loop
+
+	movups	(KEY), K
+	aesenclast	K, TAG
+	aesenclast	K, S
+
+	pxor	S, X
+	movups	X, (DST, POS)
+	add	$16, POS
+	cmp	POS, LENGTH
+	jne	.Lenc_block_loop
+
+	FINISH
+.Lenc_end:
+	W64_EXIT(6, 4)
+	ret
+EPILOGUE(_nettle_ccm_aes_encrypt)
+
+	C size_t
+	C _ccm_aes_decrypt(struct ccm_ctx *ctx, unsigned rounds,
+	C		   const uint32_t *keys, size_t length,
+	C		   uint8_t *dst, const uint8_t *src)
+	ALIGN(16)
+PROLOGUE(_nettle_ccm_aes_decrypt)
+	W64_ENTRY(6, 4)
+	SETUP(.Ldec_end)
+
+	C The first keystream block
+	COUNTER(S)
+	movups	(KEYS), K
+	pxor	K, S
+	lea	16(KEYS), KEY
+.Ldec_first_loop:
+	movups	(KEY), K
+	aesenc	K, S
+	add	$16, KEY
+	cmp	KEY, LAST
+	jne	.Ldec_first_loop
+	movups	(KEY), K
+	aesenclast	K, S
+
+	C Process all but the last block, with the CBC-MAC of one block
+	C interleaved with the keystream for the next.
+	sub	$16, LENGTH
+	jz	.Ldec_last
+
+	ALIGN(16)
+.Ldec_block_loop:
+	movups	(SRC, POS), X
+	pxor	S, X
+	movups	X, (DST, POS)
+	pxor	X, TAG
+	COUNTER(S)
+
+	movups	(KEYS), K
+	pxor	K, TAG
+	pxor	K, S
+	lea	16(KEYS), KEY
+
+.Ldec_round_loop:
+	movups	(KEY), K
+	aesenc	K, TAG
+	aesenc	K, S
+	add	$16, KEY
+	cmp	KEY, LAST
+	jne	.Ldec_round_loop
+
+	movups	(KEY), K
+	aesenclast	K, TAG
+	aesenclast	K, S
+
+	add	$16, POS
+	cmp	POS, LENGTH
+	jne	.Ldec_block_loop
+
+.Ldec_last:
+	movups	(SRC, POS), X
+	pxor	S, X
+	movups	X, (DST, POS)
+	pxor	X, TAG
+
+	movups	(KEYS), K
+	pxor	K, TAG
+	lea	16(KEYS), KEY
+.Ldec_last_loop:
+	movups	(KEY), K
+	aesenc	K, TAG
+	add	$16, KEY
+	cmp	KEY, LAST
+	jne	.Ldec_last_loop
+	movups	(KEY), K
+	aesenclast	K, TAG
+	add	$16, POS
+
+	FINISH
+.Ldec_end:
+	W64_EXIT(6, 4)
+	ret
+EPILOGUE(_nettle_ccm_aes_decrypt)
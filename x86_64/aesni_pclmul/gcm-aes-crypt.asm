@@ -0,0 +1,390 @@
+C x86_64/aesni_pclmul/gcm-aes-crypt.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+C Stitched AES-GCM, interleaving the AES-NI rounds for eight counter
+C blocks with the pclmulqdq GHASH of eight ciphertext blocks. For
+C encryption, the blocks hashed are those produced by the previous
+C iteration, for decryption, the ones being decrypted.
+C
+C The hashing depends on the key table layout produced by
+C x86_64/pclmul/gcm-hash.asm, see that file for the details of the
+C arithmetic.
+C
+C The first argument points at a struct gcm_aes128_ctx (or 192, 256),
+C which start with a struct gcm_key, followed by the struct gcm_ctx and
+C the AES subkeys, at the GCM_* offsets defined in asm.m4. Only
+C complete groups of eight blocks are processed, and the number of
+C bytes processed is returned.
+
+C Register usage:
+
+define(<KEY>, <%rdi>)
+define(<ROUNDS>, <%rsi>)
+define(<LENGTH>, <%rdx>)
+define(<DST>, <%rcx>)
+define(<SRC>, <%r8>)
+define(<CTR>, <%r9d>)
+define(<CNT>, <%r10>)
+define(<SUBKEYS>, <%r11>)
+define(<LAST>, <%rsi>)	C Overwrites ROUNDS
+
+define(<A0>, <%xmm0>)
+define(<A1>, <%xmm1>)
+define(<A2>, <%xmm2>)
+define(<A3>, <%xmm3>)
+define(<A4>, <%xmm4>)
+define(<A5>, <%xmm5>)
+define(<A6>, <%xmm6>)
+define(<A7>, <%xmm7>)
+define(<K>, <%xmm8>)
+define(<LO>, <%xmm9>)
+define(<HI>, <%xmm10>)
+define(<MID>, <%xmm11>)
+define(<D>, <%xmm12>)
+define(<T0>, <%xmm13>)
+define(<H>, <%xmm14>)
+define(<T1>, <%xmm14>)	C Shares register with H
+define(<BSWAP>, <%xmm15>)
+
+C Stack slots, for the hash state (byte reversed) and the counter
+C block.
+define(<X_SLOT>, <(%rsp)>)
+define(<CTR_SLOT>, <16(%rsp)>)
+
+C COUNTER(reg)
+define(<COUNTER>, <
+	mov	CTR, %eax
+	bswap	%eax
+	movups	CTR_SLOT, $1
+	pinsrd	<$>3, %eax, $1
+	add	<$>1, CTR
+>)
+
+C AES_ROUND(offset), applied to all eight blocks
+define(<AES_ROUND>, <
+	movups	$1(SUBKEYS), K
+	aesenc	K, A0
+	aesenc	K, A1
+	aesenc	K, A2
+	aesenc	K, A3
+	aesenc	K, A4
+	aesenc	K, A5
+	aesenc	K, A6
+	aesenc	K, A7
+>)
+
+C MUL_ADD(k)
+C Multiplies D by H^k, without reduction, and adds the Karatsuba
+C partial products to LO, HI and MID. Clobbers D, T0 and H.
+define(<MUL_ADD>, <
+	movups	eval(16*($1 - 1))(KEY), H
+	movdqa	D, T0
+	pclmulqdq	<$>0x11, H, T0
+	pxor	T0, HI
+	pshufd	<$>0x4e, D, T0
+	pxor	D, T0
+	pclmulqdq	<$>0x00, H, D
+	pxor	D, LO
+	movups	eval(128 + 16*($1 - 1))(KEY), H
+	pclmulqdq	<$>0x00, H, T0
+	pxor	T0, MID
+>)
+
+C GHASH_BLOCK(base, offset, i)
+C Hashes block i of a group of eight starting at offset(base).
+define(<GHASH_BLOCK>, <
+	movups	eval($2 + 16*$3)($1), D
+	pshufb	BSWAP, D
+	ifelse($3, 0, <
+	movups	X_SLOT, T0
+	pxor	T0, D
+	>)
+	MUL_ADD(eval(8 - $3))
+>)
+
+C Reduces the product in LO, HI and MID, and stores the new hash
+C state in X_SLOT. Clobbers all of LO, HI, MID, T0 and T1.
+define(<REDUCE>, <
+	pxor	LO, MID
+	pxor	HI, MID
+	movdqa	MID, T0
+	pslldq	<$>8, T0
+	psrldq	<$>8, MID
+	pxor	T0, LO
+	pxor	MID, HI
+
+	movdqa	LO, T0
+	psllq	<$>1, T0
+	pxor	LO, T0
+	psllq	<$>5, T0
+	pxor	LO, T0
+	psllq	<$>57, T0
+	movdqa	T0, T1
+	pslldq	<$>8, T1
+	psrldq	<$>8, T0
+	pxor	T1, LO
+	pxor	T0, HI
+
+	movdqa	LO, T1
+	psrlq	<$>5, T1
+	pxor	LO, T1
+	psrlq	<$>1, T1
+	pxor	LO, T1
+	psrlq	<$>1, T1
+	pxor	T1, HI
+	pxor	HI, LO
+	movups	LO, X_SLOT
+>)
+
+C GHASH_GROUP(base, offset)
+C Hashes eight blocks, without any interleaved AES.
+define(<GHASH_GROUP>, <
+	pxor	LO, LO
+	pxor	HI, HI
+	pxor	MID, MID
+	GHASH_BLOCK($1, $2, 0)
+	GHASH_BLOCK($1, $2, 1)
+	GHASH_BLOCK($1, $2, 2)
+	GHASH_BLOCK($1, $2, 3)
+	GHASH_BLOCK($1, $2, 4)
+	GHASH_BLOCK($1, $2, 5)
+	GHASH_BLOCK($1, $2, 6)
+	GHASH_BLOCK($1, $2, 7)
+	REDUCE
+>)
+
+C XOR_STORE(reg, offset)
+define(<XOR_STORE>, <
+	movups	$2(SRC), K
+	pxor	K, $1
+	movups	$1, $2(DST)
+>)
+
+C AES_GROUP(base, offset, label)
+C Encrypts eight counter blocks, and xors them with the source. If
+C base is non-empty, hashes eight blocks starting at offset(base) in
+C parallel.
+define(<AES_GROUP>, <
+	COUNTER(A0)
+	COUNTER(A1)
+	COUNTER(A2)
+	COUNTER(A3)
+	COUNTER(A4)
+	COUNTER(A5)
+	COUNTER(A6)
+	COUNTER(A7)
+
+	movups	(SUBKEYS), K
+	pxor	K, A0
+	pxor	K, A1
+	pxor	K, A2
+	pxor	K, A3
+	pxor	K, A4
+	pxor	K, A5
+	pxor	K, A6
+	pxor	K, A7
+
+	ifelse(<$1>,,<
+	AES_ROUND(16)
+	AES_ROUND(32)
+	AES_ROUND(48)
+	AES_ROUND(64)
+	AES_ROUND(80)
+	AES_ROUND(96)
+	AES_ROUND(112)
+	AES_ROUND(128)
+	AES_ROUND(144)
+	>, <
+	pxor	LO, LO
+	pxor	HI, HI
+	pxor	MID, MID
+	AES_ROUND(16)
+	GHASH_BLOCK($1, $2, 0)
+	AES_ROUND(32)
+	GHASH_BLOCK($1, $2, 1)
+	AES_ROUND(48)
+	GHASH_BLOCK($1, $2, 2)
+	AES_ROUND(64)
+	GHASH_BLOCK($1, $2, 3)
+	AES_ROUND(80)
+	GHASH_BLOCK($1, $2, 4)
+	AES_ROUND(96)
+	GHASH_BLOCK($1, $2, 5)
+	AES_ROUND(112)
+	GHASH_BLOCK($1, $2, 6)
+	AES_ROUND(128)
+	GHASH_BLOCK($1, $2, 7)
+	AES_ROUND(144)
+	REDUCE
+	>)
+
+	C Remaining rounds, for 192 and 256 bit keys.
+	lea	160(SUBKEYS), %rax
+	cmp	%rax, LAST
+	je	.Llast_round$3
+.Lround_loop$3:
+	movups	(%rax), K
+	aesenc	K, A0
+	aesenc	K, A1
+	aesenc	K, A2
+	aesenc	K, A3
+	aesenc	K, A4
+	aesenc	K, A5
+	aesenc	K, A6
+	aesenc	K, A7
+	add	<$>16, %rax
+	cmp	%rax, LAST
+	jne	.Lround_loop$3
+.Llast_round$3:
+	movups	(LAST), K
+	aesenclast	K, A0
+	aesenclast	K, A1
+	aesenclast	K, A2
+	aesenclast	K, A3
+	aesenclast	K, A4
+	aesenclast	K, A5
+	aesenclast	K, A6
+	aesenclast	K, A7
+
+	XOR_STORE(A0, 0)
+	XOR_STORE(A1, 16)
+	XOR_STORE(A2, 32)
+	XOR_STORE(A3, 48)
+	XOR_STORE(A4, 64)
+	XOR_STORE(A5, 80)
+	XOR_STORE(A6, 96)
+	XOR_STORE(A7, 112)
+>)
+
+C Loads the hash state and the counter, and sets up SUBKEYS and
+C LAST.
+define(<GCM_SETUP>, <
+	sub	<$>32, %rsp
+	movdqa	.Lbswap(%rip), BSWAP
+	movups	eval(GCM_X)(KEY), T0
+	pshufb	BSWAP, T0
+	movups	T0, X_SLOT
+	movups	eval(GCM_CTR)(KEY), T0
+	movups	T0, CTR_SLOT
+	mov	eval(GCM_CTR + 12)(KEY), CTR
+	bswap	CTR
+	lea	eval(GCM_CIPHER)(KEY), SUBKEYS
+	mov	XREG(ROUNDS), XREG(ROUNDS)
+	shl	<$>4, ROUNDS
+	lea	(SUBKEYS, ROUNDS), LAST
+>)
+
+C Stores the hash state and the counter.
+define(<GCM_FINISH>, <
+	movups	X_SLOT, T0
+	pshufb	BSWAP, T0
+	movups	T0, eval(GCM_X)(KEY)
+	bswap	CTR
+	mov	CTR, eval(GCM_CTR + 12)(KEY)
+	add	<$>32, %rsp
+>)
+
+	.file "gcm-aes-crypt.asm"
+
+	C size_t gcm_aes_encrypt (struct gcm_key *key, unsigned rounds,
+	C                         size_t length, uint8_t *dst,
+	C                         const uint8_t *src)
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_gcm_aes_encrypt)
+	W64_ENTRY(5, 16)
+	mov	LENGTH, CNT
+	shr	$7, CNT
+	jz	.Lenc_done
+
+	GCM_SETUP
+	AES_GROUP(,, _enc_first)
+	add	$128, SRC
+	add	$128, DST
+	dec	CNT
+	jz	.Lenc_final
+
+	ALIGN(16)
+.Lenc_loop:
+	C Hash the previous group of ciphertext blocks
+	AES_GROUP(DST, -128, _enc)
+	add	$128, SRC
+	add	$128, DST
+	dec	CNT
+	jnz	.Lenc_loop
+
+.Lenc_final:
+	GHASH_GROUP(DST, -128)
+	GCM_FINISH
+
+.Lenc_done:
+	mov	LENGTH, %rax
+	and	$-128, %rax
+	W64_EXIT(5, 16)
+	ret
+EPILOGUE(_nettle_gcm_aes_encrypt)
+
+	C size_t gcm_aes_decrypt (struct gcm_key *key, unsigned rounds,
+	C                         size_t length, uint8_t *dst,
+	C                         const uint8_t *src)
+
+	ALIGN(16)
+PROLOGUE(_nettle_gcm_aes_decrypt)
+	W64_ENTRY(5, 16)
+	mov	LENGTH, CNT
+	shr	$7, CNT
+	jz	.Ldec_done
+
+	GCM_SETUP
+
+	ALIGN(16)
+.Ldec_loop:
+	AES_GROUP(SRC, 0, _dec)
+	add	$128, SRC
+	add	$128, DST
+	dec	CNT
+	jnz	.Ldec_loop
+
+	GCM_FINISH
+
+.Ldec_done:
+	mov	LENGTH, %rax
+	and	$-128, %rax
+	W64_EXIT(5, 16)
+	ret
+EPILOGUE(_nettle_gcm_aes_decrypt)
+
+	RODATA
+	ALIGN(16)
+.Lbswap:
+	.byte	15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0
@@ -0,0 +1,273 @@
+C x86_64/avx2/chacha-8core.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+C Generates eight consecutive ChaCha blocks in parallel, using the
+C same transposed layout as x86_64/chacha-4core.asm, but with ymm
+C registers. Words 0-3 are kept on the stack, and the remaining two
+C registers hold shuffle masks for the rotations by 16 and 8 bits.
+
+define(<DST>, <%rdi>)
+define(<SRC>, <%rsi>)
+define(<ROUNDS>, <%rdx>)
+
+C State words 4-15
+define(<X4>, <%ymm0>)
+define(<X5>, <%ymm1>)
+define(<X6>, <%ymm2>)
+define(<X7>, <%ymm3>)
+define(<X8>, <%ymm4>)
+define(<X9>, <%ymm5>)
+define(<X10>, <%ymm6>)
+define(<X11>, <%ymm7>)
+define(<X12>, <%ymm8>)
+define(<X13>, <%ymm9>)
+define(<X14>, <%ymm10>)
+define(<X15>, <%ymm11>)
+define(<T0>, <%ymm12>)
+define(<T1>, <%ymm13>)
+define(<ROT16>, <%ymm14>)
+define(<ROT8>, <%ymm15>)
+
+C Used by the final transposition
+define(<U0>, <%ymm8>)
+define(<U1>, <%ymm9>)
+define(<U2>, <%ymm10>)
+define(<U3>, <%ymm11>)
+define(<U4>, <%ymm12>)
+define(<U5>, <%ymm13>)
+define(<U6>, <%ymm14>)
+define(<U7>, <%ymm15>)
+
+C Stack frame: words 0-3, the initial words 12 and 13, and words
+C 8-15 of the output while words 0-7 are transposed.
+define(<FRAME_X12>, <128>)
+define(<FRAME_X13>, <160>)
+define(<FRAME_HIGH>, <192>)
+define(<FRAME_SIZE>, <448>)
+
+C QROUND(a, b, c, d)
+C The a word is a stack offset, the others are registers.
+define(<QROUND>, <
+	vmovdqu	$1(%rsp), T0
+	vpaddd	$2, T0, T0
+	vpxor	T0, $4, $4
+	vpshufb	ROT16, $4, $4
+
+	vpaddd	$4, $3, $3
+	vpxor	$3, $2, $2
+	vpslld	<$>12, $2, T1
+	vpsrld	<$>20, $2, $2
+	vpor	T1, $2, $2
+
+	vpaddd	$2, T0, T0
+	vpxor	T0, $4, $4
+	vmovdqu	T0, $1(%rsp)
+	vpshufb	ROT8, $4, $4
+
+	vpaddd	$4, $3, $3
+	vpxor	$3, $2, $2
+	vpslld	<$>7, $2, T1
+	vpsrld	<$>25, $2, $2
+	vpor	T1, $2, $2
+>)
+
+C ADD_INPUT(i, x)
+C Adds input word i to x, using T0.
+define(<ADD_INPUT>, <
+	vpbroadcastd	eval(4*$1)(SRC), T0
+	vpaddd	T0, $2, $2
+>)
+
+C TRANSPOSE(r0, r1, r2, r3, r4, r5, r6, r7, offset)
+C Transposes eight rows, and stores them at the given offset in each
+C of the eight output blocks. Clobbers the rows and U0-U7.
+define(<TRANSPOSE>, <
+	vpunpckldq	$2, $1, U0
+	vpunpckhdq	$2, $1, U1
+	vpunpckldq	$4, $3, U2
+	vpunpckhdq	$4, $3, U3
+	vpunpckldq	$6, $5, U4
+	vpunpckhdq	$6, $5, U5
+	vpunpckldq	$8, $7, U6
+	vpunpckhdq	$8, $7, U7
+
+	vpunpcklqdq	U2, U0, $1
+	vpunpckhqdq	U2, U0, $2
+	vpunpcklqdq	U3, U1, $3
+	vpunpckhqdq	U3, U1, $4
+	vpunpcklqdq	U6, U4, $5
+	vpunpckhqdq	U6, U4, $6
+	vpunpcklqdq	U7, U5, $7
+	vpunpckhqdq	U7, U5, $8
+
+	vperm2i128	<$>0x20, $5, $1, U0
+	vperm2i128	<$>0x31, $5, $1, U1
+	vperm2i128	<$>0x20, $6, $2, U2
+	vperm2i128	<$>0x31, $6, $2, U3
+	vperm2i128	<$>0x20, $7, $3, U4
+	vperm2i128	<$>0x31, $7, $3, U5
+	vperm2i128	<$>0x20, $8, $4, U6
+	vperm2i128	<$>0x31, $8, $4, U7
+
+	vmovdqu	U0, $9(DST)
+	vmovdqu	U2, eval($9 + 64)(DST)
+	vmovdqu	U4, eval($9 + 128)(DST)
+	vmovdqu	U6, eval($9 + 192)(DST)
+	vmovdqu	U1, eval($9 + 256)(DST)
+	vmovdqu	U3, eval($9 + 320)(DST)
+	vmovdqu	U5, eval($9 + 384)(DST)
+	vmovdqu	U7, eval($9 + 448)(DST)
+>)
+
+	.file "chacha-8core.asm"
+
+	C _chacha_8core(uint32_t *dst, const uint32_t *src, unsigned rounds)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_chacha_8core)
+	W64_ENTRY(3, 16)
+	sub	$FRAME_SIZE, %rsp
+
+	vpbroadcastd	0(SRC), T0
+	vpbroadcastd	4(SRC), T1
+	vmovdqu	T0, 0(%rsp)
+	vmovdqu	T1, 32(%rsp)
+	vpbroadcastd	8(SRC), T0
+	vpbroadcastd	12(SRC), T1
+	vmovdqu	T0, 64(%rsp)
+	vmovdqu	T1, 96(%rsp)
+
+	vpbroadcastd	16(SRC), X4
+	vpbroadcastd	20(SRC), X5
+	vpbroadcastd	24(SRC), X6
+	vpbroadcastd	28(SRC), X7
+	vpbroadcastd	32(SRC), X8
+	vpbroadcastd	36(SRC), X9
+	vpbroadcastd	40(SRC), X10
+	vpbroadcastd	44(SRC), X11
+	vpbroadcastd	56(SRC), X14
+	vpbroadcastd	60(SRC), X15
+
+	C Block counters, with carry from word 12 to word 13. The
+	C unsigned comparison is done by flipping the sign bits.
+	vpbroadcastd	48(SRC), T0
+	vpbroadcastd	52(SRC), X13
+	vpaddd	.Lcount(%rip), T0, X12
+	vpbroadcastd	.Lsign(%rip), ROT16
+	vpxor	ROT16, T0, T0
+	vpxor	ROT16, X12, T1
+	vpcmpgtd	T1, T0, T0
+	vpsubd	T0, X13, X13
+	vmovdqu	X12, eval(FRAME_X12)(%rsp)
+	vmovdqu	X13, eval(FRAME_X13)(%rsp)
+
+	vbroadcasti128	.Lrot16(%rip), ROT16
+	vbroadcasti128	.Lrot8(%rip), ROT8
+
+	shrl	$1, XREG(ROUNDS)
+
+	ALIGN(16)
+.Loop:
+	QROUND(0, X4, X8, X12)
+	QROUND(32, X5, X9, X13)
+	QROUND(64, X6, X10, X14)
+	QROUND(96, X7, X11, X15)
+
+	QROUND(0, X5, X10, X15)
+	QROUND(32, X6, X11, X12)
+	QROUND(64, X7, X8, X13)
+	QROUND(96, X4, X9, X14)
+
+	decl	XREG(ROUNDS)
+	jnz	.Loop
+
+	ADD_INPUT(4, X4)
+	ADD_INPUT(5, X5)
+	ADD_INPUT(6, X6)
+	ADD_INPUT(7, X7)
+	ADD_INPUT(8, X8)
+	ADD_INPUT(9, X9)
+	ADD_INPUT(10, X10)
+	ADD_INPUT(11, X11)
+	vpaddd	eval(FRAME_X12)(%rsp), X12, X12
+	vpaddd	eval(FRAME_X13)(%rsp), X13, X13
+	ADD_INPUT(14, X14)
+	ADD_INPUT(15, X15)
+
+	vmovdqu	X8, eval(FRAME_HIGH)(%rsp)
+	vmovdqu	X9, eval(FRAME_HIGH + 32)(%rsp)
+	vmovdqu	X10, eval(FRAME_HIGH + 64)(%rsp)
+	vmovdqu	X11, eval(FRAME_HIGH + 96)(%rsp)
+	vmovdqu	X12, eval(FRAME_HIGH + 128)(%rsp)
+	vmovdqu	X13, eval(FRAME_HIGH + 160)(%rsp)
+	vmovdqu	X14, eval(FRAME_HIGH + 192)(%rsp)
+	vmovdqu	X15, eval(FRAME_HIGH + 224)(%rsp)
+
+	C Words 0-7, with words 0-3 loaded into X8-X11.
+	vmovdqu	0(%rsp), X8
+	vmovdqu	32(%rsp), X9
+	vmovdqu	64(%rsp), X10
+	vmovdqu	96(%rsp), X11
+	ADD_INPUT(0, X8)
+	ADD_INPUT(1, X9)
+	ADD_INPUT(2, X10)
+	ADD_INPUT(3, X11)
+	TRANSPOSE(X8, X9, X10, X11, X4, X5, X6, X7, 0)
+
+	C Words 8-15
+	vmovdqu	eval(FRAME_HIGH)(%rsp), X4
+	vmovdqu	eval(FRAME_HIGH + 32)(%rsp), X5
+	vmovdqu	eval(FRAME_HIGH + 64)(%rsp), X6
+	vmovdqu	eval(FRAME_HIGH + 96)(%rsp), X7
+	vmovdqu	eval(FRAME_HIGH + 128)(%rsp), X8
+	vmovdqu	eval(FRAME_HIGH + 160)(%rsp), X9
+	vmovdqu	eval(FRAME_HIGH + 192)(%rsp), X10
+	vmovdqu	eval(FRAME_HIGH + 224)(%rsp), X11
+	TRANSPOSE(X4, X5, X6, X7, X8, X9, X10, X11, 32)
+
+	vzeroupper
+	add	$FRAME_SIZE, %rsp
+	W64_EXIT(3, 16)
+	ret
+EPILOGUE(_nettle_chacha_8core)
+
+	RODATA
+	ALIGN(32)
+.Lcount:
+	.long	0, 1, 2, 3, 4, 5, 6, 7
+.Lsign:
+	.long	0x80000000
+	ALIGN(16)
+.Lrot16:
+	.byte	2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13
+.Lrot8:
+	.byte	3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14
@@ -0,0 +1,457 @@
+C x86_64/avx2/poly1305-blocks.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+	.file "poly1305-blocks.asm"
+
+C Processes four blocks at a time, with one block per 64-bit lane
+C and the state split into five 26-bit limbs. Each lane is multiplied
+C by r^4 between groups, and by r^4, r^3, r^2 or r after the last
+C group, before the lanes are added together. The powers are cached
+C in the context, in radix 2^26, and are computed the first time they
+C are needed after poly1305_set_key. Leftover blocks, and short
+C inputs, use the same 64-bit code as _nettle_poly1305_block.
+
+define(<CTX>, <%rdi>)
+define(<BLOCKS>, <%rsi>)
+define(<MP>, <%rbx>)
+define(<T0>, <%rcx>)
+define(<T1>, <%r8>)
+define(<T2>, <%r9>)
+define(<H0>, <%r10>)
+define(<H1>, <%r11>)
+define(<H2>, <%rbp>)
+
+C Accumulators, one limb per register
+define(<A0>, <%ymm0>)
+define(<A1>, <%ymm1>)
+define(<A2>, <%ymm2>)
+define(<A3>, <%ymm3>)
+define(<A4>, <%ymm4>)
+define(<P0>, <%ymm5>)
+define(<P1>, <%ymm6>)
+define(<P2>, <%ymm7>)
+define(<P3>, <%ymm8>)
+define(<P4>, <%ymm9>)
+define(<TMP>, <%ymm10>)
+define(<TMP2>, <%ymm11>)
+define(<MASK>, <%ymm12>)
+define(<HIBIT>, <%ymm13>)
+
+define(<XA0>, <%xmm0>)
+define(<XA1>, <%xmm1>)
+define(<XA2>, <%xmm2>)
+define(<XA3>, <%xmm3>)
+define(<XA4>, <%xmm4>)
+define(<XTMP>, <%xmm10>)
+
+C The powers in the context are stored as nine rows of four 32-bit
+C words, r_0, ..., r_4, 5 r_1, ..., 5 r_4, with the row for limb i
+C holding r^4, r^2, r^3 and r in that order. This is the lane order
+C produced when loading blocks with vpunpcklqdq.
+
+C Stack frame: the same nine values, broadcast or zero-extended to
+C 64-bit lanes.
+define(<FRAME_R0>, <0>)
+define(<FRAME_R1>, <32>)
+define(<FRAME_R2>, <64>)
+define(<FRAME_R3>, <96>)
+define(<FRAME_R4>, <128>)
+define(<FRAME_S1>, <160>)
+define(<FRAME_S2>, <192>)
+define(<FRAME_S3>, <224>)
+define(<FRAME_S4>, <256>)
+define(<FRAME_SIZE>, <288>)
+
+C MUL_R
+C Multiplies (T0, T1, T2) by r, as in _nettle_poly1305_block, and
+C leaves the partially reduced result in (H0, H1, T2). Clobbers
+C %rax, %rdx and H2.
+define(<MUL_R>, <
+	mov	P1305_R0 (CTX), %rax
+	mul	T0			C x0*r0
+	mov	%rax, H0
+	mov	%rdx, H1
+	mov	P1305_S1 (CTX), %rax	C 5/4 r1
+	mov	%rax, H2
+	mul	T1			C x1*r1'
+	imul	T2, H2			C x2*r1'
+	imul	P1305_R0 (CTX), T2	C x2*r0
+	add	%rax, H0
+	adc	%rdx, H1
+	mov	P1305_R0 (CTX), %rax
+	mul	T1			C x1*r0
+	add	%rax, H2
+	adc	%rdx, T2
+	mov	P1305_R1 (CTX), %rax
+	mul	T0			C x0*r1
+	add	%rax, H2
+	adc	%rdx, T2
+	mov	T2, %rax
+	shr	<$>2, %rax
+	imul	<$>5, %rax
+	and	<$>3, XREG(T2)
+	add	%rax, H0
+	adc	H2, H1
+	adc	<$>0, XREG(T2)
+>)
+
+C STORE_LIMB(i, column)
+C Stores %eax as limb i of a power, and for i > 0 also 5 times %eax.
+define(<STORE_LIMB>, <
+	mov	%eax, eval(P1305_POWERS + 16*$1 + 4*$2) (CTX)
+	ifelse($1, 0, , <
+	lea	(%rax, %rax, 4), %edx
+	mov	%edx, eval(P1305_POWERS + 16*$1 + 64 + 4*$2) (CTX)>)
+>)
+
+C STORE_POWER(column)
+C Splits (T0, T1, T2) into 26-bit limbs, and stores them in the
+C given column of the powers table.
+define(<STORE_POWER>, <
+	mov	XREG(T0), %eax
+	and	<$>0x3ffffff, %eax
+	STORE_LIMB(0, $1)
+	mov	T0, %rax
+	shr	<$>26, %rax
+	and	<$>0x3ffffff, %eax
+	STORE_LIMB(1, $1)
+	mov	T0, %rax
+	shrd	<$>52, T1, %rax
+	and	<$>0x3ffffff, %eax
+	STORE_LIMB(2, $1)
+	mov	T1, %rax
+	shr	<$>14, %rax
+	and	<$>0x3ffffff, %eax
+	STORE_LIMB(3, $1)
+	mov	T1, %rax
+	shrd	<$>40, T2, %rax
+	STORE_LIMB(4, $1)
+>)
+
+C MUL_TERM(x, y, p)
+C Adds x * y to p, using TMP.
+define(<MUL_TERM>, <
+	vpmuludq	eval($2)(%rsp), $1, TMP
+	vpaddq	TMP, $3, $3
+>)
+
+C MUL_VEC
+C Multiplies A0-A4 by the values in the stack frame, and reduces
+C the products back into A0-A4. Limbs are at most a few bits larger
+C than 26 bits, so products fit comfortably in 64 bits.
+define(<MUL_VEC>, <
+	vpmuludq	eval(FRAME_R0)(%rsp), A0, P0
+	vpmuludq	eval(FRAME_R1)(%rsp), A0, P1
+	vpmuludq	eval(FRAME_R2)(%rsp), A0, P2
+	vpmuludq	eval(FRAME_R3)(%rsp), A0, P3
+	vpmuludq	eval(FRAME_R4)(%rsp), A0, P4
+
+	MUL_TERM(A1, FRAME_S4, P0)
+	MUL_TERM(A1, FRAME_R0, P1)
+	MUL_TERM(A1, FRAME_R1, P2)
+	MUL_TERM(A1, FRAME_R2, P3)
+	MUL_TERM(A1, FRAME_R3, P4)
+
+	MUL_TERM(A2, FRAME_S3, P0)
+	MUL_TERM(A2, FRAME_S4, P1)
+	MUL_TERM(A2, FRAME_R0, P2)
+	MUL_TERM(A2, FRAME_R1, P3)
+	MUL_TERM(A2, FRAME_R2, P4)
+
+	MUL_TERM(A3, FRAME_S2, P0)
+	MUL_TERM(A3, FRAME_S3, P1)
+	MUL_TERM(A3, FRAME_S4, P2)
+	MUL_TERM(A3, FRAME_R0, P3)
+	MUL_TERM(A3, FRAME_R1, P4)
+
+	MUL_TERM(A4, FRAME_S1, P0)
+	MUL_TERM(A4, FRAME_S2, P1)
+	MUL_TERM(A4, FRAME_S3, P2)
+	MUL_TERM(A4, FRAME_S4, P3)
+	MUL_TERM(A4, FRAME_R0, P4)
+
+	C Carry propagation, in two interleaved chains
+	vpsrlq	<$>26, P3, TMP
+	vpand	MASK, P3, P3
+	vpaddq	TMP, P4, P4
+	vpsrlq	<$>26, P0, TMP
+	vpand	MASK, P0, A0
+	vpaddq	TMP, P1, P1
+	vpsrlq	<$>26, P4, TMP
+	vpand	MASK, P4, A4
+	vpsllq	<$>2, TMP, TMP2
+	vpaddq	TMP2, TMP, TMP
+	vpaddq	TMP, A0, A0
+	vpsrlq	<$>26, P1, TMP
+	vpand	MASK, P1, A1
+	vpaddq	TMP, P2, P2
+	vpsrlq	<$>26, P2, TMP
+	vpand	MASK, P2, A2
+	vpaddq	TMP, P3, P3
+	vpsrlq	<$>26, A0, TMP
+	vpand	MASK, A0, A0
+	vpaddq	TMP, A1, A1
+	vpsrlq	<$>26, P3, TMP
+	vpand	MASK, P3, A3
+	vpaddq	TMP, A4, A4
+>)
+
+C HSUM(a, xa, r)
+C Adds the four lanes of a, leaving the sum in r.
+define(<HSUM>, <
+	vextracti128	<$>1, $1, XTMP
+	vpaddq	XTMP, $2, $2
+	vpsrldq	<$>8, $2, XTMP
+	vpaddq	XTMP, $2, $2
+	vmovq	$2, $3
+>)
+
+	.text
+	C _poly1305_blocks (struct poly1305_ctx *ctx, size_t blocks, const uint8_t *m)
+	ALIGN(16)
+PROLOGUE(_nettle_poly1305_blocks)
+	W64_ENTRY(3, 14)
+	push	%rbx
+	push	%rbp
+	mov	%rdx, MP
+
+	cmp	$8, BLOCKS
+	jc	.Lshort
+
+	cmpl	$0, P1305_HAVE_POWERS (CTX)
+	jne	.Lpowers_done
+
+	mov	P1305_R0 (CTX), T0
+	mov	P1305_R1 (CTX), T1
+	xor	XREG(T2), XREG(T2)
+	STORE_POWER(3)
+	MUL_R
+	mov	H0, T0
+	mov	H1, T1
+	STORE_POWER(1)
+	MUL_R
+	mov	H0, T0
+	mov	H1, T1
+	STORE_POWER(2)
+	MUL_R
+	mov	H0, T0
+	mov	H1, T1
+	STORE_POWER(0)
+	movl	$1, P1305_HAVE_POWERS (CTX)
+
+.Lpowers_done:
+	sub	$FRAME_SIZE, %rsp
+
+	C Split the state into limbs, in the first lane.
+	mov	P1305_H0 (CTX), H0
+	mov	P1305_H1 (CTX), H1
+	mov	P1305_H2 (CTX), XREG(T2)
+	mov	XREG(H0), %eax
+	and	$0x3ffffff, %eax
+	vmovd	%eax, XA0
+	mov	H0, %rax
+	shr	$26, %rax
+	and	$0x3ffffff, %eax
+	vmovd	%eax, XA1
+	mov	H0, %rax
+	shrd	$52, H1, %rax
+	and	$0x3ffffff, %eax
+	vmovd	%eax, XA2
+	mov	H1, %rax
+	shr	$14, %rax
+	and	$0x3ffffff, %eax
+	vmovd	%eax, XA3
+	mov	H1, %rax
+	shrd	$40, T2, %rax
+	vmovd	%eax, XA4
+
+	vpcmpeqd	MASK, MASK, MASK
+	vpsrlq	$63, MASK, HIBIT
+	vpsllq	$24, HIBIT, HIBIT
+	vpsrlq	$38, MASK, MASK
+
+	C Multiply by r^4 between groups
+	vpbroadcastd	P1305_POWERS (CTX), TMP
+	vmovdqu	TMP, FRAME_R0 (%rsp)
+	vpbroadcastd	eval(P1305_POWERS + 16) (CTX), TMP
+	vmovdqu	TMP, FRAME_R1 (%rsp)
+	vpbroadcastd	eval(P1305_POWERS + 32) (CTX), TMP
+	vmovdqu	TMP, FRAME_R2 (%rsp)
+	vpbroadcastd	eval(P1305_POWERS + 48) (CTX), TMP
+	vmovdqu	TMP, FRAME_R3 (%rsp)
+	vpbroadcastd	eval(P1305_POWERS + 64) (CTX), TMP
+	vmovdqu	TMP, FRAME_R4 (%rsp)
+	vpbroadcastd	eval(P1305_POWERS + 80) (CTX), TMP
+	vmovdqu	TMP, FRAME_S1 (%rsp)
+	vpbroadcastd	eval(P1305_POWERS + 96) (CTX), TMP
+	vmovdqu	TMP, FRAME_S2 (%rsp)
+	vpbroadcastd	eval(P1305_POWERS + 112) (CTX), TMP
+	vmovdqu	TMP, FRAME_S3 (%rsp)
+	vpbroadcastd	eval(P1305_POWERS + 128) (CTX), TMP
+	vmovdqu	TMP, FRAME_S4 (%rsp)
+
+	mov	BLOCKS, T0
+	shr	$2, T0
+	jmp	.Lload
+
+.Loop:
+	MUL_VEC
+.Lload:
+	C Lanes get blocks 0, 2, 1, 3.
+	vmovdqu	(MP), TMP
+	vmovdqu	32(MP), TMP2
+	vpunpcklqdq	TMP2, TMP, P0
+	vpunpckhqdq	TMP2, TMP, P1
+
+	vpand	MASK, P0, TMP
+	vpaddq	TMP, A0, A0
+	vpsrlq	$26, P0, TMP
+	vpand	MASK, TMP, TMP
+	vpaddq	TMP, A1, A1
+	vpsrlq	$52, P0, TMP
+	vpsllq	$12, P1, TMP2
+	vpor	TMP2, TMP, TMP
+	vpand	MASK, TMP, TMP
+	vpaddq	TMP, A2, A2
+	vpsrlq	$14, P1, TMP
+	vpand	MASK, TMP, TMP
+	vpaddq	TMP, A3, A3
+	vpsrlq	$40, P1, TMP
+	vpor	HIBIT, TMP, TMP
+	vpaddq	TMP, A4, A4
+
+	add	$64, MP
+	dec	T0
+	jnz	.Loop
+
+	C Multiply each lane by its own power.
+	vpmovzxdq	P1305_POWERS (CTX), TMP
+	vmovdqu	TMP, FRAME_R0 (%rsp)
+	vpmovzxdq	eval(P1305_POWERS + 16) (CTX), TMP
+	vmovdqu	TMP, FRAME_R1 (%rsp)
+	vpmovzxdq	eval(P1305_POWERS + 32) (CTX), TMP
+	vmovdqu	TMP, FRAME_R2 (%rsp)
+	vpmovzxdq	eval(P1305_POWERS + 48) (CTX), TMP
+	vmovdqu	TMP, FRAME_R3 (%rsp)
+	vpmovzxdq	eval(P1305_POWERS + 64) (CTX), TMP
+	vmovdqu	TMP, FRAME_R4 (%rsp)
+	vpmovzxdq	eval(P1305_POWERS + 80) (CTX), TMP
+	vmovdqu	TMP, FRAME_S1 (%rsp)
+	vpmovzxdq	eval(P1305_POWERS + 96) (CTX), TMP
+	vmovdqu	TMP, FRAME_S2 (%rsp)
+	vpmovzxdq	eval(P1305_POWERS + 112) (CTX), TMP
+	vmovdqu	TMP, FRAME_S3 (%rsp)
+	vpmovzxdq	eval(P1305_POWERS + 128) (CTX), TMP
+	vmovdqu	TMP, FRAME_S4 (%rsp)
+	MUL_VEC
+
+	HSUM(A0, XA0, H0)
+	HSUM(A1, XA1, T0)
+	HSUM(A2, XA2, T1)
+	HSUM(A3, XA3, H2)
+	HSUM(A4, XA4, H1)
+	vzeroupper
+	add	$FRAME_SIZE, %rsp
+
+	C Carry propagation, limbs in H0, T0, T1, H2, H1.
+	mov	H0, %rax
+	shr	$26, %rax
+	and	$0x3ffffff, XREG(H0)
+	add	%rax, T0
+	mov	T0, %rax
+	shr	$26, %rax
+	and	$0x3ffffff, XREG(T0)
+	add	%rax, T1
+	mov	T1, %rax
+	shr	$26, %rax
+	and	$0x3ffffff, XREG(T1)
+	add	%rax, H2
+	mov	H2, %rax
+	shr	$26, %rax
+	and	$0x3ffffff, XREG(H2)
+	add	%rax, H1
+	mov	H1, %rax
+	shr	$26, %rax
+	and	$0x3ffffff, XREG(H1)
+	lea	(%rax, %rax, 4), %rax
+	add	%rax, H0
+	mov	H0, %rax
+	shr	$26, %rax
+	and	$0x3ffffff, XREG(H0)
+	add	%rax, T0
+
+	C Convert to 64-bit words, in (H0, H1, T2)
+	shl	$26, T0
+	add	T0, H0
+	mov	T1, T0
+	shr	$12, T0
+	shl	$52, T1
+	shl	$14, H2
+	add	H2, T0
+	mov	H1, T2
+	shr	$24, T2
+	shl	$40, H1
+	add	T1, H0
+	adc	T0, H1
+	adc	$0, XREG(T2)
+
+	and	$3, BLOCKS
+	jnz	.Loop_block
+	jmp	.Lend
+
+.Lshort:
+	mov	P1305_H0 (CTX), H0
+	mov	P1305_H1 (CTX), H1
+	mov	P1305_H2 (CTX), XREG(T2)
+	test	BLOCKS, BLOCKS
+	jz	.Lend
+
+.Loop_block:
+	mov	(MP), T0
+	mov	8(MP), T1
+	add	H0, T0
+	adc	H1, T1
+	adc	$1, XREG(T2)
+	MUL_R
+	add	$16, MP
+	dec	BLOCKS
+	jnz	.Loop_block
+
+.Lend:
+	mov	H0, P1305_H0 (CTX)
+	mov	H1, P1305_H1 (CTX)
+	mov	XREG(T2), P1305_H2 (CTX)
+	pop	%rbp
+	pop	%rbx
+	W64_EXIT(3, 14)
+	ret
+EPILOGUE(_nettle_poly1305_blocks)
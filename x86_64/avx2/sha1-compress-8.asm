@@ -0,0 +1,226 @@
+C x86_64/avx2/sha1-compress-8.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+C Compresses blocks for eight independent SHA1 messages in parallel,
+C with the same transposed layout as x86_64/avx2/sha256-compress-8.asm.
+C Word j of lane i is at state[8*j + i].
+
+define(<STATE>, <%rdi>)
+define(<INPUT>, <%rsi>)
+define(<BLOCKS>, <%rdx>)
+define(<OFFSET>, <%r8>)
+define(<PTR>, <%rax>)
+
+define(<SA>, <%ymm0>)
+define(<SB>, <%ymm1>)
+define(<SC>, <%ymm2>)
+define(<SD>, <%ymm3>)
+define(<SE>, <%ymm4>)
+define(<T0>, <%ymm5>)
+define(<T1>, <%ymm6>)
+define(<T2>, <%ymm7>)
+define(<KV>, <%ymm13>)
+
+C Used for loading the message
+define(<X0>, <%ymm5>)
+define(<X1>, <%ymm6>)
+define(<X2>, <%ymm7>)
+define(<X3>, <%ymm8>)
+define(<U0>, <%ymm9>)
+define(<U1>, <%ymm10>)
+define(<U2>, <%ymm11>)
+define(<U3>, <%ymm12>)
+
+C Stack frame: message words W[i mod 16].
+define(<W>, <eval(32*(($1) % 16))(%rsp)>)
+define(<FRAME_SIZE>, <512>)
+
+C LOAD_LANE(lane, group, xmm, ymm)
+define(<LOAD_LANE>, <
+	mov	eval(8*$1)(INPUT), PTR
+	vmovdqu	eval(16*$2)(PTR, OFFSET), $3
+	mov	eval(8*$1 + 32)(INPUT), PTR
+	vinserti128	<$>1, eval(16*$2)(PTR, OFFSET), $4, $4
+>)
+
+C LOAD(group)
+C Loads message words 4*group, ..., 4*group + 3, and stores them,
+C transposed and byte swapped, at W(4*group), ...
+define(<LOAD>, <
+	LOAD_LANE(0, $1, %xmm5, X0)
+	LOAD_LANE(1, $1, %xmm6, X1)
+	LOAD_LANE(2, $1, %xmm7, X2)
+	LOAD_LANE(3, $1, %xmm8, X3)
+	vpunpckldq	X1, X0, U0
+	vpunpckhdq	X1, X0, U1
+	vpunpckldq	X3, X2, U2
+	vpunpckhdq	X3, X2, U3
+	vpunpcklqdq	U2, U0, X0
+	vpunpckhqdq	U2, U0, X1
+	vpunpcklqdq	U3, U1, X2
+	vpunpckhqdq	U3, U1, X3
+	vpshufb	.Lbswap(%rip), X0, X0
+	vpshufb	.Lbswap(%rip), X1, X1
+	vpshufb	.Lbswap(%rip), X2, X2
+	vpshufb	.Lbswap(%rip), X3, X3
+	vmovdqu	X0, W(4*$1)
+	vmovdqu	X1, W(4*$1 + 1)
+	vmovdqu	X2, W(4*$1 + 2)
+	vmovdqu	X3, W(4*$1 + 3)
+>)
+
+C EXPAND(i)
+C Computes W[i] = (W[i-3] ^ W[i-8] ^ W[i-14] ^ W[i-16]) <<< 1,
+C leaving it in T0.
+define(<EXPAND>, <
+	vmovdqu	W($1 + 13), T0
+	vpxor	W($1 + 8), T0, T0
+	vpxor	W($1 + 2), T0, T0
+	vpxor	W($1), T0, T0
+	vpslld	<$>1, T0, T1
+	vpsrld	<$>31, T0, T0
+	vpor	T1, T0, T0
+	vmovdqu	T0, W($1)
+>)
+
+C ROUND(a, b, c, d, e, i)
+C Adds the round function to e, and rotates b.
+define(<ROUND>, <
+	ifelse(eval(($6) % 20), 0, <
+	vpbroadcastd	.Lk+eval(4*(($6) / 20))(%rip), KV
+	>)
+	ifelse(eval(($6) / 16), 0, <vmovdqu	W($6), T0>, <EXPAND($6)>)
+	vpaddd	KV, T0, T0
+	vpaddd	T0, $5, $5
+	vpslld	<$>5, $1, T0
+	vpsrld	<$>27, $1, T1
+	vpor	T1, T0, T0
+	vpaddd	T0, $5, $5
+	ifelse(eval(($6) / 20), 0, <
+	vpxor	$3, $4, T0
+	vpand	$2, T0, T0
+	vpxor	$4, T0, T0
+	>, eval(($6) / 20), 2, <
+	vpor	$2, $3, T0
+	vpand	$4, T0, T0
+	vpand	$2, $3, T1
+	vpor	T1, T0, T0
+	>, <
+	vpxor	$2, $3, T0
+	vpxor	$4, T0, T0
+	>)
+	vpaddd	T0, $5, $5
+	vpslld	<$>30, $2, T0
+	vpsrld	<$>2, $2, $2
+	vpor	T0, $2, $2
+>)
+
+C ROUND5(i)
+C Five rounds, after which the state is back in the original registers.
+define(<ROUND5>, <
+	ROUND(SA, SB, SC, SD, SE, $1)
+	ROUND(SE, SA, SB, SC, SD, eval($1 + 1))
+	ROUND(SD, SE, SA, SB, SC, eval($1 + 2))
+	ROUND(SC, SD, SE, SA, SB, eval($1 + 3))
+	ROUND(SB, SC, SD, SE, SA, eval($1 + 4))
+>)
+
+	C _nettle_sha1_compress_8(uint32_t *state, const uint8_t **input,
+	C			  size_t blocks)
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_sha1_compress_8)
+	W64_ENTRY(3, 14)
+	test	BLOCKS, BLOCKS
+	jz	.Lend
+	sub	$FRAME_SIZE, %rsp
+
+	vmovdqu	(STATE), SA
+	vmovdqu	32(STATE), SB
+	vmovdqu	64(STATE), SC
+	vmovdqu	96(STATE), SD
+	vmovdqu	128(STATE), SE
+	xor	OFFSET, OFFSET
+
+.Loop:
+	LOAD(0)
+	LOAD(1)
+	LOAD(2)
+	LOAD(3)
+
+	ROUND5(0)
+	ROUND5(5)
+	ROUND5(10)
+	ROUND5(15)
+	ROUND5(20)
+	ROUND5(25)
+	ROUND5(30)
+	ROUND5(35)
+	ROUND5(40)
+	ROUND5(45)
+	ROUND5(50)
+	ROUND5(55)
+	ROUND5(60)
+	ROUND5(65)
+	ROUND5(70)
+	ROUND5(75)
+
+	vpaddd	(STATE), SA, SA
+	vpaddd	32(STATE), SB, SB
+	vpaddd	64(STATE), SC, SC
+	vpaddd	96(STATE), SD, SD
+	vpaddd	128(STATE), SE, SE
+	vmovdqu	SA, (STATE)
+	vmovdqu	SB, 32(STATE)
+	vmovdqu	SC, 64(STATE)
+	vmovdqu	SD, 96(STATE)
+	vmovdqu	SE, 128(STATE)
+
+	add	$64, OFFSET
+	dec	BLOCKS
+	jnz	.Loop
+
+	vzeroupper
+	add	$FRAME_SIZE, %rsp
+.Lend:
+	W64_EXIT(3, 14)
+	ret
+EPILOGUE(_nettle_sha1_compress_8)
+
+	RODATA
+	ALIGN(32)
+.Lbswap:
+	.byte	3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+	.byte	3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+.Lk:
+	.long	0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6
@@ -0,0 +1,258 @@
+C x86_64/avx2/sha256-compress-8.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+C Compresses blocks for eight independent SHA256 messages in
+C parallel. The state is transposed, with word j of lane i at
+C state[8*j + i], so that each ymm register holds one state word for
+C all lanes. Message words are loaded four at a time, with lanes i
+C and i+4 in the low and high halves of a register, which makes the
+C transposition a 4x4 transposition within each 128-bit half. The
+C sixteen most recent message words are kept on the stack.
+
+define(<STATE>, <%rdi>)
+define(<INPUT>, <%rsi>)
+define(<BLOCKS>, <%rdx>)
+define(<K>, <%rcx>)
+define(<OFFSET>, <%r8>)
+define(<KP>, <%r9>)
+define(<COUNT>, <%r10>)
+define(<PTR>, <%rax>)
+
+define(<SA>, <%ymm0>)
+define(<SB>, <%ymm1>)
+define(<SC>, <%ymm2>)
+define(<SD>, <%ymm3>)
+define(<SE>, <%ymm4>)
+define(<SF>, <%ymm5>)
+define(<SG>, <%ymm6>)
+define(<SH>, <%ymm7>)
+define(<T0>, <%ymm8>)
+define(<T1>, <%ymm9>)
+define(<T2>, <%ymm10>)
+define(<T3>, <%ymm11>)
+
+C Used for loading the message
+define(<X0>, <%ymm8>)
+define(<X1>, <%ymm9>)
+define(<X2>, <%ymm10>)
+define(<X3>, <%ymm11>)
+define(<U0>, <%ymm12>)
+define(<U1>, <%ymm13>)
+define(<U2>, <%ymm14>)
+define(<U3>, <%ymm15>)
+
+C Stack frame: message words W[i mod 16].
+define(<W>, <eval(32*(($1) % 16))(%rsp)>)
+define(<FRAME_SIZE>, <512>)
+
+C LOAD_LANE(lane, group, xmm, ymm)
+define(<LOAD_LANE>, <
+	mov	eval(8*$1)(INPUT), PTR
+	vmovdqu	eval(16*$2)(PTR, OFFSET), $3
+	mov	eval(8*$1 + 32)(INPUT), PTR
+	vinserti128	<$>1, eval(16*$2)(PTR, OFFSET), $4, $4
+>)
+
+C LOAD(group)
+C Loads message words 4*group, ..., 4*group + 3, and stores them,
+C transposed and byte swapped, at W(4*group), ...
+define(<LOAD>, <
+	LOAD_LANE(0, $1, %xmm8, X0)
+	LOAD_LANE(1, $1, %xmm9, X1)
+	LOAD_LANE(2, $1, %xmm10, X2)
+	LOAD_LANE(3, $1, %xmm11, X3)
+	vpunpckldq	X1, X0, U0
+	vpunpckhdq	X1, X0, U1
+	vpunpckldq	X3, X2, U2
+	vpunpckhdq	X3, X2, U3
+	vpunpcklqdq	U2, U0, X0
+	vpunpckhqdq	U2, U0, X1
+	vpunpcklqdq	U3, U1, X2
+	vpunpckhqdq	U3, U1, X3
+	vpshufb	.Lbswap(%rip), X0, X0
+	vpshufb	.Lbswap(%rip), X1, X1
+	vpshufb	.Lbswap(%rip), X2, X2
+	vpshufb	.Lbswap(%rip), X3, X3
+	vmovdqu	X0, W(4*$1)
+	vmovdqu	X1, W(4*$1 + 1)
+	vmovdqu	X2, W(4*$1 + 2)
+	vmovdqu	X3, W(4*$1 + 3)
+>)
+
+C SIGMA(x, dst, tmp, s, r1, r2)
+C dst = (x >> s) ^ (x >>> r1) ^ (x >>> r2), as in the message schedule.
+define(<SIGMA>, <
+	vpsrld	<$>$4, $1, $2
+	vpsrld	<$>$5, $1, $3
+	vpxor	$3, $2, $2
+	vpslld	<$>eval(32 - $5), $1, $3
+	vpxor	$3, $2, $2
+	vpsrld	<$>$6, $1, $3
+	vpxor	$3, $2, $2
+	vpslld	<$>eval(32 - $6), $1, $3
+	vpxor	$3, $2, $2
+>)
+
+C BIG_SIGMA(x, dst, tmp, r0, r1, r2)
+C dst = (x >>> r0) ^ (x >>> r1) ^ (x >>> r2), as in the rounds.
+define(<BIG_SIGMA>, <
+	SIGMA($1, $2, $3, $4, $5, $6)
+	vpslld	<$>eval(32 - $4), $1, $3
+	vpxor	$3, $2, $2
+>)
+
+C EXPAND(i)
+C Computes W[i] = s1(W[i-2]) + W[i-7] + s0(W[i-15]) + W[i-16],
+C leaving it in T0.
+define(<EXPAND>, <
+	vmovdqu	W($1 + 1), T0
+	SIGMA(T0, T1, T2, 3, 7, 18)
+	vmovdqu	W($1 + 14), T0
+	SIGMA(T0, T3, T2, 10, 17, 19)
+	vpaddd	T3, T1, T1
+	vpaddd	W($1 + 9), T1, T1
+	vpaddd	W($1), T1, T0
+	vmovdqu	T0, W($1)
+>)
+
+C ROUND(a, b, c, d, e, f, g, h, i, expand)
+C The message word is W(i), and the constant is at 4*i(KP).
+define(<ROUND>, <
+	ifelse($10, 1, <EXPAND($9)>, <vmovdqu	W($9), T0>)
+	vpbroadcastd	eval(4*$9)(KP), T1
+	vpaddd	T1, T0, T0
+	vpaddd	T0, $8, $8
+	BIG_SIGMA($5, T0, T1, 6, 11, 25)
+	vpaddd	T0, $8, $8
+	vpxor	$6, $7, T0
+	vpand	$5, T0, T0
+	vpxor	$7, T0, T0
+	vpaddd	T0, $8, $8
+	vpaddd	$8, $4, $4
+	BIG_SIGMA($1, T0, T1, 2, 13, 22)
+	vpaddd	T0, $8, $8
+	vpxor	$1, $2, T0
+	vpand	$3, T0, T0
+	vpand	$1, $2, T1
+	vpxor	T1, T0, T0
+	vpaddd	T0, $8, $8
+>)
+
+C ROUND16(expand)
+define(<ROUND16>, <
+	ROUND(SA, SB, SC, SD, SE, SF, SG, SH, 0, $1)
+	ROUND(SH, SA, SB, SC, SD, SE, SF, SG, 1, $1)
+	ROUND(SG, SH, SA, SB, SC, SD, SE, SF, 2, $1)
+	ROUND(SF, SG, SH, SA, SB, SC, SD, SE, 3, $1)
+	ROUND(SE, SF, SG, SH, SA, SB, SC, SD, 4, $1)
+	ROUND(SD, SE, SF, SG, SH, SA, SB, SC, 5, $1)
+	ROUND(SC, SD, SE, SF, SG, SH, SA, SB, 6, $1)
+	ROUND(SB, SC, SD, SE, SF, SG, SH, SA, 7, $1)
+	ROUND(SA, SB, SC, SD, SE, SF, SG, SH, 8, $1)
+	ROUND(SH, SA, SB, SC, SD, SE, SF, SG, 9, $1)
+	ROUND(SG, SH, SA, SB, SC, SD, SE, SF, 10, $1)
+	ROUND(SF, SG, SH, SA, SB, SC, SD, SE, 11, $1)
+	ROUND(SE, SF, SG, SH, SA, SB, SC, SD, 12, $1)
+	ROUND(SD, SE, SF, SG, SH, SA, SB, SC, 13, $1)
+	ROUND(SC, SD, SE, SF, SG, SH, SA, SB, 14, $1)
+	ROUND(SB, SC, SD, SE, SF, SG, SH, SA, 15, $1)
+>)
+
+	C _nettle_sha256_compress_8(uint32_t *state, const uint8_t **input,
+	C			    size_t blocks, const uint32_t *k)
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_sha256_compress_8)
+	W64_ENTRY(4, 16)
+	test	BLOCKS, BLOCKS
+	jz	.Lend
+	sub	$FRAME_SIZE, %rsp
+
+	vmovdqu	(STATE), SA
+	vmovdqu	32(STATE), SB
+	vmovdqu	64(STATE), SC
+	vmovdqu	96(STATE), SD
+	vmovdqu	128(STATE), SE
+	vmovdqu	160(STATE), SF
+	vmovdqu	192(STATE), SG
+	vmovdqu	224(STATE), SH
+	xor	OFFSET, OFFSET
+
+.Loop:
+	LOAD(0)
+	LOAD(1)
+	LOAD(2)
+	LOAD(3)
+
+	mov	K, KP
+	ROUND16(0)
+	mov	$3, COUNT
+.Lexpand:
+	add	$64, KP
+	ROUND16(1)
+	dec	COUNT
+	jnz	.Lexpand
+
+	vpaddd	(STATE), SA, SA
+	vpaddd	32(STATE), SB, SB
+	vpaddd	64(STATE), SC, SC
+	vpaddd	96(STATE), SD, SD
+	vpaddd	128(STATE), SE, SE
+	vpaddd	160(STATE), SF, SF
+	vpaddd	192(STATE), SG, SG
+	vpaddd	224(STATE), SH, SH
+	vmovdqu	SA, (STATE)
+	vmovdqu	SB, 32(STATE)
+	vmovdqu	SC, 64(STATE)
+	vmovdqu	SD, 96(STATE)
+	vmovdqu	SE, 128(STATE)
+	vmovdqu	SF, 160(STATE)
+	vmovdqu	SG, 192(STATE)
+	vmovdqu	SH, 224(STATE)
+
+	add	$64, OFFSET
+	dec	BLOCKS
+	jnz	.Loop
+
+	vzeroupper
+	add	$FRAME_SIZE, %rsp
+.Lend:
+	W64_EXIT(4, 16)
+	ret
+EPILOGUE(_nettle_sha256_compress_8)
+
+	RODATA
+	ALIGN(32)
+.Lbswap:
+	.byte	3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+	.byte	3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
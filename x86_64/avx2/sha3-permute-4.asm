@@ -0,0 +1,200 @@
+C x86_64/avx2/sha3-permute-4.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+C Applies the Keccak-f[1600] permutation to four independent states.
+C The states are interleaved, with word i of state j at state[4*i + j],
+C so that each ymm register holds the same word of all four states.
+C Each round reads the state from one buffer and writes the result to
+C another, alternating between the caller's state and the stack.
+
+define(<STATE>, <%rdi>)
+define(<RC>, <%rsi>)
+define(<COUNT>, <%rax>)
+
+define(<D0>, <%ymm0>)
+define(<D1>, <%ymm1>)
+define(<D2>, <%ymm2>)
+define(<D3>, <%ymm3>)
+define(<D4>, <%ymm4>)
+define(<B0>, <%ymm5>)
+define(<B1>, <%ymm6>)
+define(<B2>, <%ymm7>)
+define(<B3>, <%ymm8>)
+define(<B4>, <%ymm9>)
+define(<T0>, <%ymm10>)
+define(<T1>, <%ymm11>)
+
+C The column parities share registers with the B values.
+define(<C0>, <%ymm5>)
+define(<C1>, <%ymm6>)
+define(<C2>, <%ymm7>)
+define(<C3>, <%ymm8>)
+define(<C4>, <%ymm9>)
+
+define(<FRAME_SIZE>, <800>)
+
+C W(i, base)
+define(<W>, <eval(32*$1)($2)>)
+
+C ROTL(x, k, tmp)
+define(<ROTL>, <ifelse($2, 0, , <
+	vpsrlq	<$>eval(64 - $2), $1, $3
+	vpsllq	<$>$2, $1, $1
+	vpor	$3, $1, $1>)>)
+
+C PARITY(c, x, src)
+define(<PARITY>, <
+	vmovdqu	W($2, $3), $1
+	vpxor	W(eval($2 + 5), $3), $1, $1
+	vpxor	W(eval($2 + 10), $3), $1, $1
+	vpxor	W(eval($2 + 15), $3), $1, $1
+	vpxor	W(eval($2 + 20), $3), $1, $1
+>)
+
+C THETA_D(d, c_prev, c_next)
+C d = c_prev ^ (c_next <<< 1)
+define(<THETA_D>, <
+	vpsrlq	<$>63, $3, T0
+	vpaddq	$3, $3, $1
+	vpor	T0, $1, $1
+	vpxor	$2, $1, $1
+>)
+
+C LOAD_B(b, i, d, k, src)
+C b = (A[i] ^ d) <<< k
+define(<LOAD_B>, <
+	vpxor	W($2, $5), $3, $1
+	ROTL($1, $4, T0)
+>)
+
+C CHI(dst, x0, x1, x2, dst_base)
+C A[dst] = x0 ^ (~x1 & x2)
+define(<CHI>, <
+	vpandn	$4, $3, T0
+	vpxor	$2, T0, T0
+	vmovdqu	T0, W($1, $5)
+>)
+
+C PLANE(y, i0, d0, k0, ..., i4, d4, k4, src, dst)
+C Computes output words 5y, ..., 5y + 4.
+define(<PLANE>, <
+	LOAD_B(B0, $2, $3, $4, $17)
+	LOAD_B(B1, $5, $6, $7, $17)
+	LOAD_B(B2, $8, $9, $10, $17)
+	LOAD_B(B3, $11, $12, $13, $17)
+	LOAD_B(B4, $14, $15, $16, $17)
+	ifelse($1, 0, <
+	vpandn	B2, B1, T0
+	vpxor	B0, T0, T0
+	vpbroadcastq	(RC), T1
+	vpxor	T1, T0, T0
+	vmovdqu	T0, W(0, $18)>, <
+	CHI(eval(5*$1), B0, B1, B2, $18)>)
+	CHI(eval(5*$1 + 1), B1, B2, B3, $18)
+	CHI(eval(5*$1 + 2), B2, B3, B4, $18)
+	CHI(eval(5*$1 + 3), B3, B4, B0, $18)
+	CHI(eval(5*$1 + 4), B4, B0, B1, $18)
+>)
+
+C ROUND(src, dst)
+define(<ROUND>, <
+	PARITY(C0, 0, $1)
+	PARITY(C1, 1, $1)
+	PARITY(C2, 2, $1)
+	PARITY(C3, 3, $1)
+	PARITY(C4, 4, $1)
+	THETA_D(D0, C4, C1)
+	THETA_D(D1, C0, C2)
+	THETA_D(D2, C1, C3)
+	THETA_D(D3, C2, C4)
+	THETA_D(D4, C3, C0)
+
+	C Rho and pi, then chi, one output plane at a time.
+	PLANE(0,  0, D0,  0,  6, D1, 44, 12, D2, 43, 18, D3, 21, 24, D4, 14, $1, $2)
+	PLANE(1,  3, D3, 28,  9, D4, 20, 10, D0,  3, 16, D1, 45, 22, D2, 61, $1, $2)
+	PLANE(2,  1, D1,  1,  7, D2,  6, 13, D3, 25, 19, D4,  8, 20, D0, 18, $1, $2)
+	PLANE(3,  4, D4, 27,  5, D0, 36, 11, D1, 10, 17, D2, 15, 23, D3, 56, $1, $2)
+	PLANE(4,  2, D2, 62,  8, D3, 55, 14, D4, 39, 15, D0, 41, 21, D1,  2, $1, $2)
+	add	<$>8, RC
+>)
+
+	.file "sha3-permute-4.asm"
+
+	C _nettle_sha3_permute_4(uint64_t *state)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_sha3_permute_4)
+	W64_ENTRY(1, 12)
+	sub	$FRAME_SIZE, %rsp
+	lea	.Lrc(%rip), RC
+	mov	$12, COUNT
+
+	ALIGN(16)
+.Loop:
+	ROUND(STATE, %rsp)
+	ROUND(%rsp, STATE)
+	dec	COUNT
+	jnz	.Loop
+
+	vzeroupper
+	add	$FRAME_SIZE, %rsp
+	W64_EXIT(1, 12)
+	ret
+EPILOGUE(_nettle_sha3_permute_4)
+
+	RODATA
+	ALIGN(16)
+.Lrc:
+	.quad	0x0000000000000001
+	.quad	0x0000000000008082
+	.quad	0x800000000000808A
+	.quad	0x8000000080008000
+	.quad	0x000000000000808B
+	.quad	0x0000000080000001
+	.quad	0x8000000080008081
+	.quad	0x8000000000008009
+	.quad	0x000000000000008A
+	.quad	0x0000000000000088
+	.quad	0x0000000080008009
+	.quad	0x000000008000000A
+	.quad	0x000000008000808B
+	.quad	0x800000000000008B
+	.quad	0x8000000000008089
+	.quad	0x8000000000008003
+	.quad	0x8000000000008002
+	.quad	0x8000000000000080
+	.quad	0x000000000000800A
+	.quad	0x800000008000000A
+	.quad	0x8000000080008081
+	.quad	0x8000000000008080
+	.quad	0x0000000080000001
+	.quad	0x8000000080008008
@@ -0,0 +1,253 @@
+C x86_64/avx2/sha512-compress-4.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+C Compresses blocks for four independent SHA512 messages in
+C parallel. The state is transposed, with word j of lane i at
+C state[4*j + i], so that each ymm register holds one state word for
+C all lanes. Message words are loaded four at a time from each lane
+C and transposed as a 4x4 matrix of 64-bit words. The sixteen most
+C recent message words are kept on the stack.
+
+define(<STATE>, <%rdi>)
+define(<INPUT>, <%rsi>)
+define(<BLOCKS>, <%rdx>)
+define(<K>, <%rcx>)
+define(<OFFSET>, <%r8>)
+define(<KP>, <%r9>)
+define(<COUNT>, <%r10>)
+define(<PTR>, <%rax>)
+
+define(<SA>, <%ymm0>)
+define(<SB>, <%ymm1>)
+define(<SC>, <%ymm2>)
+define(<SD>, <%ymm3>)
+define(<SE>, <%ymm4>)
+define(<SF>, <%ymm5>)
+define(<SG>, <%ymm6>)
+define(<SH>, <%ymm7>)
+define(<T0>, <%ymm8>)
+define(<T1>, <%ymm9>)
+define(<T2>, <%ymm10>)
+define(<T3>, <%ymm11>)
+
+C Used for loading the message
+define(<X0>, <%ymm8>)
+define(<X1>, <%ymm9>)
+define(<X2>, <%ymm10>)
+define(<X3>, <%ymm11>)
+define(<U0>, <%ymm12>)
+define(<U1>, <%ymm13>)
+define(<U2>, <%ymm14>)
+define(<U3>, <%ymm15>)
+
+C Stack frame: message words W[i mod 16].
+define(<W>, <eval(32*(($1) % 16))(%rsp)>)
+define(<FRAME_SIZE>, <512>)
+
+C LOAD(group)
+C Loads message words 4*group, ..., 4*group + 3, and stores them,
+C transposed and byte swapped, at W(4*group), ...
+define(<LOAD>, <
+	mov	(INPUT), PTR
+	vmovdqu	eval(32*$1)(PTR, OFFSET), X0
+	mov	8(INPUT), PTR
+	vmovdqu	eval(32*$1)(PTR, OFFSET), X1
+	mov	16(INPUT), PTR
+	vmovdqu	eval(32*$1)(PTR, OFFSET), X2
+	mov	24(INPUT), PTR
+	vmovdqu	eval(32*$1)(PTR, OFFSET), X3
+	vpunpcklqdq	X1, X0, U0
+	vpunpckhqdq	X1, X0, U1
+	vpunpcklqdq	X3, X2, U2
+	vpunpckhqdq	X3, X2, U3
+	vperm2i128	<$>0x20, U2, U0, X0
+	vperm2i128	<$>0x20, U3, U1, X1
+	vperm2i128	<$>0x31, U2, U0, X2
+	vperm2i128	<$>0x31, U3, U1, X3
+	vpshufb	.Lbswap(%rip), X0, X0
+	vpshufb	.Lbswap(%rip), X1, X1
+	vpshufb	.Lbswap(%rip), X2, X2
+	vpshufb	.Lbswap(%rip), X3, X3
+	vmovdqu	X0, W(4*$1)
+	vmovdqu	X1, W(4*$1 + 1)
+	vmovdqu	X2, W(4*$1 + 2)
+	vmovdqu	X3, W(4*$1 + 3)
+>)
+
+C SIGMA(x, dst, tmp, s, r1, r2)
+C dst = (x >> s) ^ (x >>> r1) ^ (x >>> r2), as in the message schedule.
+define(<SIGMA>, <
+	vpsrlq	<$>$4, $1, $2
+	vpsrlq	<$>$5, $1, $3
+	vpxor	$3, $2, $2
+	vpsllq	<$>eval(64 - $5), $1, $3
+	vpxor	$3, $2, $2
+	vpsrlq	<$>$6, $1, $3
+	vpxor	$3, $2, $2
+	vpsllq	<$>eval(64 - $6), $1, $3
+	vpxor	$3, $2, $2
+>)
+
+C BIG_SIGMA(x, dst, tmp, r0, r1, r2)
+C dst = (x >>> r0) ^ (x >>> r1) ^ (x >>> r2), as in the rounds.
+define(<BIG_SIGMA>, <
+	SIGMA($1, $2, $3, $4, $5, $6)
+	vpsllq	<$>eval(64 - $4), $1, $3
+	vpxor	$3, $2, $2
+>)
+
+C EXPAND(i)
+C Computes W[i] = s1(W[i-2]) + W[i-7] + s0(W[i-15]) + W[i-16],
+C leaving it in T0.
+define(<EXPAND>, <
+	vmovdqu	W($1 + 1), T0
+	SIGMA(T0, T1, T2, 7, 1, 8)
+	vmovdqu	W($1 + 14), T0
+	SIGMA(T0, T3, T2, 6, 19, 61)
+	vpaddq	T3, T1, T1
+	vpaddq	W($1 + 9), T1, T1
+	vpaddq	W($1), T1, T0
+	vmovdqu	T0, W($1)
+>)
+
+C ROUND(a, b, c, d, e, f, g, h, i, expand)
+C The message word is W(i), and the constant is at 8*i(KP).
+define(<ROUND>, <
+	ifelse($10, 1, <EXPAND($9)>, <vmovdqu	W($9), T0>)
+	vpbroadcastq	eval(8*$9)(KP), T1
+	vpaddq	T1, T0, T0
+	vpaddq	T0, $8, $8
+	BIG_SIGMA($5, T0, T1, 14, 18, 41)
+	vpaddq	T0, $8, $8
+	vpxor	$6, $7, T0
+	vpand	$5, T0, T0
+	vpxor	$7, T0, T0
+	vpaddq	T0, $8, $8
+	vpaddq	$8, $4, $4
+	BIG_SIGMA($1, T0, T1, 28, 34, 39)
+	vpaddq	T0, $8, $8
+	vpxor	$1, $2, T0
+	vpand	$3, T0, T0
+	vpand	$1, $2, T1
+	vpxor	T1, T0, T0
+	vpaddq	T0, $8, $8
+>)
+
+C ROUND16(expand)
+define(<ROUND16>, <
+	ROUND(SA, SB, SC, SD, SE, SF, SG, SH, 0, $1)
+	ROUND(SH, SA, SB, SC, SD, SE, SF, SG, 1, $1)
+	ROUND(SG, SH, SA, SB, SC, SD, SE, SF, 2, $1)
+	ROUND(SF, SG, SH, SA, SB, SC, SD, SE, 3, $1)
+	ROUND(SE, SF, SG, SH, SA, SB, SC, SD, 4, $1)
+	ROUND(SD, SE, SF, SG, SH, SA, SB, SC, 5, $1)
+	ROUND(SC, SD, SE, SF, SG, SH, SA, SB, 6, $1)
+	ROUND(SB, SC, SD, SE, SF, SG, SH, SA, 7, $1)
+	ROUND(SA, SB, SC, SD, SE, SF, SG, SH, 8, $1)
+	ROUND(SH, SA, SB, SC, SD, SE, SF, SG, 9, $1)
+	ROUND(SG, SH, SA, SB, SC, SD, SE, SF, 10, $1)
+	ROUND(SF, SG, SH, SA, SB, SC, SD, SE, 11, $1)
+	ROUND(SE, SF, SG, SH, SA, SB, SC, SD, 12, $1)
+	ROUND(SD, SE, SF, SG, SH, SA, SB, SC, 13, $1)
+	ROUND(SC, SD, SE, SF, SG, SH, SA, SB, 14, $1)
+	ROUND(SB, SC, SD, SE, SF, SG, SH, SA, 15, $1)
+>)
+
+	C _nettle_sha512_compress_4(uint64_t *state, const uint8_t **input,
+	C			    size_t blocks, const uint64_t *k)
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_sha512_compress_4)
+	W64_ENTRY(4, 16)
+	test	BLOCKS, BLOCKS
+	jz	.Lend
+	sub	$FRAME_SIZE, %rsp
+
+	vmovdqu	(STATE), SA
+	vmovdqu	32(STATE), SB
+	vmovdqu	64(STATE), SC
+	vmovdqu	96(STATE), SD
+	vmovdqu	128(STATE), SE
+	vmovdqu	160(STATE), SF
+	vmovdqu	192(STATE), SG
+	vmovdqu	224(STATE), SH
+	xor	OFFSET, OFFSET
+
+.Loop:
+	LOAD(0)
+	LOAD(1)
+	LOAD(2)
+	LOAD(3)
+
+	mov	K, KP
+	ROUND16(0)
+	mov	$4, COUNT
+.Lexpand:
+	add	$128, KP
+	ROUND16(1)
+	dec	COUNT
+	jnz	.Lexpand
+
+	vpaddq	(STATE), SA, SA
+	vpaddq	32(STATE), SB, SB
+	vpaddq	64(STATE), SC, SC
+	vpaddq	96(STATE), SD, SD
+	vpaddq	128(STATE), SE, SE
+	vpaddq	160(STATE), SF, SF
+	vpaddq	192(STATE), SG, SG
+	vpaddq	224(STATE), SH, SH
+	vmovdqu	SA, (STATE)
+	vmovdqu	SB, 32(STATE)
+	vmovdqu	SC, 64(STATE)
+	vmovdqu	SD, 96(STATE)
+	vmovdqu	SE, 128(STATE)
+	vmovdqu	SF, 160(STATE)
+	vmovdqu	SG, 192(STATE)
+	vmovdqu	SH, 224(STATE)
+
+	sub	$-128, OFFSET
+	dec	BLOCKS
+	jnz	.Loop
+
+	vzeroupper
+	add	$FRAME_SIZE, %rsp
+.Lend:
+	W64_EXIT(4, 16)
+	ret
+EPILOGUE(_nettle_sha512_compress_4)
+
+	RODATA
+	ALIGN(32)
+.Lbswap:
+	.byte	7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+	.byte	7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
@@ -0,0 +1,267 @@
+C x86_64/avx2/sha512-compress.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+C SHA512 compression with the message schedule computed using avx2,
+C four words at a time, and the rounds done with general registers as
+C in x86_64/sha512-compress.asm. All 80 sums W[i] + K[i] are computed
+C up front and stored on the stack.
+C
+C Each schedule step computes W[t], ..., W[t+3] from four registers
+C holding W[t-16], ..., W[t-1]. The s1 terms for W[t+2] and W[t+3]
+C depend on W[t] and W[t+1], so they are added in a second pass.
+
+	.file "sha512-compress.asm"
+define(<STATE>, <%rdi>)
+define(<INPUT>, <%rsi>)
+define(<K>, <%rdx>)
+define(<SA>, <%rax>)
+define(<SB>, <%rbx>)
+define(<SC>, <%rcx>)
+define(<SD>, <%r8>)
+define(<SE>, <%r9>)
+define(<SF>, <%r10>)
+define(<SG>, <%r11>)
+define(<SH>, <%r12>)
+define(<T0>, <%r13>)
+define(<T1>, <%r14>)
+define(<COUNT>, <%r15>)
+
+define(<X0>, <%ymm0>)
+define(<X1>, <%ymm1>)
+define(<X2>, <%ymm2>)
+define(<X3>, <%ymm3>)
+define(<Y0>, <%ymm4>)
+define(<Y1>, <%ymm5>)
+define(<Y2>, <%ymm6>)
+define(<BSWAP>, <%ymm7>)
+define(<ROT8>, <%ymm8>)
+
+C Stack frame: W[i] + K[i], followed by saved registers.
+define(<FRAME_WK>, <0>)
+define(<FRAME_REGS>, <640>)
+define(<FRAME_SIZE>, <680>)
+
+C SIGMA0(x, dst, tmp)
+C dst = (x >>> 1) ^ (x >>> 8) ^ (x >> 7)
+define(<SIGMA0>, <
+	vpsrlq	<$>1, $1, $2
+	vpsllq	<$>63, $1, $3
+	vpxor	$3, $2, $2
+	vpshufb	ROT8, $1, $3
+	vpxor	$3, $2, $2
+	vpsrlq	<$>7, $1, $3
+	vpxor	$3, $2, $2
+>)
+
+C SIGMA1(x, dst, tmp)
+C dst = (x >>> 19) ^ (x >>> 61) ^ (x >> 6)
+define(<SIGMA1>, <
+	vpsrlq	<$>19, $1, $2
+	vpsllq	<$>45, $1, $3
+	vpxor	$3, $2, $2
+	vpsrlq	<$>61, $1, $3
+	vpxor	$3, $2, $2
+	vpsllq	<$>3, $1, $3
+	vpxor	$3, $2, $2
+	vpsrlq	<$>6, $1, $3
+	vpxor	$3, $2, $2
+>)
+
+C EXPN(i, x0, x1, x2, x3)
+C Replaces x0 = W[t-16], ..., W[t-13] by W[t], ..., W[t+3], where
+C t = 4i, and stores the sums with the round constants.
+define(<EXPN>, <
+	C W[t-15], ..., W[t-12]
+	vperm2i128	<$>0x21, $3, $2, Y0
+	vpalignr	<$>8, $2, Y0, Y0
+	SIGMA0(Y0, Y1, Y2)
+	vpaddq	Y1, $2, $2
+	C W[t-7], ..., W[t-4]
+	vperm2i128	<$>0x21, $5, $4, Y0
+	vpalignr	<$>8, $4, Y0, Y0
+	vpaddq	Y0, $2, $2
+	C s1(W[t-2]), s1(W[t-1]), added to the low half
+	SIGMA1($5, Y1, Y2)
+	vperm2i128	<$>0x81, Y1, Y1, Y1
+	vpaddq	Y1, $2, $2
+	C s1(W[t]), s1(W[t+1]), added to the high half
+	SIGMA1($2, Y1, Y2)
+	vperm2i128	<$>0x08, Y1, Y1, Y1
+	vpaddq	Y1, $2, $2
+	vpaddq	eval(32*$1)(K), $2, Y0
+	vmovdqu	Y0, eval(FRAME_WK + 32*$1)(%rsp)
+>)
+
+C EXPN4(i)
+define(<EXPN4>, <
+	EXPN($1, X0, X1, X2, X3)
+	EXPN(eval($1 + 1), X1, X2, X3, X0)
+	EXPN(eval($1 + 2), X2, X3, X0, X1)
+	EXPN(eval($1 + 3), X3, X0, X1, X2)
+>)
+
+C ROUND(A,B,C,D,E,F,G,H,i)
+C
+C H += S1(E) + Choice(E,F,G) + K[i] + W[i]
+C D += H
+C H += S0(A) + Majority(A,B,C)
+C
+C See x86_64/sha512-compress.asm. Here, i is relative to COUNT.
+
+define(<ROUND>, <
+	mov	$5, T0
+	mov	$5, T1
+	rol	<$>23, T0
+	rol	<$>46, T1
+	xor	T0, T1
+	rol	<$>27, T0
+	xor	T0, T1
+	add	OFFSET64($9)(%rsp,COUNT,8), $8
+	add	T1, $8
+	mov	$7, T0
+	xor	$6, T0
+	and	$5, T0
+	xor	$7, T0
+	add	T0, $8
+	add	$8, $4
+
+	mov	$1, T0
+	mov	$1, T1
+	rol	<$>25, T0
+	rol	<$>30, T1
+	xor	T0, T1
+	rol	<$>11, T0
+	xor	T0, T1
+	add	T1, $8
+	mov	$1, T0
+	mov	$1, T1
+	and	$2, T0
+	xor	$2, T1
+	add	T0, $8
+	and	$3, T1
+	add	T1, $8
+>)
+
+	C void
+	C _nettle_sha512_compress(uint64_t *state, const uint8_t *input, const uint64_t *k)
+
+	.text
+	ALIGN(16)
+
+PROLOGUE(_nettle_sha512_compress)
+	W64_ENTRY(3, 9)
+
+	sub	$FRAME_SIZE, %rsp
+	mov	%rbx, eval(FRAME_REGS)(%rsp)
+	mov	%r12, eval(FRAME_REGS + 8)(%rsp)
+	mov	%r13, eval(FRAME_REGS + 16)(%rsp)
+	mov	%r14, eval(FRAME_REGS + 24)(%rsp)
+	mov	%r15, eval(FRAME_REGS + 32)(%rsp)
+
+	vmovdqa	.Lbswap(%rip), BSWAP
+	vmovdqa	.Lrot8(%rip), ROT8
+
+	vmovdqu	(INPUT), X0
+	vmovdqu	32(INPUT), X1
+	vmovdqu	64(INPUT), X2
+	vmovdqu	96(INPUT), X3
+	vpshufb	BSWAP, X0, X0
+	vpshufb	BSWAP, X1, X1
+	vpshufb	BSWAP, X2, X2
+	vpshufb	BSWAP, X3, X3
+	vpaddq	(K), X0, Y0
+	vmovdqu	Y0, eval(FRAME_WK)(%rsp)
+	vpaddq	32(K), X1, Y0
+	vmovdqu	Y0, eval(FRAME_WK + 32)(%rsp)
+	vpaddq	64(K), X2, Y0
+	vmovdqu	Y0, eval(FRAME_WK + 64)(%rsp)
+	vpaddq	96(K), X3, Y0
+	vmovdqu	Y0, eval(FRAME_WK + 96)(%rsp)
+
+	EXPN4(4)
+	EXPN4(8)
+	EXPN4(12)
+	EXPN4(16)
+	vzeroupper
+
+	mov	(STATE),   SA
+	mov	8(STATE),  SB
+	mov	16(STATE), SC
+	mov	24(STATE), SD
+	mov	32(STATE), SE
+	mov	40(STATE), SF
+	mov	48(STATE), SG
+	mov	56(STATE), SH
+	xor	COUNT, COUNT
+	ALIGN(16)
+
+.Loop:
+	ROUND(SA,SB,SC,SD,SE,SF,SG,SH,0)
+	ROUND(SH,SA,SB,SC,SD,SE,SF,SG,1)
+	ROUND(SG,SH,SA,SB,SC,SD,SE,SF,2)
+	ROUND(SF,SG,SH,SA,SB,SC,SD,SE,3)
+	ROUND(SE,SF,SG,SH,SA,SB,SC,SD,4)
+	ROUND(SD,SE,SF,SG,SH,SA,SB,SC,5)
+	ROUND(SC,SD,SE,SF,SG,SH,SA,SB,6)
+	ROUND(SB,SC,SD,SE,SF,SG,SH,SA,7)
+	add	$8, COUNT
+	cmp	$80, COUNT
+	jne	.Loop
+
+	add	SA, (STATE)
+	add	SB, 8(STATE)
+	add	SC, 16(STATE)
+	add	SD, 24(STATE)
+	add	SE, 32(STATE)
+	add	SF, 40(STATE)
+	add	SG, 48(STATE)
+	add	SH, 56(STATE)
+
+	mov	eval(FRAME_REGS)(%rsp), %rbx
+	mov	eval(FRAME_REGS + 8)(%rsp), %r12
+	mov	eval(FRAME_REGS + 16)(%rsp), %r13
+	mov	eval(FRAME_REGS + 24)(%rsp), %r14
+	mov	eval(FRAME_REGS + 32)(%rsp), %r15
+	add	$FRAME_SIZE, %rsp
+
+	W64_EXIT(3, 9)
+	ret
+EPILOGUE(_nettle_sha512_compress)
+
+	RODATA
+	ALIGN(32)
+.Lbswap:
+	.byte	7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+	.byte	7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+.Lrot8:
+	.byte	1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8
+	.byte	1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8
@@ -0,0 +1,232 @@
+C x86_64/chacha-4core.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+C Generates four consecutive ChaCha blocks in parallel. The state is
+C kept transposed, with each xmm register holding the same state word
+C for all four blocks. Words 0-3 are kept on the stack, leaving two
+C registers for temporaries.
+
+define(<DST>, <%rdi>)
+define(<SRC>, <%rsi>)
+define(<ROUNDS>, <%rdx>)
+
+C State words 4-15
+define(<X4>, <%xmm0>)
+define(<X5>, <%xmm1>)
+define(<X6>, <%xmm2>)
+define(<X7>, <%xmm3>)
+define(<X8>, <%xmm4>)
+define(<X9>, <%xmm5>)
+define(<X10>, <%xmm6>)
+define(<X11>, <%xmm7>)
+define(<X12>, <%xmm8>)
+define(<X13>, <%xmm9>)
+define(<X14>, <%xmm10>)
+define(<X15>, <%xmm11>)
+define(<T0>, <%xmm12>)
+define(<T1>, <%xmm13>)
+define(<T2>, <%xmm14>)
+define(<T3>, <%xmm15>)
+
+C Stack frame: words 0-3, followed by the initial words 12 and 13.
+define(<FRAME_X12>, <64>)
+define(<FRAME_X13>, <80>)
+define(<FRAME_SIZE>, <96>)
+
+C QROUND(a, b, c, d)
+C The a word is a stack offset, the others are registers.
+define(<QROUND>, <
+	movdqu	$1(%rsp), T0
+	paddd	$2, T0
+	pxor	T0, $4
+	pshufhw	<$>0xb1, $4, $4
+	pshuflw	<$>0xb1, $4, $4
+
+	paddd	$4, $3
+	pxor	$3, $2
+	movdqa	$2, T1
+	pslld	<$>12, $2
+	psrld	<$>20, T1
+	por	T1, $2
+
+	paddd	$2, T0
+	pxor	T0, $4
+	movdqu	T0, $1(%rsp)
+	movdqa	$4, T1
+	pslld	<$>8, $4
+	psrld	<$>24, T1
+	por	T1, $4
+
+	paddd	$4, $3
+	pxor	$3, $2
+	movdqa	$2, T1
+	pslld	<$>7, $2
+	psrld	<$>25, T1
+	por	T1, $2
+>)
+
+C BROADCAST(offset, xmm)
+define(<BROADCAST>, <
+	movd	$1(SRC), $2
+	pshufd	<$>0, $2, $2
+>)
+
+C ADD_INPUT(i, x)
+C Adds input word i to x, using T2.
+define(<ADD_INPUT>, <
+	BROADCAST(eval(4*$1), T2)
+	paddd	T2, $2
+>)
+
+C TRANSPOSE(r0, r1, r2, r3, offset)
+C Transposes four rows, and stores them at the given offset in each
+C of the four output blocks. Clobbers the rows, T0 and T1.
+define(<TRANSPOSE>, <
+	movdqa	$1, T0
+	punpckldq	$2, T0
+	punpckhdq	$2, $1
+	movdqa	$3, T1
+	punpckldq	$4, T1
+	punpckhdq	$4, $3
+	movdqa	T0, $2
+	punpcklqdq	T1, $2
+	punpckhqdq	T1, T0
+	movdqa	$1, $4
+	punpcklqdq	$3, $4
+	punpckhqdq	$3, $1
+	movups	$2, $5(DST)
+	movups	T0, eval($5 + 64)(DST)
+	movups	$4, eval($5 + 128)(DST)
+	movups	$1, eval($5 + 192)(DST)
+>)
+
+	.file "chacha-4core.asm"
+
+	C _chacha_4core(uint32_t *dst, const uint32_t *src, unsigned rounds)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_chacha_4core)
+	W64_ENTRY(3, 16)
+	sub	$FRAME_SIZE, %rsp
+
+	BROADCAST(0, T0)
+	BROADCAST(4, T1)
+	movdqu	T0, 0(%rsp)
+	movdqu	T1, 16(%rsp)
+	BROADCAST(8, T0)
+	BROADCAST(12, T1)
+	movdqu	T0, 32(%rsp)
+	movdqu	T1, 48(%rsp)
+
+	BROADCAST(16, X4)
+	BROADCAST(20, X5)
+	BROADCAST(24, X6)
+	BROADCAST(28, X7)
+	BROADCAST(32, X8)
+	BROADCAST(36, X9)
+	BROADCAST(40, X10)
+	BROADCAST(44, X11)
+	BROADCAST(56, X14)
+	BROADCAST(60, X15)
+
+	C Block counters, with carry from word 12 to word 13. The
+	C unsigned comparison is done by flipping the sign bits.
+	BROADCAST(48, T0)
+	BROADCAST(52, X13)
+	movdqa	T0, X12
+	paddd	.Lcount(%rip), X12
+	movdqa	.Lsign(%rip), T2
+	movdqa	X12, T1
+	pxor	T2, T0
+	pxor	T2, T1
+	pcmpgtd	T1, T0
+	psubd	T0, X13
+	movdqu	X12, eval(FRAME_X12)(%rsp)
+	movdqu	X13, eval(FRAME_X13)(%rsp)
+
+	shrl	$1, XREG(ROUNDS)
+
+	ALIGN(16)
+.Loop:
+	QROUND(0, X4, X8, X12)
+	QROUND(16, X5, X9, X13)
+	QROUND(32, X6, X10, X14)
+	QROUND(48, X7, X11, X15)
+
+	QROUND(0, X5, X10, X15)
+	QROUND(16, X6, X11, X12)
+	QROUND(32, X7, X8, X13)
+	QROUND(48, X4, X9, X14)
+
+	decl	XREG(ROUNDS)
+	jnz	.Loop
+
+	ADD_INPUT(4, X4)
+	ADD_INPUT(5, X5)
+	ADD_INPUT(6, X6)
+	ADD_INPUT(7, X7)
+	ADD_INPUT(8, X8)
+	ADD_INPUT(9, X9)
+	ADD_INPUT(10, X10)
+	ADD_INPUT(11, X11)
+	movdqu	eval(FRAME_X12)(%rsp), T2
+	paddd	T2, X12
+	movdqu	eval(FRAME_X13)(%rsp), T2
+	paddd	T2, X13
+	ADD_INPUT(14, X14)
+	ADD_INPUT(15, X15)
+
+	TRANSPOSE(X4, X5, X6, X7, 16)
+	TRANSPOSE(X8, X9, X10, X11, 32)
+	TRANSPOSE(X12, X13, X14, X15, 48)
+
+	movdqu	0(%rsp), X4
+	movdqu	16(%rsp), X5
+	movdqu	32(%rsp), X6
+	movdqu	48(%rsp), X7
+	ADD_INPUT(0, X4)
+	ADD_INPUT(1, X5)
+	ADD_INPUT(2, X6)
+	ADD_INPUT(3, X7)
+	TRANSPOSE(X4, X5, X6, X7, 0)
+
+	add	$FRAME_SIZE, %rsp
+	W64_EXIT(3, 16)
+	ret
+EPILOGUE(_nettle_chacha_4core)
+
+	RODATA
+	ALIGN(16)
+.Lcount:
+	.long	0, 1, 2, 3
+.Lsign:
+	.long	0x80000000, 0x80000000, 0x80000000, 0x80000000
@@ -45,6 +45,7 @@ PROLOGUE(_nettle_cpuid)
 	push	%rbx
 	
 	movl	%edi, %eax
+	xorl	%ecx, %ecx
 	cpuid
 	mov	%eax, (%rsi)
 	mov	%ebx, 4(%rsi)
@@ -56,3 +57,14 @@ PROLOGUE(_nettle_cpuid)
 	ret
 EPILOGUE(_nettle_cpuid)
 
+	C uint32_t _nettle_xgetbv(uint32_t xcr)
+	C Returns the low 32 bits of the extended control register.
+
+	ALIGN(16)
+PROLOGUE(_nettle_xgetbv)
+	W64_ENTRY(1)
+	movl	%edi, %ecx
+	xgetbv
+	W64_EXIT(1)
+	ret
+EPILOGUE(_nettle_xgetbv)
@@ -0,0 +1,286 @@
+C x86_64/pclmul/gcm-hash.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+C GHASH using the pclmulqdq (carry-less multiplication) instruction.
+C
+C Field elements are kept byte reversed in the xmm registers, so that
+C the coefficient of x^0 is the most significant bit. In this
+C representation, a carry-less product is off by one bit, which is
+C compensated for by storing the key as H x^{-1}. Then the product
+C is reduced modulo the reflected polynomial as described in Gueron
+C and Kounavis, "Intel Carry-Less Multiplication Instruction and its
+C Usage for Computing the GCM Mode".
+C
+C Only the first 16 elements of the struct gcm_key table are used:
+C
+C   h[0], ..., h[7]:   H^1, ..., H^8 (times x^{-1})
+C   h[8], ..., h[15]:  The xor of the high and low halves of the
+C                      same powers, for Karatsuba multiplication.
+C
+C The hashing loop processes eight blocks at a time, with a single
+C reduction per iteration,
+C
+C   X <- (X + M_0) H^8 + M_1 H^7 + ... + M_7 H
+
+C Register usage:
+
+define(<KEY>, <%rdi>)
+define(<XP>, <%rsi>)
+define(<LENGTH>, <%rdx>)
+define(<SRC>, <%rcx>)
+define(<CNT>, <%ecx>)
+define(<X>, <%xmm0>)
+define(<D>, <%xmm1>)
+define(<H>, <%xmm2>)
+define(<T0>, <%xmm3>)
+define(<T1>, <%xmm4>)
+define(<LO>, <%xmm5>)
+define(<HI>, <%xmm6>)
+define(<MID>, <%xmm7>)
+define(<BSWAP>, <%xmm8>)
+define(<K>, <%xmm8>)	C Used only by gcm_init_key
+
+C MUL_ADD(k)
+C Multiplies D by H^k, without reduction. Adds the three Karatsuba
+C partial products to LO, HI and MID.
+define(<MUL_ADD>, <
+	pshufd	<$>0x4e, D, T0
+	pxor	D, T0
+	movups	eval(16*($1 - 1))(KEY), H
+	movdqa	D, T1
+	pclmulqdq	<$>0x00, H, D
+	pclmulqdq	<$>0x11, H, T1
+	movups	eval(128 + 16*($1 - 1))(KEY), H
+	pclmulqdq	<$>0x00, H, T0
+	pxor	D, LO
+	pxor	T1, HI
+	pxor	T0, MID
+>)
+
+C REDUCE(dst)
+C Combines LO, HI and MID into the 256-bit product, and reduces it
+C modulo the GCM polynomial. The result is stored in dst, and LO, HI
+C and MID are clobbered.
+define(<REDUCE>, <
+	pxor	LO, MID
+	pxor	HI, MID
+	movdqa	MID, T0
+	pslldq	<$>8, T0
+	psrldq	<$>8, MID
+	pxor	T0, LO
+	pxor	MID, HI
+
+	C First phase
+	movdqa	LO, T0
+	psllq	<$>1, T0
+	pxor	LO, T0
+	psllq	<$>5, T0
+	pxor	LO, T0
+	psllq	<$>57, T0
+	movdqa	T0, T1
+	pslldq	<$>8, T1
+	psrldq	<$>8, T0
+	pxor	T1, LO
+	pxor	T0, HI
+
+	C Second phase
+	movdqa	LO, T1
+	psrlq	<$>5, T1
+	pxor	LO, T1
+	psrlq	<$>1, T1
+	pxor	LO, T1
+	psrlq	<$>1, T1
+	pxor	T1, HI
+	pxor	HI, LO
+	movdqa	LO, $1
+>)
+
+	.file "gcm-hash.asm"
+
+	C void gcm_init_key (union nettle_block16 *table)
+	C H is read from table[0x80], as written by gcm_set_key.
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_gcm_init_key)
+	W64_ENTRY(1, 9)
+	C Compute H x^{-1}, i.e., a left shift in the reversed
+	C representation. The bit shifted out is reduced by adding
+	C the polynomial 0xc2000...01.
+	mov	0x800(KEY), %rax
+	mov	0x808(KEY), %rdx
+	bswap	%rax
+	bswap	%rdx
+	mov	%rax, %rcx
+	shr	$63, %rcx
+	mov	%rdx, %r8
+	shr	$63, %r8
+	add	%rax, %rax
+	add	%rdx, %rdx
+	or	%r8, %rax
+	or	%rcx, %rdx
+	neg	%rcx
+	mov	$0xc200000000000000, %r8
+	and	%r8, %rcx
+	xor	%rcx, %rax
+	mov	%rdx, (KEY)
+	mov	%rax, 8(KEY)
+
+	movups	(KEY), H
+	pshufd	$0x4e, H, K
+	pxor	H, K
+	movups	K, 128(KEY)
+	movdqa	H, X
+
+	mov	$7, CNT
+.Linit_loop:
+	C X <- X H. Since the key is stored as H x^{-1}, the products
+	C get the same representation.
+	add	$16, KEY
+	pshufd	$0x4e, X, MID
+	pxor	X, MID
+	movdqa	X, LO
+	movdqa	X, HI
+	pclmulqdq	$0x00, H, LO
+	pclmulqdq	$0x11, H, HI
+	pclmulqdq	$0x00, K, MID
+	REDUCE(X)
+	movups	X, (KEY)
+	pshufd	$0x4e, X, T0
+	pxor	X, T0
+	movups	T0, 128(KEY)
+	dec	CNT
+	jnz	.Linit_loop
+
+	W64_EXIT(1, 9)
+	ret
+EPILOGUE(_nettle_gcm_init_key)
+
+	C void gcm_hash (const struct gcm_key *key, union gcm_block *x,
+	C                size_t length, const uint8_t *data)
+
+	ALIGN(16)
+PROLOGUE(_nettle_gcm_hash)
+	W64_ENTRY(4, 9)
+	movdqa	.Lbswap(%rip), BSWAP
+	movups	(XP), X
+	pshufb	BSWAP, X
+
+	sub	$128, LENGTH
+	jc	.Lblock8_done
+
+	ALIGN(16)
+.Lblock8_loop:
+	pxor	LO, LO
+	pxor	HI, HI
+	pxor	MID, MID
+
+	movups	(SRC), D
+	pshufb	BSWAP, D
+	pxor	X, D
+	MUL_ADD(8)
+	movups	16(SRC), D
+	pshufb	BSWAP, D
+	MUL_ADD(7)
+	movups	32(SRC), D
+	pshufb	BSWAP, D
+	MUL_ADD(6)
+	movups	48(SRC), D
+	pshufb	BSWAP, D
+	MUL_ADD(5)
+	movups	64(SRC), D
+	pshufb	BSWAP, D
+	MUL_ADD(4)
+	movups	80(SRC), D
+	pshufb	BSWAP, D
+	MUL_ADD(3)
+	movups	96(SRC), D
+	pshufb	BSWAP, D
+	MUL_ADD(2)
+	movups	112(SRC), D
+	pshufb	BSWAP, D
+	MUL_ADD(1)
+	REDUCE(X)
+
+	add	$128, SRC
+	sub	$128, LENGTH
+	jnc	.Lblock8_loop
+
+.Lblock8_done:
+	add	$112, LENGTH
+	jnc	.Lfinal
+
+	ALIGN(16)
+.Lblock_loop:
+	movups	(SRC), D
+.Lblock_mul:
+	pshufb	BSWAP, D
+	pxor	X, D
+	pxor	LO, LO
+	pxor	HI, HI
+	pxor	MID, MID
+	MUL_ADD(1)
+	REDUCE(X)
+
+	add	$16, SRC
+	sub	$16, LENGTH
+	jnc	.Lblock_loop
+
+.Lfinal:
+	add	$16, LENGTH
+	jnz	.Lpartial
+
+	pshufb	BSWAP, X
+	movups	X, (XP)
+	W64_EXIT(4, 9)
+	ret
+
+.Lpartial:
+	C Copy the final partial block to a zero-padded buffer on the
+	C stack, then jump back into the loop with LENGTH == 0.
+	sub	$16, %rsp
+	pxor	D, D
+	movups	D, (%rsp)
+.Lread_loop:
+	movb	-1(SRC, LENGTH), %al
+	movb	%al, -1(%rsp, LENGTH)
+	sub	$1, LENGTH
+	jnz	.Lread_loop
+	movups	(%rsp), D
+	add	$16, %rsp
+	jmp	.Lblock_mul
+EPILOGUE(_nettle_gcm_hash)
+
+	RODATA
+	ALIGN(16)
+.Lbswap:
+	.byte	15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0
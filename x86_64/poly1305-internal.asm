@@ -65,6 +65,7 @@ PROLOGUE(nettle_poly1305_set_key)
 	mov	%rax, P1305_H0 (CTX)
 	mov	%rax, P1305_H1 (CTX)
 	mov	XREG(%rax), P1305_H2 (CTX)
+	mov	XREG(%rax), P1305_HAVE_POWERS (CTX)
 	
 	W64_EXIT(2,0)
 	ret
@@ -0,0 +1,139 @@
+C x86_64/sha_ni/sha1-compress.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+C SHA1 compression using the sha1rnds4, sha1nexte, sha1msg1 and
+C sha1msg2 instructions.
+C
+C The working variables A, B, C, D are kept in a single register,
+C with A as the most significant word. E is kept in the most
+C significant word of a separate register, which alternates between
+C E0 and E1; sha1nexte computes the next E (rotating the saved A)
+C and adds it to the next four message words.
+
+C Register usage:
+
+define(<STATE>, <%rdi>)
+define(<INPUT>, <%rsi>)
+define(<ABCD>, <%xmm0>)
+define(<E0>, <%xmm1>)
+define(<E1>, <%xmm2>)
+define(<M0>, <%xmm3>)
+define(<M1>, <%xmm4>)
+define(<M2>, <%xmm5>)
+define(<M3>, <%xmm6>)
+define(<BSWAP>, <%xmm7>)
+define(<ABCD_SAVE>, <%xmm8>)
+define(<E_SAVE>, <%xmm9>)
+
+C RANGE(i, lo, hi) expands to 1 if lo <= i <= hi, otherwise 0.
+changequote([,])dnl
+define([RANGE], [eval($1 >= $2 && $3 >= $1)])dnl
+changequote(<,>)dnl
+
+C QROUND(i, Mi, Mi-1, Mi+1, Mi+2, E, E')
+C Rounds 4i, ..., 4i+3, using E and leaving the old A in E' for the
+C next group. The message schedule is computed in parallel.
+define(<QROUND>, <
+	ifelse(RANGE($1, 0, 3), 1, <
+	movups	eval(16*$1)(INPUT), $2
+	pshufb	BSWAP, $2
+	>)
+	ifelse($1, 0, <
+	paddd	$2, $6
+	>, <
+	sha1nexte	$2, $6
+	>)
+	movdqa	ABCD, $7
+	ifelse(RANGE($1, 3, 18), 1, <
+	sha1msg2	$2, $4
+	>)
+	sha1rnds4	<$>eval($1 / 5), $6, ABCD
+	ifelse(RANGE($1, 1, 16), 1, <
+	sha1msg1	$2, $3
+	>)
+	ifelse(RANGE($1, 2, 17), 1, <
+	pxor	$2, $5
+	>)
+>)
+
+	C _nettle_sha1_compress(uint32_t *state, const uint8_t *input)
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_sha1_compress)
+	W64_ENTRY(2, 10)
+
+	movups	(STATE), ABCD
+	movd	16(STATE), E0
+	pshufd	<$>0x1b, ABCD, ABCD
+	pslldq	<$>12, E0
+	movdqa	.Lbswap(%rip), BSWAP
+
+	movdqa	ABCD, ABCD_SAVE
+	movdqa	E0, E_SAVE
+
+	QROUND(0, M0, M3, M1, M2, E0, E1)
+	QROUND(1, M1, M0, M2, M3, E1, E0)
+	QROUND(2, M2, M1, M3, M0, E0, E1)
+	QROUND(3, M3, M2, M0, M1, E1, E0)
+	QROUND(4, M0, M3, M1, M2, E0, E1)
+	QROUND(5, M1, M0, M2, M3, E1, E0)
+	QROUND(6, M2, M1, M3, M0, E0, E1)
+	QROUND(7, M3, M2, M0, M1, E1, E0)
+	QROUND(8, M0, M3, M1, M2, E0, E1)
+	QROUND(9, M1, M0, M2, M3, E1, E0)
+	QROUND(10, M2, M1, M3, M0, E0, E1)
+	QROUND(11, M3, M2, M0, M1, E1, E0)
+	QROUND(12, M0, M3, M1, M2, E0, E1)
+	QROUND(13, M1, M0, M2, M3, E1, E0)
+	QROUND(14, M2, M1, M3, M0, E0, E1)
+	QROUND(15, M3, M2, M0, M1, E1, E0)
+	QROUND(16, M0, M3, M1, M2, E0, E1)
+	QROUND(17, M1, M0, M2, M3, E1, E0)
+	QROUND(18, M2, M1, M3, M0, E0, E1)
+	QROUND(19, M3, M2, M0, M1, E1, E0)
+
+	sha1nexte	E_SAVE, E0
+	paddd	ABCD_SAVE, ABCD
+
+	pshufd	<$>0x1b, ABCD, ABCD
+	movups	ABCD, (STATE)
+	pextrd	<$>3, E0, 16(STATE)
+
+	W64_EXIT(2, 10)
+	ret
+EPILOGUE(_nettle_sha1_compress)
+
+	RODATA
+	ALIGN(16)
+.Lbswap:
+	.byte	15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0
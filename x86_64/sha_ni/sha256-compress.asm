@@ -0,0 +1,142 @@
+C x86_64/sha_ni/sha256-compress.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+C SHA256 compression using the sha256rnds2, sha256msg1 and
+C sha256msg2 instructions.
+C
+C sha256rnds2 does two rounds, with the message words plus round
+C constants implicitly in the low half of %xmm0. The state is kept
+C in the order the instructions expect, ABEF and CDGH (most
+C significant word first), and is shuffled to and from the in-memory
+C order A, ..., H only on entry and exit.
+
+C Register usage:
+
+define(<STATE>, <%rdi>)
+define(<INPUT>, <%rsi>)
+define(<K>, <%rdx>)
+define(<MSG>, <%xmm0>)	C Implicit operand of sha256rnds2
+define(<ABEF>, <%xmm1>)
+define(<CDGH>, <%xmm2>)
+define(<M0>, <%xmm3>)
+define(<M1>, <%xmm4>)
+define(<M2>, <%xmm5>)
+define(<M3>, <%xmm6>)
+define(<T>, <%xmm7>)
+define(<BSWAP>, <%xmm8>)
+define(<ABEF_SAVE>, <%xmm9>)
+define(<CDGH_SAVE>, <%xmm10>)
+
+C RANGE(i, lo, hi) expands to 1 if lo <= i <= hi, otherwise 0.
+changequote([,])dnl
+define([RANGE], [eval($1 >= $2 && $3 >= $1)])dnl
+changequote(<,>)dnl
+
+C QROUND(i, Mi, Mi-1, Mi+1)
+C Rounds 4i, ..., 4i+3. The message schedule for later rounds is
+C computed in parallel, one group of four words at a time.
+define(<QROUND>, <
+	ifelse(RANGE($1, 0, 3), 1, <
+	movups	eval(16*$1)(INPUT), $2
+	pshufb	BSWAP, $2
+	>)
+	movdqa	$2, MSG
+	paddd	eval(16*$1)(K), MSG
+	sha256rnds2	ABEF, CDGH
+	ifelse(RANGE($1, 3, 14), 1, <
+	movdqa	$2, T
+	palignr	<$>4, $3, T
+	paddd	T, $4
+	sha256msg2	$2, $4
+	>)
+	pshufd	<$>0x0e, MSG, MSG
+	sha256rnds2	CDGH, ABEF
+	ifelse(RANGE($1, 1, 12), 1, <
+	sha256msg1	$2, $3
+	>)
+>)
+
+	C _nettle_sha256_compress(uint32_t *state, const uint8_t *input, const uint32_t *k)
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_sha256_compress)
+	W64_ENTRY(3, 11)
+
+	movups	(STATE), T		C DCBA
+	movups	16(STATE), CDGH		C HGFE
+	pshufd	<$>0xb1, T, T		C CDAB
+	pshufd	<$>0x1b, CDGH, CDGH	C EFGH
+	movdqa	T, ABEF
+	palignr	<$>8, CDGH, ABEF	C ABEF
+	pblendw	<$>0xf0, T, CDGH	C CDGH
+	movdqa	.Lbswap(%rip), BSWAP
+
+	movdqa	ABEF, ABEF_SAVE
+	movdqa	CDGH, CDGH_SAVE
+
+	QROUND(0, M0, M3, M1)
+	QROUND(1, M1, M0, M2)
+	QROUND(2, M2, M1, M3)
+	QROUND(3, M3, M2, M0)
+	QROUND(4, M0, M3, M1)
+	QROUND(5, M1, M0, M2)
+	QROUND(6, M2, M1, M3)
+	QROUND(7, M3, M2, M0)
+	QROUND(8, M0, M3, M1)
+	QROUND(9, M1, M0, M2)
+	QROUND(10, M2, M1, M3)
+	QROUND(11, M3, M2, M0)
+	QROUND(12, M0, M3, M1)
+	QROUND(13, M1, M0, M2)
+	QROUND(14, M2, M1, M3)
+	QROUND(15, M3, M2, M0)
+
+	paddd	ABEF_SAVE, ABEF
+	paddd	CDGH_SAVE, CDGH
+
+	pshufd	<$>0x1b, ABEF, T	C FEBA
+	pshufd	<$>0xb1, CDGH, CDGH	C DCHG
+	movdqa	T, ABEF
+	pblendw	<$>0xf0, CDGH, ABEF	C DCBA
+	palignr	<$>8, T, CDGH		C HGFE
+	movups	ABEF, (STATE)
+	movups	CDGH, 16(STATE)
+
+	W64_EXIT(3, 11)
+	ret
+EPILOGUE(_nettle_sha256_compress)
+
+	RODATA
+	ALIGN(16)
+.Lbswap:
+	.byte	3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
@@ -0,0 +1,197 @@
+/* xts.c
+
+   XEX-based tweaked-codebook mode with ciphertext stealing (XTS),
+   see IEEE Std 1619-2007.
+
+   Copyright (C) 2026 agent
+
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "xts.h"
+
+#include "macros.h"
+#include "memxor.h"
+
+/* Process this many blocks with each call to the cipher function.
+   Corresponds to a 512 octet sector. */
+#define XTS_BUFFER_BLOCKS 32
+
+/* The tweak is a little-endian 128-bit number, kept as two 64-bit
+   words. Multiplication by alpha is a shift, reducing modulo x^128 +
+   x^7 + x^2 + x + 1. */
+#define XTS_MUL_ALPHA(hi, lo) do {		\
+    uint64_t _xts_carry = (hi) >> 63;		\
+    (hi) = ((hi) << 1) | ((lo) >> 63);		\
+    (lo) = ((lo) << 1) ^ (0x87 & -_xts_carry);	\
+  } while (0)
+
+static void
+xts_init_tweak(const void *twk_ctx, nettle_cipher_func *encf,
+	       const uint8_t *tweak, uint64_t *t)
+{
+  uint8_t block[XTS_BLOCK_SIZE];
+
+  encf(twk_ctx, XTS_BLOCK_SIZE, block, tweak);
+  t[0] = LE_READ_UINT64(block);
+  t[1] = LE_READ_UINT64(block + 8);
+}
+
+/* Writes n consecutive tweak values, in little-endian byte order,
+   and advances the tweak. */
+static void
+xts_fill(uint64_t *t, size_t n, uint64_t *buffer)
+{
+  uint64_t lo = t[0];
+  uint64_t hi = t[1];
+
+  for (; n > 0; n--, buffer += 2)
+    {
+#if WORDS_BIGENDIAN
+      LE_WRITE_UINT64((uint8_t *) buffer, lo);
+      LE_WRITE_UINT64((uint8_t *) (buffer + 1), hi);
+#else
+      buffer[0] = lo;
+      buffer[1] = hi;
+#endif
+      XTS_MUL_ALPHA(hi, lo);
+    }
+  t[0] = lo;
+  t[1] = hi;
+}
+
+/* Processes complete blocks, dst_i = f(src_i ^ T_i) ^ T_i, a buffer
+   of blocks at a time, and advances the tweak. */
+static void
+xts_blocks(const void *ctx, nettle_cipher_func *f, uint64_t *t,
+	   size_t length, uint8_t *dst, const uint8_t *src)
+{
+  uint64_t tweaks[XTS_BUFFER_BLOCKS * 2];
+  uint8_t buffer[XTS_BUFFER_BLOCKS * XTS_BLOCK_SIZE];
+
+  while (length > 0)
+    {
+      size_t chunk = length;
+
+      if (chunk > sizeof(buffer))
+	chunk = sizeof(buffer);
+
+      xts_fill(t, chunk / XTS_BLOCK_SIZE, tweaks);
+      memxor3(buffer, src, tweaks, chunk);
+      f(ctx, chunk, buffer, buffer);
+      memxor3(dst, buffer, tweaks, chunk);
+
+      length -= chunk;
+      dst += chunk;
+      src += chunk;
+    }
+}
+
+void
+xts_encrypt_message(const void *enc_ctx, const void *twk_ctx,
+		    nettle_cipher_func *encf,
+		    const uint8_t *tweak, size_t length,
+		    uint8_t *dst, const uint8_t *src)
+{
+  size_t partial = length % XTS_BLOCK_SIZE;
+  uint64_t t[2];
+
+  assert(length >= XTS_BLOCK_SIZE);
+
+  xts_init_tweak(twk_ctx, encf, tweak, t);
+
+  if (!partial)
+    xts_blocks(enc_ctx, encf, t, length, dst, src);
+  else
+    {
+      uint8_t cc[XTS_BLOCK_SIZE];
+      uint8_t pp[XTS_BLOCK_SIZE];
+      size_t done = length - XTS_BLOCK_SIZE - partial;
+
+      xts_blocks(enc_ctx, encf, t, done, dst, src);
+      dst += done;
+      src += done;
+
+      /* Ciphertext stealing. The last complete block is encrypted
+	 first, its head becomes the final partial block, and its tail
+	 pads the final plaintext, which is encrypted with the next
+	 tweak and stored in its place. */
+      xts_blocks(enc_ctx, encf, t, XTS_BLOCK_SIZE, cc, src);
+      memcpy(pp, src + XTS_BLOCK_SIZE, partial);
+      memcpy(pp + partial, cc + partial, XTS_BLOCK_SIZE - partial);
+      memcpy(dst + XTS_BLOCK_SIZE, cc, partial);
+      xts_blocks(enc_ctx, encf, t, XTS_BLOCK_SIZE, dst, pp);
+    }
+}
+
+void
+xts_decrypt_message(const void *dec_ctx, const void *twk_ctx,
+		    nettle_cipher_func *decf, nettle_cipher_func *encf,
+		    const uint8_t *tweak, size_t length,
+		    uint8_t *dst, const uint8_t *src)
+{
+  size_t partial = length % XTS_BLOCK_SIZE;
+  uint64_t t[2];
+
+  assert(length >= XTS_BLOCK_SIZE);
+
+  xts_init_tweak(twk_ctx, encf, tweak, t);
+
+  if (!partial)
+    xts_blocks(dec_ctx, decf, t, length, dst, src);
+  else
+    {
+      uint8_t cc[XTS_BLOCK_SIZE];
+      uint8_t pp[XTS_BLOCK_SIZE];
+      uint64_t prev[2];
+      size_t done = length - XTS_BLOCK_SIZE - partial;
+
+      xts_blocks(dec_ctx, decf, t, done, dst, src);
+      dst += done;
+      src += done;
+
+      /* Ciphertext stealing, with the last two tweaks used in
+	 reverse order. */
+      prev[0] = t[0];
+      prev[1] = t[1];
+      XTS_MUL_ALPHA(t[1], t[0]);
+
+      xts_blocks(dec_ctx, decf, t, XTS_BLOCK_SIZE, pp, src);
+      memcpy(cc, src + XTS_BLOCK_SIZE, partial);
+      memcpy(cc + partial, pp + partial, XTS_BLOCK_SIZE - partial);
+      memcpy(dst + XTS_BLOCK_SIZE, pp, partial);
+      xts_blocks(dec_ctx, decf, prev, XTS_BLOCK_SIZE, dst, cc);
+    }
+}
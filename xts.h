@@ -0,0 +1,136 @@
+/* xts.h
+
+   XEX-based tweaked-codebook mode with ciphertext stealing (XTS),
+   see IEEE Std 1619-2007.
+
+   Copyright (C) 2026 agent
+
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_XTS_H_INCLUDED
+#define NETTLE_XTS_H_INCLUDED
+
+#include "nettle-types.h"
+#include "aes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Name mangling */
+#define xts_encrypt_message nettle_xts_encrypt_message
+#define xts_decrypt_message nettle_xts_decrypt_message
+#define xts_aes128_set_encrypt_key nettle_xts_aes128_set_encrypt_key
+#define xts_aes128_set_decrypt_key nettle_xts_aes128_set_decrypt_key
+#define xts_aes128_encrypt_message nettle_xts_aes128_encrypt_message
+#define xts_aes128_decrypt_message nettle_xts_aes128_decrypt_message
+#define xts_aes256_set_encrypt_key nettle_xts_aes256_set_encrypt_key
+#define xts_aes256_set_decrypt_key nettle_xts_aes256_set_decrypt_key
+#define xts_aes256_encrypt_message nettle_xts_aes256_encrypt_message
+#define xts_aes256_decrypt_message nettle_xts_aes256_decrypt_message
+
+#define XTS_BLOCK_SIZE 16
+
+/* Restricted to block ciphers with 128 bit block size. The message
+   must be at least one block long. A length which is not a multiple
+   of the block size is handled using ciphertext stealing. The tweak,
+   e.g., the sector number, is XTS_BLOCK_SIZE octets, and is encrypted
+   with twk_ctx. Note that decryption needs both the decryption
+   function, for the data, and the encryption function, for the
+   tweak. */
+void
+xts_encrypt_message(const void *enc_ctx, const void *twk_ctx,
+		    nettle_cipher_func *encf,
+		    const uint8_t *tweak, size_t length,
+		    uint8_t *dst, const uint8_t *src);
+
+void
+xts_decrypt_message(const void *dec_ctx, const void *twk_ctx,
+		    nettle_cipher_func *decf, nettle_cipher_func *encf,
+		    const uint8_t *tweak, size_t length,
+		    uint8_t *dst, const uint8_t *src);
+
+/* XTS-AES, with a key consisting of the data key followed by the
+   tweak key. */
+#define XTS_AES128_KEY_SIZE (2 * AES128_KEY_SIZE)
+#define XTS_AES256_KEY_SIZE (2 * AES256_KEY_SIZE)
+
+struct xts_aes128_key
+{
+  struct aes128_ctx cipher;
+  struct aes128_ctx tweak_cipher;
+};
+
+void
+xts_aes128_set_encrypt_key(struct xts_aes128_key *xts_key,
+			   const uint8_t *key);
+
+void
+xts_aes128_set_decrypt_key(struct xts_aes128_key *xts_key,
+			   const uint8_t *key);
+
+void
+xts_aes128_encrypt_message(const struct xts_aes128_key *xts_key,
+			   const uint8_t *tweak, size_t length,
+			   uint8_t *dst, const uint8_t *src);
+
+void
+xts_aes128_decrypt_message(const struct xts_aes128_key *xts_key,
+			   const uint8_t *tweak, size_t length,
+			   uint8_t *dst, const uint8_t *src);
+
+struct xts_aes256_key
+{
+  struct aes256_ctx cipher;
+  struct aes256_ctx tweak_cipher;
+};
+
+void
+xts_aes256_set_encrypt_key(struct xts_aes256_key *xts_key,
+			   const uint8_t *key);
+
+void
+xts_aes256_set_decrypt_key(struct xts_aes256_key *xts_key,
+			   const uint8_t *key);
+
+void
+xts_aes256_encrypt_message(const struct xts_aes256_key *xts_key,
+			   const uint8_t *tweak, size_t length,
+			   uint8_t *dst, const uint8_t *src);
+
+void
+xts_aes256_decrypt_message(const struct xts_aes256_key *xts_key,
+			   const uint8_t *tweak, size_t length,
+			   uint8_t *dst, const uint8_t *src);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETTLE_XTS_H_INCLUDED */